@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <libnurbs/Analysis/Collocation.hpp>
+#include <libnurbs/Analysis/MassProperties.hpp>
+#include <libnurbs/Analysis/SurfaceElements.hpp>
+#include <libnurbs/Curve/ArcLengthTable.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Curve/FeedrateInterpolator.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+using namespace libnurbs;
+
+static Curve MakeLongCurve(int control_point_count)
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {1000, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = control_point_count;
+    Curve curve = segment.GetCurve();
+    for (int i = 0; i < control_point_count; ++i)
+    {
+        curve.ControlPoints[i].y() = std::sin(0.9 * i);
+        curve.ControlPoints[i].z() = std::cos(0.3 * i);
+    }
+    return curve;
+}
+
+static void BM_Curve_MassProperties(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    IntegrationOptions options;
+    options.ThreadCount = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ComputeMassProperties(curve, options).Measure);
+    }
+}
+BENCHMARK(BM_Curve_MassProperties)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_Curve_ArcLengthTable(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    int nodes = 0;
+    for (auto _ : state)
+    {
+        ArcLengthTable table(curve, 1e-10, static_cast<int>(state.range(0)));
+        nodes = table.NodeCount();
+        benchmark::DoNotOptimize(table.Length());
+    }
+    state.counters["nodes"] = nodes;
+}
+BENCHMARK(BM_Curve_ArcLengthTable)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Constant speed traversal: parameters at evenly spaced lengths
+static void BM_Curve_ParameterAtLength(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    ArcLengthTable table(curve);
+    Curve::EvaluationScratch scratch;
+    const int count = 100000;
+    for (auto _ : state)
+    {
+        for (int k = 0; k < count; ++k)
+        {
+            benchmark::DoNotOptimize(table.ParameterAtLength(table.Length() * k / count, scratch));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Curve_ParameterAtLength)->Unit(benchmark::kMillisecond);
+
+// Jitter of a control loop: every step is timed on its own, worst case and 99th percentile in ns
+static void BM_FeedrateInterpolator_Step(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    FeedrateInterpolator interpolator(curve);
+    const Numeric length = 0.05;
+    std::vector<double> latencies;
+    latencies.reserve(100000);
+    double worst = 0;
+    double p99 = 0;
+    for (auto _ : state)
+    {
+        interpolator.Reset();
+        latencies.clear();
+        while (!interpolator.Finished())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(interpolator.Step(length));
+            const auto stop = std::chrono::steady_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+        state.PauseTiming();
+        const auto percentile = latencies.begin() + latencies.size() * 99 / 100;
+        std::nth_element(latencies.begin(), percentile, latencies.end());
+        p99 = std::max(p99, *percentile);
+        worst = std::max(worst, *std::max_element(percentile, latencies.end()));
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(latencies.size()));
+    state.counters["steps"] = static_cast<double>(latencies.size());
+    state.counters["p99_ns"] = p99;
+    state.counters["max_ns"] = worst;
+}
+BENCHMARK(BM_FeedrateInterpolator_Step)->Unit(benchmark::kMillisecond);
+
+static Surface MakeWavySurface(int control_point_count)
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {100, 0, 0}, {0, 100, 0}, {100, 100, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 3;
+    rect.ControlPointCountU = control_point_count;
+    rect.ControlPointCountV = control_point_count;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < control_point_count; ++j)
+    {
+        for (int i = 0; i < control_point_count; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(0.7 * i) * std::cos(0.5 * j);
+        }
+    }
+    return surface;
+}
+
+// 197 x 197 elements of 6 x 6 Gauss points
+static void BM_Surface_MassProperties(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(200);
+    IntegrationOptions options;
+    options.ThreadCount = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ComputeMassProperties(surface, options).Measure);
+    }
+}
+BENCHMARK(BM_Surface_MassProperties)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Element stiffness matrices of the Laplace-Beltrami operator on 97 x 97 bicubic elements, one pass per
+// iteration. Range 0: the element caches are built for every pass, range 1: built once and reused.
+static void BM_SurfaceElements_Stiffness(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(100);
+    SurfaceElements elements(surface, 0, 1);
+    const int function_count = elements.FunctionCount();
+    std::vector<MatX> stiffness(elements.ElementCount(), MatX::Zero(function_count, function_count));
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0) elements = SurfaceElements(surface, 0, 1);
+        elements.ForEachElement([&](int element, int)
+        {
+            MatX& local = stiffness[element];
+            local.setZero();
+            const auto measures = elements.Measures(element);
+            for (int point = 0; point < elements.PointCount(); ++point)
+            {
+                const auto gradients = elements.Gradients(element, point);
+                for (int i = 0; i < function_count; ++i)
+                {
+                    for (int j = 0; j < function_count; ++j)
+                    {
+                        local(i, j) += measures[point] * gradients[i].dot(gradients[j]);
+                    }
+                }
+            }
+        }, 1);
+        benchmark::DoNotOptimize(stiffness.back().data());
+    }
+    state.SetItemsProcessed(state.iterations() * elements.ElementCount());
+}
+BENCHMARK(BM_SurfaceElements_Stiffness)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_SurfaceElements_Build(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(100);
+    for (auto _ : state)
+    {
+        SurfaceElements elements(surface, 0, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(elements.Measures(0).data());
+    }
+}
+BENCHMARK(BM_SurfaceElements_Build)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 10^6 sorted samples, range is the thread count
+static void BM_Curve_CollocationMatrix(benchmark::State& state)
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {1000, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = 5000;
+    Curve curve = segment.GetCurve();
+    std::vector<Numeric> parameters(1000000);
+    for (int k = 0; k < 1000000; ++k)
+    {
+        parameters[k] = k / 999999.0;
+    }
+    for (auto _ : state)
+    {
+        SparseMatrix matrix = CollocationMatrix(curve, parameters, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(matrix.valuePtr());
+    }
+    state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_Curve_CollocationMatrix)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 1000 x 1000 samples on 200 x 200 bicubic control points
+static void BM_Surface_CollocationMatrix(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(200);
+    std::vector<Eigen::Vector2<Numeric>> parameters;
+    parameters.reserve(1000000);
+    for (int j = 0; j < 1000; ++j)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            parameters.emplace_back(i / 999.0, j / 999.0);
+        }
+    }
+    for (auto _ : state)
+    {
+        SparseMatrix matrix = CollocationMatrix(surface, parameters, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(matrix.valuePtr());
+    }
+    state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_Surface_CollocationMatrix)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,263 @@
+#include <bit>
+#include <cmath>
+#include <deque>
+#include <benchmark/benchmark.h>
+#include <libnurbs/Core/BoundingBoxArray.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Scene/SceneBvh.hpp>
+#include <libnurbs/Surface/SurfaceBvh.hpp>
+
+using namespace libnurbs;
+
+static Curve MakeLongCurve(int control_point_count)
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {1000, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = control_point_count;
+    Curve curve = segment.GetCurve();
+    for (int i = 0; i < control_point_count; ++i)
+    {
+        curve.ControlPoints[i].y() = std::sin(0.9 * i);
+        curve.ControlPoints[i].z() = std::cos(0.4 * i);
+    }
+    return curve;
+}
+
+static void BM_Curve_GetBoundingBox(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(1000);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(curve.GetBoundingBox(1e-6, static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_Curve_GetBoundingBox)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_Curve_GetExactBoundingBox(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(1000);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(curve.GetExactBoundingBox(static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_Curve_GetExactBoundingBox)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+
+static Surface MakeLargeSurface(int control_point_count)
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {100, 0, 0}, {0, 100, 0}, {100, 100, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 3;
+    rect.ControlPointCountU = control_point_count;
+    rect.ControlPointCountV = control_point_count;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < control_point_count; ++j)
+    {
+        for (int i = 0; i < control_point_count; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(0.9 * i) * std::cos(0.4 * j);
+        }
+    }
+    return surface;
+}
+
+static void BM_Surface_GetBoundingBox(benchmark::State& state)
+{
+    Surface surface = MakeLargeSurface(100);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(surface.GetBoundingBox(1e-3, static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_Surface_GetBoundingBox)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_SurfaceBvh_Build(benchmark::State& state)
+{
+    Surface surface = MakeLargeSurface(100);
+    for (auto _ : state)
+    {
+        SurfaceBvh bvh(surface);
+        benchmark::DoNotOptimize(bvh.Nodes().data());
+    }
+}
+BENCHMARK(BM_SurfaceBvh_Build)->Unit(benchmark::kMillisecond);
+
+static void BM_SurfaceBvh_QueryBox(benchmark::State& state)
+{
+    Surface surface = MakeLargeSurface(100);
+    SurfaceBvh bvh(surface);
+    std::vector<int> patches;
+    int k = 0;
+    for (auto _ : state)
+    {
+        Vec3 center{Numeric((k * 37) % 100), Numeric((k * 61) % 100), 0};
+        patches.clear();
+        bvh.QueryBox(BoundingBox(center - Vec3::Constant(2), center + Vec3::Constant(2)), patches);
+        benchmark::DoNotOptimize(patches.data());
+        ++k;
+    }
+}
+BENCHMARK(BM_SurfaceBvh_QueryBox);
+
+// 10000 short curves scattered over a 100 x 100 x 10 block
+static std::deque<Curve> MakeCurveScene()
+{
+    std::deque<Curve> curves;
+    for (int k = 0; k < 10000; ++k)
+    {
+        Vec3 origin{std::fmod(k * 7.31, 100.0), std::fmod(k * 3.17, 100.0), std::fmod(k * 1.93, 10.0)};
+        GeomSegment segment = GeomSegment::Make(origin, origin + Vec3{1.0, 0.5 * std::sin(k), 0.3});
+        segment.Degree = 3;
+        segment.ControlPointCount = 6;
+        curves.push_back(segment.GetCurve());
+    }
+    return curves;
+}
+
+static void BM_SceneBvh_Build(benchmark::State& state)
+{
+    auto curves = MakeCurveScene();
+    SceneBvh bvh;
+    for (const auto& curve : curves) bvh.AddCurve(curve);
+    for (auto _ : state)
+    {
+        bvh.Build();
+        benchmark::DoNotOptimize(bvh.Nodes().data());
+    }
+}
+BENCHMARK(BM_SceneBvh_Build)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneBvh_Refit(benchmark::State& state)
+{
+    auto curves = MakeCurveScene();
+    SceneBvh bvh;
+    for (const auto& curve : curves) bvh.AddCurve(curve);
+    bvh.Build();
+    for (auto _ : state)
+    {
+        bvh.Refit();
+        benchmark::DoNotOptimize(bvh.Nodes().data());
+    }
+}
+BENCHMARK(BM_SceneBvh_Refit)->Unit(benchmark::kMillisecond);
+
+// Box overlap query through the BVH (range 1) or by testing every object box (range 0)
+static void BM_SceneBvh_QueryBox(benchmark::State& state)
+{
+    auto curves = MakeCurveScene();
+    SceneBvh bvh;
+    for (const auto& curve : curves) bvh.AddCurve(curve);
+    bvh.Build();
+    std::vector<int> objects;
+    int k = 0;
+    for (auto _ : state)
+    {
+        Vec3 center{Numeric((k * 37) % 100), Numeric((k * 61) % 100), 5};
+        BoundingBox query(center - Vec3::Constant(2), center + Vec3::Constant(2));
+        objects.clear();
+        if (state.range(0))
+        {
+            bvh.QueryBox(query, objects);
+        }
+        else
+        {
+            for (int object = 0; object < bvh.ObjectCount(); ++object)
+            {
+                if (bvh.ObjectBox(object).Intersects(query)) objects.push_back(object);
+            }
+        }
+        benchmark::DoNotOptimize(objects.data());
+        ++k;
+    }
+}
+BENCHMARK(BM_SceneBvh_QueryBox)->Arg(0)->Arg(1);
+
+static void BM_SceneBvh_FindNearest(benchmark::State& state)
+{
+    auto curves = MakeCurveScene();
+    SceneBvh bvh;
+    for (const auto& curve : curves) bvh.AddCurve(curve);
+    bvh.Build();
+    int k = 0;
+    for (auto _ : state)
+    {
+        Vec3 point{Numeric((k * 37) % 100), Numeric((k * 61) % 100), 5};
+        benchmark::DoNotOptimize(bvh.FindNearest(point));
+        ++k;
+    }
+}
+BENCHMARK(BM_SceneBvh_FindNearest)->Unit(benchmark::kMicrosecond);
+
+static std::vector<BoundingBox> MakeBoxes(int count)
+{
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < count; ++i)
+    {
+        Vec3 center{std::fmod(i * 0.731, 50.0), std::fmod(i * 0.317, 50.0), std::fmod(i * 0.193, 50.0)};
+        boxes.emplace_back(center - Vec3::Constant(0.5), center + Vec3::Constant(0.5));
+    }
+    return boxes;
+}
+
+// One box query against 4096 boxes, scalar BoundingBox (range 0) or BoundingBoxArray masks (range 1)
+static void BM_BoundingBox_Intersects(benchmark::State& state)
+{
+    auto boxes = MakeBoxes(4096);
+    BoundingBoxArray array(boxes);
+    BoundingBox query(Vec3::Constant(10), Vec3::Constant(30));
+    for (auto _ : state)
+    {
+        int hits = 0;
+        if (state.range(0))
+        {
+            for (int k = 0; k < array.Size(); k += 64)
+            {
+                hits += std::popcount(array.IntersectsMask(query, k, 64));
+            }
+        }
+        else
+        {
+            for (const auto& box : boxes)
+            {
+                hits += box.Intersects(query);
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_BoundingBox_Intersects)->Arg(0)->Arg(1);
+
+static void BM_BoundingBox_IntersectRay(benchmark::State& state)
+{
+    auto boxes = MakeBoxes(4096);
+    BoundingBoxArray array(boxes);
+    Vec3 origin{-1, 2, 3};
+    Vec3 inverse = Vec3{1, 0.9, 0.8}.normalized().cwiseInverse();
+    std::vector<Numeric> enters(64);
+    for (auto _ : state)
+    {
+        int hits = 0;
+        if (state.range(0))
+        {
+            for (int k = 0; k < array.Size(); k += 64)
+            {
+                hits += std::popcount(array.IntersectRayMask(origin, inverse, 0, 100, k, 64, enters.data()));
+            }
+        }
+        else
+        {
+            Numeric enter;
+            for (const auto& box : boxes)
+            {
+                hits += box.IntersectRay(origin, inverse, 0, 100, enter);
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_BoundingBox_IntersectRay)->Arg(0)->Arg(1);
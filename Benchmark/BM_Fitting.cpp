@@ -0,0 +1,58 @@
+#include <cmath>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <libnurbs/Curve/Curve.hpp>
+
+using namespace libnurbs;
+
+static std::vector<Vec3> MakeToolpath(int count)
+{
+    std::vector<Vec3> points(count);
+    for (int k = 0; k < count; ++k)
+    {
+        const Numeric t = 1000.0 * k / (count - 1);
+        points[k] = {t, std::sin(0.9 * t), 0.2 * std::cos(0.3 * t)};
+    }
+    return points;
+}
+
+static void BM_Curve_Interpolate(benchmark::State& state)
+{
+    const std::vector<Vec3> points = MakeToolpath(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        const Curve curve = Curve::Interpolate(points, 3);
+        benchmark::DoNotOptimize(curve.ControlPoints.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Curve_Interpolate)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// 10^6 points onto a range of control points
+static void BM_Curve_Approximate(benchmark::State& state)
+{
+    const std::vector<Vec3> points = MakeToolpath(1000000);
+    for (auto _ : state)
+    {
+        const Curve curve = Curve::Approximate(points, 3, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(curve.ControlPoints.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_Curve_Approximate)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// 10^6 points compressed to 1e-3, then 1e-5
+static void BM_Curve_ApproximateToTolerance(benchmark::State& state)
+{
+    const std::vector<Vec3> points = MakeToolpath(1000000);
+    const Numeric tolerance = state.range(0) == 3 ? 1e-3 : 1e-5;
+    size_t control_points = 0;
+    for (auto _ : state)
+    {
+        const Curve curve = Curve::ApproximateToTolerance(points, 3, tolerance);
+        control_points = curve.ControlPoints.size();
+    }
+    state.SetItemsProcessed(state.iterations() * 1000000);
+    state.counters["control_points"] = static_cast<double>(control_points);
+}
+BENCHMARK(BM_Curve_ApproximateToTolerance)->Arg(3)->Arg(5)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,158 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <libnurbs/Algorithm/RayIntersection.hpp>
+#include <libnurbs/Curve/CurveIntersection.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Surface/SurfaceBvh.hpp>
+#include <libnurbs/Surface/SurfaceIntersection.hpp>
+
+using namespace libnurbs;
+
+static Surface MakeTerrainSurface()
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {10, 0, 0}, {0, 10, 0}, {10, 10, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 3;
+    rect.ControlPointCountU = 40;
+    rect.ControlPointCountV = 40;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(0.7 * i) * std::cos(0.5 * j);
+        }
+    }
+    return surface;
+}
+
+// A pinhole camera above the surface, rays in image row order so neighbouring rays are coherent.
+static void MakeCameraRays(int resolution, std::vector<Vec3>& origins, std::vector<Vec3>& directions)
+{
+    const Vec3 eye{5, -4, 8};
+    origins.assign(resolution * resolution, eye);
+    directions.clear();
+    for (int y = 0; y < resolution; ++y)
+    {
+        for (int x = 0; x < resolution; ++x)
+        {
+            Vec3 target{10.0 * (x + 0.5) / resolution, 10.0 * (y + 0.5) / resolution, 0};
+            directions.push_back((target - eye).normalized());
+        }
+    }
+}
+
+static void BM_Surface_IntersectRay_Single(benchmark::State& state)
+{
+    Surface surface = MakeTerrainSurface();
+    SurfaceBvh bvh(surface);
+    RayIntersectionScratch scratch;
+    std::vector<Vec3> origins, directions;
+    MakeCameraRays(128, origins, directions);
+    for (auto _ : state)
+    {
+        for (size_t k = 0; k < origins.size(); ++k)
+        {
+            auto hit = IntersectRay(surface, bvh, origins[k], directions[k],
+                                    std::numeric_limits<Numeric>::infinity(), scratch, 1e-10);
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(origins.size()));
+}
+BENCHMARK(BM_Surface_IntersectRay_Single)->Unit(benchmark::kMillisecond);
+
+static void BM_Surface_IntersectRays(benchmark::State& state)
+{
+    Surface surface = MakeTerrainSurface();
+    std::vector<Vec3> origins, directions;
+    MakeCameraRays(128, origins, directions);
+    for (auto _ : state)
+    {
+        auto hits = surface.IntersectRays(origins, directions, 1e-10, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(origins.size()));
+}
+BENCHMARK(BM_Surface_IntersectRays)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Planar cubic strokes scattered over a 30 x 30 sketch, as a constraint solver sees them.
+static std::vector<Curve> MakeSketchCurves(int count)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0.0, 30.0);
+    std::uniform_real_distribution<double> wiggle(-5.0, 5.0);
+    std::vector<Curve> curves;
+    for (int k = 0; k < count; ++k)
+    {
+        Vec3 start{position(generator), position(generator), 0};
+        Vec3 end = start + Vec3{4 * wiggle(generator), 4 * wiggle(generator), 0};
+        GeomSegment segment = GeomSegment::Make(start, end);
+        segment.Degree = 3;
+        segment.ControlPointCount = 8;
+        Curve curve = segment.GetCurve();
+        for (int i = 1; i + 1 < 8; ++i)
+        {
+            curve.ControlPoints[i].x() += wiggle(generator);
+            curve.ControlPoints[i].y() += wiggle(generator);
+        }
+        curves.push_back(curve);
+    }
+    return curves;
+}
+
+static void BM_Curve_Intersect(benchmark::State& state)
+{
+    auto curves = MakeSketchCurves(100);
+    int64_t pairs = 0, intersections = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < curves.size(); ++i)
+        {
+            for (size_t j = i + 1; j < curves.size(); ++j)
+            {
+                auto hits = Intersect(curves[i], curves[j]);
+                intersections += static_cast<int64_t>(hits.size());
+                pairs++;
+            }
+        }
+    }
+    state.SetItemsProcessed(pairs);
+    state.counters["intersections"] = benchmark::Counter(static_cast<double>(intersections) / pairs);
+}
+BENCHMARK(BM_Curve_Intersect)->Unit(benchmark::kMillisecond);
+
+// The terrain against a second, rotated wave field: long open branches across many patches.
+static void BM_Surface_Intersect(benchmark::State& state)
+{
+    Surface terrain = MakeTerrainSurface();
+    Surface other = MakeTerrainSurface();
+    for (int j = 0; j < other.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < other.ControlPoints.UCount; ++i)
+        {
+            other.ControlPoints.Get(i, j).z() = 0.8 * std::cos(0.4 * i - 0.3 * j);
+        }
+    }
+    SurfaceBvh bvh_terrain(terrain), bvh_other(other);
+    SurfaceIntersectionOptions options;
+    options.ChordTolerance = std::pow(10.0, -static_cast<double>(state.range(0)));
+    options.ThreadCount = 1;
+    size_t branches = 0, points = 0;
+    for (auto _ : state)
+    {
+        auto result = Intersect(terrain, bvh_terrain, other, bvh_other, options);
+        branches = result.size();
+        points = 0;
+        for (const auto& branch : result) points += branch.Path.Points.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points);
+    state.counters["branches"] = static_cast<double>(branches);
+}
+BENCHMARK(BM_Surface_Intersect)->Arg(3)->Arg(5)->Unit(benchmark::kMillisecond);
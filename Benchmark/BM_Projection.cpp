@@ -0,0 +1,166 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <benchmark/benchmark.h>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Curve/CurvePointInversion.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Surface/SurfaceProjector.hpp>
+
+using namespace libnurbs;
+
+static Surface MakeWavySurface()
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {10, 0, 0}, {0, 10, 0}, {10, 10, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 3;
+    rect.ControlPointCountU = 20;
+    rect.ControlPointCountV = 20;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(0.7 * i) * std::cos(0.5 * j);
+        }
+    }
+    return surface;
+}
+
+static std::vector<Vec3> MakeScanPoints(int count)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> xy(0.0, 10.0);
+    std::uniform_real_distribution<double> z(-1.5, 1.5);
+    std::vector<Vec3> points(count);
+    for (auto& point : points)
+    {
+        point = {xy(generator), xy(generator), z(generator)};
+    }
+    return points;
+}
+
+static void BM_Surface_ProjectPoints(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface();
+    auto points = MakeScanPoints(20000);
+    for (auto _ : state)
+    {
+        auto results = surface.ProjectPoints(points, 1e-10, 32, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Surface_ProjectPoints)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static Curve MakeWavyCurve()
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {10, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = 50;
+    Curve curve = segment.GetCurve();
+    for (int i = 0; i < segment.ControlPointCount; ++i)
+    {
+        curve.ControlPoints[i].y() = std::sin(0.9 * i);
+    }
+    return curve;
+}
+
+static void BM_Curve_ProjectPoints(benchmark::State& state)
+{
+    Curve curve = MakeWavyCurve();
+    auto points = MakeScanPoints(100000);
+    for (auto _ : state)
+    {
+        auto results = curve.ProjectPoints(points, 1e-10, 32, static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Curve_ProjectPoints)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_Curve_ClosestPoint_Inversion(benchmark::State& state)
+{
+    Curve curve = MakeWavyCurve();
+    auto points = MakeScanPoints(1000);
+    CurvePointInversion inversion(curve);
+    for (auto _ : state)
+    {
+        for (const auto& point : points)
+        {
+            auto result = inversion.Project(point);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Curve_ClosestPoint_Inversion)->Unit(benchmark::kMillisecond);
+
+// Dense sampling at 64 samples per span, still only accurate to the sample spacing.
+static void BM_Curve_ClosestPoint_DenseSampling(benchmark::State& state)
+{
+    Curve curve = MakeWavyCurve();
+    auto points = MakeScanPoints(1000);
+    const int sample_count = 64 * 47;
+    for (auto _ : state)
+    {
+        for (const auto& point : points)
+        {
+            Numeric best = std::numeric_limits<Numeric>::max();
+            for (int i = 0; i <= sample_count; ++i)
+            {
+                best = std::min(best, (curve.Evaluate(i / Numeric(sample_count)) - point).squaredNorm());
+            }
+            benchmark::DoNotOptimize(best);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Curve_ClosestPoint_DenseSampling)->Unit(benchmark::kMillisecond);
+
+static std::vector<Vec3> MakeScanLines(const Surface& surface, int line_count, int points_per_line)
+{
+    std::vector<Vec3> points;
+    points.reserve(line_count * points_per_line);
+    for (int j = 0; j < line_count; ++j)
+    {
+        for (int i = 0; i < points_per_line; ++i)
+        {
+            Numeric u = i / (points_per_line - 1.0), v = j / (line_count - 1.0);
+            points.push_back(surface.Evaluate(u, v) + Vec3{0.0, 0.0, 0.01});
+        }
+    }
+    return points;
+}
+
+static void BM_Surface_ProjectScanLines_Batch(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface();
+    auto points = MakeScanLines(surface, 20, 1000);
+    for (auto _ : state)
+    {
+        auto results = surface.ProjectPoints(points, 1e-10, 32, 1);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Surface_ProjectScanLines_Batch)->Unit(benchmark::kMillisecond);
+
+static void BM_Surface_ProjectScanLines_Projector(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface();
+    auto points = MakeScanLines(surface, 20, 1000);
+    for (auto _ : state)
+    {
+        SurfaceProjector projector(surface);
+        for (const auto& point : points)
+        {
+            auto result = projector.Project(point);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Surface_ProjectScanLines_Projector)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,202 @@
+#include <cmath>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Tessellation/IncrementalTessellation.hpp>
+#include <libnurbs/Tessellation/PlaneSlicing.hpp>
+#include <libnurbs/Tessellation/TessellationCache.hpp>
+#include <libnurbs/Tessellation/TessellationEngine.hpp>
+
+using namespace libnurbs;
+
+static Curve MakeLongCurve(int control_point_count)
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {1000, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = control_point_count;
+    Curve curve = segment.GetCurve();
+    for (int i = 0; i < control_point_count; ++i)
+    {
+        curve.ControlPoints[i].y() = std::sin(0.9 * i);
+        curve.ControlPoints[i].z() = std::cos(0.3 * i);
+    }
+    return curve;
+}
+
+static void BM_Curve_Tessellate(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    Numeric tolerance = std::pow(10.0, -static_cast<double>(state.range(0)));
+    Polyline polyline;
+    for (auto _ : state)
+    {
+        curve.Tessellate(tolerance, 0.0, polyline);
+        benchmark::DoNotOptimize(polyline.Points.data());
+    }
+    state.counters["points"] = polyline.Count();
+}
+BENCHMARK(BM_Curve_Tessellate)->DenseRange(2, 6, 2)->Unit(benchmark::kMillisecond);
+
+// The previous approach: uniform sampling dense enough for the most curved span.
+static void BM_Curve_UniformEvaluate(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    const int count = static_cast<int>(state.range(0)) * 4997;
+    std::vector<Vec3> points(count + 1);
+    for (auto _ : state)
+    {
+        for (int i = 0; i <= count; ++i)
+        {
+            points[i] = curve.Evaluate(i / Numeric(count));
+        }
+        benchmark::DoNotOptimize(points.data());
+    }
+    state.counters["points"] = count + 1;
+}
+BENCHMARK(BM_Curve_UniformEvaluate)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static void BM_Curve_SampleUniform(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    Polyline polyline;
+    for (auto _ : state)
+    {
+        curve.SampleUniform(static_cast<int>(state.range(0)), polyline);
+        benchmark::DoNotOptimize(polyline.Points.data());
+    }
+    state.counters["points"] = polyline.Count();
+}
+BENCHMARK(BM_Curve_SampleUniform)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static Surface MakeWavySurface(int control_point_count)
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {100, 0, 0}, {0, 100, 0}, {100, 100, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 3;
+    rect.ControlPointCountU = control_point_count;
+    rect.ControlPointCountV = control_point_count;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < control_point_count; ++j)
+    {
+        for (int i = 0; i < control_point_count; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(0.7 * i) * std::cos(0.5 * j);
+        }
+    }
+    return surface;
+}
+
+static void BM_Surface_Tessellate(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(50);
+    Surface::TessellationOptions options;
+    options.ChordTolerance = std::pow(10.0, -static_cast<double>(state.range(0)));
+    TriangleMesh mesh;
+    for (auto _ : state)
+    {
+        surface.Tessellate(options, mesh);
+        benchmark::DoNotOptimize(mesh.Positions.data());
+    }
+    state.counters["triangles"] = mesh.TriangleCount();
+}
+BENCHMARK(BM_Surface_Tessellate)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+
+// Zooming in from 1e-1 to 1e-3: each level is refined from the previous one (range 1) or
+// planned from scratch because the cache is cleared in between (range 0).
+static void BM_TessellationCache_ZoomIn(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(50);
+    Surface::TessellationOptions coarsest;
+    coarsest.ChordTolerance = 1e-1;
+    TessellationCache cache(coarsest, size_t(1) << 30);
+    for (auto _ : state)
+    {
+        cache.Clear();
+        for (Numeric tolerance : {1e-1, 2.5e-2, 6.25e-3, 1.5625e-3})
+        {
+            if (state.range(0) == 0) cache.Clear();
+            benchmark::DoNotOptimize(cache.Get(surface, tolerance).Positions.data());
+        }
+    }
+}
+BENCHMARK(BM_TessellationCache_ZoomIn)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// One control point dragged per frame, compare with BM_Surface_Tessellate at the same tolerance.
+static void BM_IncrementalTessellation_Drag(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(50);
+    Surface::TessellationOptions options;
+    options.ChordTolerance = 1e-2;
+    IncrementalTessellation incremental(surface, options);
+    int frame = 0;
+    for (auto _ : state)
+    {
+        surface.ControlPoints.Edit(25, 25).z() = std::sin(0.1 * frame++);
+        benchmark::DoNotOptimize(incremental.Update());
+    }
+    state.counters["triangles"] = incremental.Mesh().TriangleCount();
+}
+BENCHMARK(BM_IncrementalTessellation_Drag)->Unit(benchmark::kMillisecond);
+
+static void BM_TessellationEngine(benchmark::State& state)
+{
+    std::vector<Surface> surfaces;
+    for (int i = 0; i < 64; ++i)
+    {
+        // A few large surfaces among many small ones
+        surfaces.push_back(MakeWavySurface(i % 16 == 0 ? 60 : 12));
+    }
+    TessellationSettings settings;
+    settings.SurfaceOptions.ChordTolerance = 1e-2;
+    TessellationEngine engine(static_cast<int>(state.range(0)));
+    int64_t triangles = 0;
+    for (auto _ : state)
+    {
+        triangles = 0;
+        engine.Run(surfaces, {}, settings, [&](int, const TriangleMesh& mesh) { triangles += mesh.TriangleCount(); });
+    }
+    state.counters["triangles"] = static_cast<double>(triangles);
+}
+BENCHMARK(BM_TessellationEngine)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Layers of a print job: the levels sliced per second through curve and surface, on 1 and 4 workers.
+static void BM_Curve_Slice(benchmark::State& state)
+{
+    Curve curve = MakeLongCurve(5000);
+    std::vector<Numeric> levels;
+    for (int k = 0; k < 1000; ++k) levels.push_back(-1 + 0.002 * k);
+    SliceOptions options;
+    options.Normal = {0, 1, 0};
+    options.ThreadCount = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        auto slices = SliceCurve(curve, levels, options);
+        benchmark::DoNotOptimize(slices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * levels.size());
+}
+BENCHMARK(BM_Curve_Slice)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_Surface_Slice(benchmark::State& state)
+{
+    Surface surface = MakeWavySurface(50);
+    std::vector<Numeric> levels;
+    for (int k = 0; k < 1000; ++k) levels.push_back(-1 + 0.002 * k);
+    SliceOptions options;
+    options.Grid.ChordTolerance = 1e-2;
+    options.ThreadCount = static_cast<int>(state.range(0));
+    size_t contours = 0;
+    for (auto _ : state)
+    {
+        auto slices = SliceSurface(surface, levels, options);
+        contours = 0;
+        for (const auto& slice : slices) contours += slice.size();
+        benchmark::DoNotOptimize(slices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * levels.size());
+    state.counters["contours"] = static_cast<double>(contours);
+}
+BENCHMARK(BM_Surface_Slice)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,385 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <libnurbs/Analysis/Collocation.hpp>
+#include <libnurbs/Analysis/GaussQuadrature.hpp>
+#include <libnurbs/Analysis/MassProperties.hpp>
+#include <libnurbs/Analysis/SurfaceElements.hpp>
+#include <libnurbs/Basis/BSplineBasis.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+
+#include <cmath>
+#include <numbers>
+
+using namespace Catch;
+using namespace libnurbs;
+
+TEST_CASE("Analysis/GaussLegendre", "[analysis]")
+{
+    SECTION("Weights and symmetry")
+    {
+        for (int n = 1; n <= MAX_QUADRATURE_POINT_COUNT; ++n)
+        {
+            const QuadratureRule& rule = GaussLegendre(n);
+            REQUIRE(rule.Count() == n);
+            Numeric sum = 0;
+            for (int i = 0; i < n; ++i)
+            {
+                sum += rule.Weights[i];
+                REQUIRE(rule.Nodes[i] == Approx(-rule.Nodes[n - 1 - i]).margin(1e-15));
+                if (i > 0) REQUIRE(rule.Nodes[i - 1] < rule.Nodes[i]);
+            }
+            REQUIRE(sum == Approx(2).epsilon(1e-13));
+        }
+        REQUIRE(GaussLegendre(8).Nodes[4] == Approx(0.1834346424956498).epsilon(1e-15));
+        REQUIRE(GaussLegendre(8).Weights[4] == Approx(0.3626837833783620).epsilon(1e-15));
+    }
+
+    SECTION("Exact up to degree 2n - 1")
+    {
+        for (int n : {1, 3, 6, 17})
+        {
+            const QuadratureRule& rule = GaussLegendre(n);
+            for (int power = 0; power <= 2 * n - 1; ++power)
+            {
+                Numeric sum = 0;
+                for (int i = 0; i < n; ++i)
+                {
+                    sum += rule.Weights[i] * std::pow(rule.Nodes[i], power);
+                }
+                const Numeric exact = power % 2 == 0 ? 2.0 / (power + 1) : 0.0;
+                REQUIRE(sum == Approx(exact).margin(1e-14));
+            }
+        }
+    }
+
+    SECTION("Span quadrature")
+    {
+        const KnotVector knots({0, 0, 0, 0.25, 0.25, 0.5, 1, 1, 1});
+        const SpanQuadrature quadrature(knots, 2, 3);
+        REQUIRE(quadrature.SpanCount() == 3);
+        REQUIRE(quadrature.Spans == std::vector<int>{2, 4, 5});
+        REQUIRE(quadrature.Points.size() == 9);
+        // Integral of x^2 on [0, 1]
+        Numeric sum = 0;
+        for (int i = 0; i < 9; ++i)
+        {
+            sum += quadrature.Weights[i] * quadrature.Points[i] * quadrature.Points[i];
+        }
+        REQUIRE(sum == Approx(1.0 / 3).epsilon(1e-14));
+
+        const SpanQuadrature cached(knots, 2, 3, 3);
+        REQUIRE(cached.BasisValues.size() == 9 * 4 * 3);
+        for (int q = 0; q < 9; ++q)
+        {
+            const int span = cached.Spans[q / 3];
+            const MatX expected = BSplineBasis::EvaluateAll(2, knots.Values(), span, cached.Points[q], 2);
+            for (int r = 0; r <= 2; ++r)
+            {
+                REQUIRE(cached.Basis(q, 0)[r] == Approx(expected(0, r)).margin(1e-14));
+                REQUIRE(cached.Basis(q, 1)[r] == Approx(expected(1, r)).margin(1e-13));
+                REQUIRE(cached.Basis(q, 2)[r] == Approx(expected(2, r)).margin(1e-12));
+                REQUIRE(cached.Basis(q, 3)[r] == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("Analysis/MassProperties", "[analysis]")
+{
+    SECTION("Straight curve with uneven speed")
+    {
+        GeomSegment segment = GeomSegment::Make({0, 0, 0}, {2, 0, 0});
+        segment.Degree = 3;
+        segment.ControlPointCount = 7;
+        Curve curve = segment.GetCurve();
+        curve.ControlPoints[2].x() = 0.2;
+        curve.ControlPoints[4].x() = 1.9;
+
+        const MassProperties properties = ComputeMassProperties(curve);
+        REQUIRE(properties.Measure == Approx(2).epsilon(1e-13));
+        REQUIRE(properties.Centroid.x() == Approx(1).epsilon(1e-13));
+        REQUIRE(properties.Centroid.tail<2>().norm() == Approx(0).margin(1e-14));
+        // Rod of mass 2 and length 2: m L^2 / 12 across it
+        REQUIRE(properties.Inertia(0, 0) == Approx(0).margin(1e-13));
+        REQUIRE(properties.Inertia(1, 1) == Approx(2.0 / 3).epsilon(1e-13));
+        REQUIRE(properties.Inertia(2, 2) == Approx(2.0 / 3).epsilon(1e-13));
+    }
+
+    SECTION("Rational quarter circle")
+    {
+        Curve arc;
+        arc.Degree = 2;
+        arc.Knots = KnotVector{{0, 0, 0, 1, 1, 1}};
+        arc.ControlPoints = {{1, 0, 0, 1}, {1, 1, 0, std::sqrt(0.5)}, {0, 1, 0, 1}};
+
+        IntegrationOptions options;
+        options.PointCount = 24;
+        const MassProperties properties = ComputeMassProperties(arc, options);
+        const Numeric pi = std::numbers::pi;
+        REQUIRE(properties.Measure == Approx(pi / 2).epsilon(1e-12));
+        REQUIRE(properties.Centroid.x() == Approx(2 / pi).epsilon(1e-12));
+        REQUIRE(properties.Centroid.y() == Approx(2 / pi).epsilon(1e-12));
+        REQUIRE(properties.Inertia(0, 0) == Approx(pi / 4 - 2 / pi).epsilon(1e-10));
+        REQUIRE(properties.Inertia(2, 2) == Approx(pi / 2 - 4 / pi).epsilon(1e-10));
+        REQUIRE(properties.Inertia(0, 1) == Approx(2 / pi - 0.5).epsilon(1e-10));
+
+        // Extruded by 2 along z: a quarter cylinder
+        Surface cylinder;
+        cylinder.DegreeU = 2;
+        cylinder.DegreeV = 1;
+        cylinder.KnotsU = arc.Knots;
+        cylinder.KnotsV = KnotVector{{0, 0, 1, 1}};
+        cylinder.ControlPoints = ControlPointGrid(3, 2);
+        for (int i = 0; i < 3; ++i)
+        {
+            cylinder.ControlPoints.Get(i, 0) = arc.ControlPoints[i];
+            cylinder.ControlPoints.Get(i, 1) = arc.ControlPoints[i];
+            cylinder.ControlPoints.Get(i, 1).z() = 2;
+        }
+        const MassProperties shell = ComputeMassProperties(cylinder, options);
+        REQUIRE(shell.Measure == Approx(pi).epsilon(1e-12));
+        REQUIRE(shell.Centroid.x() == Approx(2 / pi).epsilon(1e-12));
+        REQUIRE(shell.Centroid.z() == Approx(1).epsilon(1e-12));
+        REQUIRE(shell.Inertia(2, 2) == Approx(2 * (pi / 2 - 4 / pi)).epsilon(1e-10));
+    }
+
+    SECTION("Planar surface with uneven parameterization")
+    {
+        GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 2, 0}, {3, 2, 0});
+        rect.DegreeU = 3;
+        rect.DegreeV = 2;
+        rect.ControlPointCountU = 6;
+        rect.ControlPointCountV = 5;
+        Surface surface = rect.GetSurface();
+        // Interior control points only move inside the rectangle, the image stays the same
+        for (int j = 1; j < 4; ++j)
+        {
+            for (int i = 1; i < 5; ++i)
+            {
+                surface.ControlPoints.Get(i, j).x() += 0.1 * std::sin(i + j);
+                surface.ControlPoints.Get(i, j).y() += 0.05 * std::cos(2.0 * i - j);
+            }
+        }
+
+        const MassProperties properties = ComputeMassProperties(surface);
+        REQUIRE(properties.Measure == Approx(6).epsilon(1e-13));
+        REQUIRE(properties.Centroid.x() == Approx(1.5).epsilon(1e-13));
+        REQUIRE(properties.Centroid.y() == Approx(1).epsilon(1e-13));
+        REQUIRE(properties.Inertia(0, 0) == Approx(2).epsilon(1e-12));
+        REQUIRE(properties.Inertia(1, 1) == Approx(4.5).epsilon(1e-12));
+        REQUIRE(properties.Inertia(2, 2) == Approx(6.5).epsilon(1e-12));
+        REQUIRE(properties.Inertia(0, 1) == Approx(0).margin(1e-12));
+    }
+
+    SECTION("Same result for any thread count")
+    {
+        GeomRect rect = GeomRect::Make({0, 0, 0}, {4, 0, 0}, {0, 4, 0}, {4, 4, 0});
+        rect.DegreeU = 3;
+        rect.DegreeV = 3;
+        rect.ControlPointCountU = 40;
+        rect.ControlPointCountV = 40;
+        Surface surface = rect.GetSurface();
+        for (int j = 0; j < 40; ++j)
+        {
+            for (int i = 0; i < 40; ++i)
+            {
+                surface.ControlPoints.Get(i, j).z() = 0.2 * std::sin(i + 0.7 * j);
+            }
+        }
+
+        IntegrationOptions options;
+        options.ThreadCount = 1;
+        const MassProperties serial = ComputeMassProperties(surface, options);
+        for (int thread_count : {2, 3, 8})
+        {
+            options.ThreadCount = thread_count;
+            const MassProperties parallel = ComputeMassProperties(surface, options);
+            REQUIRE(parallel.Measure == serial.Measure);
+            REQUIRE(parallel.Centroid == serial.Centroid);
+            REQUIRE(parallel.Inertia == serial.Inertia);
+        }
+        REQUIRE(serial.Measure > 16);
+    }
+}
+
+TEST_CASE("Analysis/SurfaceElements", "[analysis]")
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 2, 0}, {3, 2, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 2;
+    rect.ControlPointCountU = 7;
+    rect.ControlPointCountV = 5;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < 5; ++j)
+    {
+        for (int i = 0; i < 7; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = 0.3 * std::sin(i + 0.5 * j);
+            surface.ControlPoints.Get(i, j).w() = 1 + 0.2 * std::cos(0.7 * i - j);
+        }
+    }
+
+    SurfaceElements elements(surface);
+    REQUIRE(elements.ElementCount() == 4 * 3);
+    REQUIRE(elements.PointCount() == 4 * 3);
+    REQUIRE(elements.FunctionCount() == 4 * 3);
+
+    SECTION("Cached values match the surface")
+    {
+        Surface::EvaluationScratch scratch;
+        for (int element = 0; element < elements.ElementCount(); ++element)
+        {
+            const auto [span_u, span_v] = elements.Spans(element);
+            REQUIRE(elements.Functions(element)[0] == (span_v - 2) * 7 + span_u - 3);
+            for (int point = 0; point < elements.PointCount(); ++point)
+            {
+                const auto parameters = elements.Parameters(element)[point];
+                const auto& ders = surface.EvaluateAll(parameters.x(), parameters.y(), 1, 1, scratch);
+                const auto& jacobian = elements.Jacobians(element)[point];
+                REQUIRE((elements.Points(element)[point] - ders.Get(0, 0)).norm() == Approx(0).margin(1e-12));
+                REQUIRE((jacobian.col(0) - ders.Get(1, 0)).norm() == Approx(0).margin(1e-11));
+                REQUIRE((jacobian.col(1) - ders.Get(0, 1)).norm() == Approx(0).margin(1e-11));
+
+                // Partition of unity, so the gradients cancel as well
+                const auto values = elements.Values(element, point);
+                const auto gradients = elements.Gradients(element, point);
+                Numeric sum = 0;
+                Vec3 gradient = Vec3::Zero(), position = Vec3::Zero();
+                for (int f = 0; f < elements.FunctionCount(); ++f)
+                {
+                    sum += values[f];
+                    gradient += gradients[f];
+                    position += values[f] * surface.ControlPoints.Values[elements.Functions(element)[f]].head<3>();
+                }
+                REQUIRE(sum == Approx(1).epsilon(1e-14));
+                REQUIRE(gradient.norm() == Approx(0).margin(1e-12));
+                REQUIRE((position - ders.Get(0, 0)).norm() == Approx(0).margin(1e-12));
+
+                // The gradient of the x coordinate is the tangential part of e_x
+                Vec3 gradient_x = Vec3::Zero();
+                for (int f = 0; f < elements.FunctionCount(); ++f)
+                {
+                    gradient_x += surface.ControlPoints.Values[elements.Functions(element)[f]].x() * gradients[f];
+                }
+                const Vec3 normal = jacobian.col(0).cross(jacobian.col(1)).normalized();
+                const Vec3 expected = Vec3::UnitX() - normal.x() * normal;
+                REQUIRE((gradient_x - expected).norm() == Approx(0).margin(1e-11));
+            }
+        }
+    }
+
+    SECTION("Area and update")
+    {
+        IntegrationOptions options;
+        options.PointCount = 12;
+        Numeric area = 0;
+        elements = SurfaceElements(surface, 12);
+        for (int element = 0; element < elements.ElementCount(); ++element)
+        {
+            for (Numeric measure : elements.Measures(element))
+            {
+                area += measure;
+            }
+        }
+        REQUIRE(area == Approx(ComputeMassProperties(surface, options).Measure).epsilon(1e-13));
+
+        for (auto& point : surface.ControlPoints.Values)
+        {
+            point.z() = 0;
+        }
+        elements.Update(surface);
+        area = 0;
+        for (int element = 0; element < elements.ElementCount(); ++element)
+        {
+            for (Numeric measure : elements.Measures(element))
+            {
+                area += measure;
+            }
+        }
+        REQUIRE(area == Approx(6).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("Analysis/CollocationMatrix", "[analysis]")
+{
+    SECTION("Curve")
+    {
+        GeomSegment segment = GeomSegment::Make({0, 0, 0}, {5, 0, 0});
+        segment.Degree = 3;
+        segment.ControlPointCount = 12;
+        Curve curve = segment.GetCurve();
+        Eigen::Matrix<Numeric, Eigen::Dynamic, 3> points(12, 3);
+        for (int i = 0; i < 12; ++i)
+        {
+            curve.ControlPoints[i].y() = std::sin(i);
+            curve.ControlPoints[i].w() = 1 + 0.3 * std::cos(2.0 * i);
+            points.row(i) = curve.ControlPoints[i].head<3>().transpose();
+        }
+
+        std::vector<Numeric> parameters;
+        for (int k = 0; k <= 1000; ++k)
+        {
+            // Not sorted, and hitting the knots
+            parameters.push_back(k % 3 == 0 ? (1000 - k) / 1000.0 : k / 1000.0);
+        }
+        const SparseMatrix matrix = CollocationMatrix(curve, parameters);
+        REQUIRE(matrix.rows() == 1001);
+        REQUIRE(matrix.cols() == 12);
+        REQUIRE(matrix.isCompressed());
+        REQUIRE(matrix.nonZeros() == 1001 * 4);
+
+        const Eigen::Matrix<Numeric, Eigen::Dynamic, 3> samples = matrix * points;
+        for (int k = 0; k <= 1000; ++k)
+        {
+            REQUIRE((samples.row(k).transpose() - curve.Evaluate(parameters[k])).norm() == Approx(0).margin(1e-12));
+        }
+
+        const SparseMatrix serial = CollocationMatrix(curve, parameters, 1);
+        REQUIRE((serial - matrix).norm() == 0);
+    }
+
+    SECTION("Surface")
+    {
+        GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 2, 0}, {3, 2, 0});
+        rect.DegreeU = 3;
+        rect.DegreeV = 2;
+        rect.ControlPointCountU = 8;
+        rect.ControlPointCountV = 6;
+        Surface surface = rect.GetSurface();
+        for (int j = 0; j < 6; ++j)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                surface.ControlPoints.Get(i, j).z() = 0.3 * std::sin(i + 0.5 * j);
+                surface.ControlPoints.Get(i, j).w() = 1 + 0.2 * std::cos(0.7 * i - j);
+            }
+        }
+        Eigen::Matrix<Numeric, Eigen::Dynamic, 3> points(48, 3);
+        for (int k = 0; k < 48; ++k)
+        {
+            points.row(k) = surface.ControlPoints.Values[k].head<3>().transpose();
+        }
+
+        std::vector<Eigen::Vector2<Numeric>> parameters;
+        for (int j = 0; j <= 40; ++j)
+        {
+            for (int i = 0; i <= 40; ++i)
+            {
+                parameters.emplace_back(i / 40.0, j / 40.0);
+            }
+        }
+        const SparseMatrix matrix = CollocationMatrix(surface, parameters);
+        REQUIRE(matrix.rows() == 41 * 41);
+        REQUIRE(matrix.cols() == 48);
+        REQUIRE(matrix.nonZeros() == 41 * 41 * 12);
+
+        const Eigen::Matrix<Numeric, Eigen::Dynamic, 3> samples = matrix * points;
+        for (int k = 0; k < 41 * 41; ++k)
+        {
+            const Vec3 expected = surface.Evaluate(parameters[k].x(), parameters[k].y());
+            REQUIRE((samples.row(k).transpose() - expected).norm() == Approx(0).margin(1e-12));
+        }
+    }
+}
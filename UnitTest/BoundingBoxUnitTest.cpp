@@ -0,0 +1,64 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <libnurbs/Core/BoundingBoxArray.hpp>
+
+using namespace std;
+using namespace libnurbs;
+using namespace Catch;
+
+TEST_CASE("Core/BoundingBoxArray", "[bounding_box]")
+{
+    vector<BoundingBox> boxes;
+    for (int i = 0; i < 70; ++i)
+    {
+        Vec3 center{std::fmod(i * 0.731, 5.0), std::fmod(i * 0.317, 5.0), std::fmod(i * 0.193, 5.0)};
+        Vec3 half{0.2 + std::fmod(i * 0.37, 0.6), 0.1 + std::fmod(i * 0.53, 0.5), 0.3};
+        boxes.emplace_back(center - half, center + half);
+    }
+    BoundingBoxArray array(boxes);
+    REQUIRE(array.Size() == 70);
+    REQUIRE(array.Get(17).Min == boxes[17].Min);
+    REQUIRE(array.Get(17).Max == boxes[17].Max);
+
+    BoundingBox query({1.0, 1.5, 0.5}, {2.5, 3.0, 2.0});
+    Vec3 point{2.1, 1.7, 0.6};
+    Vec3 origin{-1.0, 0.3, 2.0};
+    vector<Vec3> directions{Vec3{1.0, 0.4, -0.1}.normalized(), Vec3{1.0, 0.0, 0.0}, Vec3{0.0, 0.0, -1.0}};
+
+    // Unaligned starts, partial packs and a full 64 box mask
+    for (auto [start, count] : {pair{0, 4}, pair{1, 3}, pair{5, 11}, pair{3, 64}, pair{66, 4}, pair{69, 1}})
+    {
+        INFO("start: " << start << ", count: " << count);
+        uint64_t intersects = array.IntersectsMask(query, start, count);
+        uint64_t contains   = array.ContainsMask(point, start, count);
+        vector<Numeric> distances(count);
+        array.SquaredDistances(point, start, count, distances.data());
+        for (int k = 0; k < count; ++k)
+        {
+            const BoundingBox& box = boxes[start + k];
+            REQUIRE(((intersects >> k) & 1) == box.Intersects(query));
+            REQUIRE(((contains >> k) & 1) == box.Contains(point));
+            REQUIRE(distances[k] == Approx(box.SquaredDistance(point)).margin(1e-15));
+        }
+        if (count < 64)
+        {
+            REQUIRE((intersects >> count) == 0);
+        }
+
+        for (const Vec3& direction : directions)
+        {
+            const Vec3 inverse = direction.cwiseInverse();
+            vector<Numeric> enters(count);
+            uint64_t hits = array.IntersectRayMask(origin, inverse, 0, 6, start, count, enters.data());
+            for (int k = 0; k < count; ++k)
+            {
+                Numeric enter;
+                bool hit = boxes[start + k].IntersectRay(origin, inverse, 0, 6, enter);
+                REQUIRE(((hits >> k) & 1) == hit);
+                if (hit) REQUIRE(enters[k] == enter);
+            }
+        }
+    }
+}
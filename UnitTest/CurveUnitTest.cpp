@@ -3,8 +3,16 @@
 #include <catch2/matchers/catch_matchers_all.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <libnurbs/Curve/ArcLengthTable.hpp>
 #include <libnurbs/Curve/Curve.hpp>
-
+#include <libnurbs/Curve/CurveIntersection.hpp>
+#include <libnurbs/Curve/CurvePointInversion.hpp>
+#include <libnurbs/Curve/FeedrateInterpolator.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+
+#include <algorithm>
+#include <numbers>
+#include <random>
 #include <stdexcept>
 
 using namespace Catch;
@@ -865,6 +873,236 @@ TEST_CASE("Curve/ElevateDegree", "[curve][rational]")
     }
 }
 
+TEST_CASE("Curve/ProjectPoints", "[curve][non_rational]")
+{
+    Curve curve;
+    curve.Degree = 3;
+    curve.Knots = KnotVector{{0.0, 0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0, 1.0}};
+    curve.ControlPoints =
+    {
+        {0.0, 0.0, 0.0, 1.0},
+        {1.0, 2.0, 0.0, 1.0},
+        {2.0, -1.0, 0.0, 1.0},
+        {3.0, 2.0, 0.0, 1.0},
+        {4.0, -1.0, 0.0, 1.0},
+        {5.0, 2.0, 0.0, 1.0},
+        {6.0, 0.0, 0.0, 1.0}
+    };
+
+    // Offsets along z are orthogonal to this planar curve, so C(u) stays the closest point.
+    vector<Numeric> parameters;
+    vector<Vec3> points;
+    for (int i = 0; i <= 200; ++i)
+    {
+        Numeric u = i / 200.0;
+        parameters.push_back(u);
+        points.push_back(curve.Evaluate(u) + Vec3{0.0, 0.0, 0.1 * (i % 3)});
+    }
+
+    SECTION("Single thread")
+    {
+        auto results = curve.ProjectPoints(points, 1e-10, 32, 1);
+        REQUIRE(results.size() == points.size());
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            INFO("u: " << parameters[i]);
+            REQUIRE(results[i].Converged);
+            REQUIRE(results[i].Parameter == Approx(parameters[i]).margin(1e-8));
+            REQUIRE(results[i].Distance == Approx(0.1 * (i % 3)).margin(1e-8));
+            REQUIRE((results[i].Point - curve.Evaluate(parameters[i])).norm() < 1e-8);
+        }
+    }
+
+    SECTION("Multiple threads give the same results")
+    {
+        auto expected = curve.ProjectPoints(points, 1e-10, 32, 1);
+        auto results = curve.ProjectPoints(points, 1e-10, 32, 4);
+        REQUIRE(results.size() == expected.size());
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            REQUIRE(results[i].Parameter == expected[i].Parameter);
+            REQUIRE(results[i].Converged == expected[i].Converged);
+        }
+    }
+
+    SECTION("Global minimum away from the initial guess of SearchParameter")
+    {
+        Vec3 point{0.2, 3.0, 0.0};
+        auto results = curve.ProjectPoints(std::span(&point, 1));
+        Numeric best = std::numeric_limits<Numeric>::max();
+        for (int i = 0; i <= 10000; ++i)
+        {
+            best = std::min(best, (curve.Evaluate(i / 10000.0) - point).norm());
+        }
+        REQUIRE(results[0].Converged);
+        REQUIRE(results[0].Distance <= best + 1e-9);
+    }
+}
+
+TEST_CASE("Curve/ClosestPoint", "[curve][rational]")
+{
+    SECTION("Global minimum among many local minima")
+    {
+        Curve curve;
+        curve.Degree = 3;
+        curve.Knots = KnotVector{{0.0, 0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0, 1.0}};
+        curve.ControlPoints =
+        {
+            {0.0, 0.0, 0.0, 1.0},
+            {1.0, 2.0, 0.0, 1.0},
+            {2.0, -1.0, 0.0, 1.0},
+            {3.0, 2.0, 0.0, 1.0},
+            {4.0, -1.0, 0.0, 1.0},
+            {5.0, 2.0, 0.0, 1.0},
+            {6.0, 0.0, 0.0, 1.0}
+        };
+
+        CurvePointInversion inversion(curve);
+        REQUIRE(inversion.SegmentCount() == 4);
+        for (const Vec3& point : {Vec3{0.2, 3.0, 0.0}, Vec3{3.0, 0.5, 1.0}, Vec3{-1.0, -1.0, 0.0}, Vec3{7.0, 0.3, 0.0}})
+        {
+            Numeric best = std::numeric_limits<Numeric>::max();
+            for (int i = 0; i <= 20000; ++i)
+            {
+                best = std::min(best, (curve.Evaluate(i / 20000.0) - point).norm());
+            }
+            auto result = inversion.Project(point);
+            INFO("point: " << point.transpose());
+            REQUIRE(result.Converged);
+            REQUIRE(result.Distance <= best + 1e-12);
+            REQUIRE((curve.Evaluate(result.Parameter) - result.Point).norm() < 1e-12);
+        }
+    }
+
+    SECTION("Points on a rational arc")
+    {
+        Curve curve;
+        curve.Degree = 2;
+        curve.Knots = KnotVector{{0, 0, 0, 1, 1, 1}};
+        curve.ControlPoints =
+        {
+            {0.0, 1.0, 0.0, 2.0},
+            {1.0, 1.0, 0.0, 1.0},
+            {1.0, 0.0, 0.0, 1.0}
+        };
+
+        for (Numeric u : {0.0, 1e-9, 0.00123, 0.3, 0.5, 0.678, 1.0})
+        {
+            auto result = curve.ClosestPoint(curve.Evaluate(u));
+            INFO("u: " << u);
+            REQUIRE(result.Parameter == Approx(u).margin(1e-10));
+            REQUIRE(result.Distance < 1e-12);
+        }
+
+        // Every point of the arc is equally far from its center.
+        auto result = curve.ClosestPoint(Vec3{0.0, 0.0, 0.0});
+        REQUIRE(result.Distance == Approx(1.0));
+    }
+}
+
+TEST_CASE("Curve/Tessellate", "[curve][rational]")
+{
+    Curve curve;
+    curve.Degree = 3;
+    curve.Knots = KnotVector{{0.0, 0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0, 1.0}};
+    curve.ControlPoints =
+    {
+        {0.0, 0.0, 0.0, 1.0},
+        {1.0, 2.0, 0.0, 1.0},
+        {2.0, -1.0, 1.0, 3.0},
+        {3.0, 2.0, 0.0, 1.0},
+        {4.0, -1.0, 0.0, 0.5},
+        {5.0, 2.0, 0.0, 1.0},
+        {6.0, 0.0, 0.0, 1.0}
+    };
+
+    auto distance_to_chord = [](const Vec3& point, const Vec3& a, const Vec3& b)
+    {
+        Vec3 chord = b - a;
+        Numeric t  = std::clamp((point - a).dot(chord) / chord.squaredNorm(), 0.0, 1.0);
+        return (point - a - t * chord).norm();
+    };
+
+    Polyline polyline;
+    for (Numeric tolerance : {1e-1, 1e-3, 1e-6})
+    {
+        curve.Tessellate(tolerance, 0.0, polyline);
+        INFO("tolerance: " << tolerance << ", count: " << polyline.Count());
+        REQUIRE(polyline.Parameters.size() == polyline.Points.size());
+        REQUIRE(polyline.Parameters.front() == 0.0);
+        REQUIRE(polyline.Parameters.back() == 1.0);
+        for (int k = 0; k + 1 < polyline.Count(); ++k)
+        {
+            Numeric low  = polyline.Parameters[k];
+            Numeric high = polyline.Parameters[k + 1];
+            REQUIRE(low < high);
+            REQUIRE((curve.Evaluate(low) - polyline.Points[k]).norm() < 1e-12);
+            for (int i = 1; i < 16; ++i)
+            {
+                Vec3 point = curve.Evaluate(low + (high - low) * i / 16.0);
+                REQUIRE(distance_to_chord(point, polyline.Points[k], polyline.Points[k + 1]) <= tolerance + 1e-12);
+            }
+        }
+    }
+
+    SECTION("Tighter tolerances refine")
+    {
+        curve.Tessellate(1e-2, 0.0, polyline);
+        int coarse = polyline.Count();
+        curve.Tessellate(1e-4, 0.0, polyline);
+        REQUIRE(polyline.Count() > coarse);
+    }
+
+    SECTION("Angle tolerance")
+    {
+        const Numeric angle = 0.1;
+        curve.Tessellate(1.0, angle, polyline);
+        for (int k = 0; k + 1 < polyline.Count(); ++k)
+        {
+            Vec3 chord = (polyline.Points[k + 1] - polyline.Points[k]).normalized();
+            for (int i = 0; i <= 8; ++i)
+            {
+                Numeric u    = polyline.Parameters[k] + (polyline.Parameters[k + 1] - polyline.Parameters[k]) * i / 8.0;
+                Vec3 tangent = curve.EvaluateDerivative(u, 1).normalized();
+                REQUIRE(std::acos(std::clamp(tangent.dot(chord), -1.0, 1.0)) <= angle + 1e-9);
+            }
+        }
+    }
+}
+
+TEST_CASE("Curve/SampleUniform", "[curve][rational]")
+{
+    Curve curve;
+    curve.Degree = 3;
+    curve.Knots = KnotVector{{0.0, 0.0, 0.0, 0.0, 0.2, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0}};
+    curve.ControlPoints =
+    {
+        {0.0, 0.0, 0.0, 1.0},
+        {1.0, 2.0, 0.0, 1.0},
+        {2.0, -1.0, 1.0, 3.0},
+        {3.0, 2.0, 0.0, 1.0},
+        {4.0, -1.0, 0.0, 0.5},
+        {5.0, 2.0, 0.0, 1.0},
+        {6.0, 0.0, 0.0, 1.0}
+    };
+
+    Polyline polyline;
+    for (int n : {1, 7, 10000})
+    {
+        curve.SampleUniform(n, polyline);
+        INFO("n: " << n);
+        REQUIRE(polyline.Count() == 3 * n + 1);
+        REQUIRE(polyline.Parameters[n] == 0.2);
+        REQUIRE(polyline.Parameters[2 * n] == 0.5);
+        REQUIRE(polyline.Parameters[3 * n] == 1.0);
+        // Within the documented drift bound
+        for (int k = 0; k < polyline.Count(); ++k)
+        {
+            REQUIRE((polyline.Points[k] - curve.Evaluate(polyline.Parameters[k])).norm() < 1e-11);
+        }
+    }
+}
+
 TEST_CASE("Curve/LoadFromFile - Valid TXT Input", "[LoadFromFile]")
 {
     std::string valid_input =
@@ -1253,3 +1491,514 @@ TEST_CASE("Curve/SaveToFile and LoadFromFile - Binary Mode", "[SaveAndLoad]")
         REQUIRE(loaded_curve.ControlPoints[i].w() == Approx(original_curve.ControlPoints[i].w()));
     }
 }
+
+TEST_CASE("Curve/GetBoundingBox", "[curve][rational]")
+{
+    auto sampled_box = [](const Curve& curve)
+    {
+        BoundingBox box(curve.Evaluate(0.0), curve.Evaluate(0.0));
+        for (int i = 1; i <= 100000; ++i)
+        {
+            box.ExpandToInclude(curve.Evaluate(i / 100000.0));
+        }
+        return box;
+    };
+
+    SECTION("Polynomial curve")
+    {
+        Curve curve;
+        curve.Degree = 3;
+        curve.Knots = KnotVector{{0.0, 0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0, 1.0}};
+        curve.ControlPoints =
+        {
+            {0.0, 0.0, 0.0, 1.0},
+            {1.0, 2.0, 1.0, 1.0},
+            {2.0, -1.0, 0.0, 1.0},
+            {3.0, 2.0, -1.0, 1.0},
+            {4.0, -1.0, 0.0, 1.0},
+            {5.0, 2.0, 0.5, 1.0},
+            {6.0, 0.0, 0.0, 1.0}
+        };
+
+        BoundingBox sampled = sampled_box(curve);
+        BoundingBox exact = curve.GetExactBoundingBox();
+        REQUIRE(((exact.Min - sampled.Min).cwiseAbs().array() < 1e-8).all());
+        REQUIRE(((exact.Max - sampled.Max).cwiseAbs().array() < 1e-8).all());
+        REQUIRE(exact.Contains(sampled));
+
+        for (int thread_count : {1, 4})
+        {
+            BoundingBox subdivided = curve.GetBoundingBox(1e-4, thread_count);
+            REQUIRE(((subdivided.Min - exact.Min).cwiseAbs().array() < 1e-3).all());
+            REQUIRE(((subdivided.Max - exact.Max).cwiseAbs().array() < 1e-3).all());
+            REQUIRE((subdivided.Min.array() >= exact.Min.array() - 1e-12).all());
+            REQUIRE((subdivided.Max.array() <= exact.Max.array() + 1e-12).all());
+
+            BoundingBox parallel = curve.GetExactBoundingBox(thread_count);
+            REQUIRE(parallel.Min == exact.Min);
+            REQUIRE(parallel.Max == exact.Max);
+        }
+    }
+
+    SECTION("Rational arc with an interior extremum")
+    {
+        // Circular arc from -45 to 45 degrees, x reaches 1 in the middle
+        const Numeric h = std::sqrt(0.5);
+        Curve curve;
+        curve.Degree = 2;
+        curve.Knots = KnotVector{{0.0, 0.0, 0.0, 1.0, 1.0, 1.0}};
+        curve.ControlPoints =
+        {
+            {h, -h, 0.0, 1.0},
+            {2 * h, 0.0, 0.0, h},
+            {h, h, 0.0, 1.0}
+        };
+
+        BoundingBox exact = curve.GetExactBoundingBox();
+        REQUIRE(exact.Min.x() == Approx(h));
+        REQUIRE(exact.Max.x() == Approx(1.0).epsilon(1e-14));
+        REQUIRE(exact.Min.y() == Approx(-h));
+        REQUIRE(exact.Max.y() == Approx(h));
+
+        BoundingBox subdivided = curve.GetBoundingBox(1e-6);
+        REQUIRE(subdivided.Max.x() == Approx(1.0).margin(1e-6));
+        REQUIRE(subdivided.Max.x() <= 1.0 + 1e-12);
+    }
+}
+
+TEST_CASE("Curve/Intersect", "[curve][intersection]")
+{
+    auto make_line = [](const Vec3& start, const Vec3& end, int degree, int count)
+    {
+        GeomSegment segment = GeomSegment::Make(start, end);
+        segment.Degree = degree;
+        segment.ControlPointCount = count;
+        return segment.GetCurve();
+    };
+    auto require_on_both = [](const Curve& a, const Curve& b, const CurveIntersection& hit, Numeric tolerance)
+    {
+        REQUIRE(hit.Distance <= tolerance);
+        REQUIRE((a.Evaluate(hit.ParameterA) - hit.Point).norm() < 1e-12);
+        REQUIRE((b.Evaluate(hit.ParameterB) - hit.Point).norm() <= tolerance);
+    };
+
+    SECTION("Wave crossing a line")
+    {
+        Curve wave = make_line({0, 0, 0}, {10, 0, 0}, 3, 14);
+        for (int i = 0; i < 14; ++i)
+        {
+            wave.ControlPoints[i].y() = i % 2 == 0 ? 1.0 : -1.0;
+        }
+        // Slanted, with unevenly spaced knots and a rational control point
+        Curve line = make_line({-1, -0.3, 0}, {11, 0.4, 0}, 2, 5);
+        line.ControlPoints[2].w() = 3.0;
+
+        // Reference: sign changes of the height of the wave over the line
+        auto height = [&](Numeric t)
+        {
+            Vec3 point = wave.Evaluate(t);
+            return point.y() - (-0.3 + 0.7 * (point.x() + 1) / 12);
+        };
+        int expected = 0;
+        for (int i = 0; i < 100000; ++i)
+        {
+            if (height(i / 100000.0) * height((i + 1) / 100000.0) < 0) expected++;
+        }
+
+        auto hits = Intersect(wave, line);
+        REQUIRE(expected > 5);
+        REQUIRE(static_cast<int>(hits.size()) == expected);
+        for (size_t k = 0; k < hits.size(); ++k)
+        {
+            require_on_both(wave, line, hits[k], 1e-9);
+            REQUIRE(std::abs(height(hits[k].ParameterA)) < 1e-9);
+            if (k > 0) REQUIRE(hits[k].ParameterA > hits[k - 1].ParameterA);
+        }
+
+        auto swapped = Intersect(line, wave);
+        REQUIRE(swapped.size() == hits.size());
+        for (const auto& hit : swapped)
+        {
+            auto same = std::find_if(hits.begin(), hits.end(), [&](const auto& other)
+            {
+                return std::abs(other.ParameterA - hit.ParameterB) < 1e-8 &&
+                       std::abs(other.ParameterB - hit.ParameterA) < 1e-8;
+            });
+            REQUIRE(same != hits.end());
+        }
+    }
+
+    SECTION("Rational arc")
+    {
+        // Circular arc from -45 to 45 degrees against the diagonal, which it meets at 22.5 degrees
+        const Numeric h = std::sqrt(0.5);
+        Curve arc;
+        arc.Degree = 2;
+        arc.Knots = KnotVector{{0.0, 0.0, 0.0, 1.0, 1.0, 1.0}};
+        arc.ControlPoints = {{h, -h, 0.0, 1.0}, {2 * h, 0.0, 0.0, h}, {h, h, 0.0, 1.0}};
+        const Numeric angle = std::numbers::pi / 8;
+        Curve ray = make_line({0, 0, 0}, {2 * std::cos(angle), 2 * std::sin(angle), 0}, 1, 2);
+
+        auto hits = Intersect(arc, ray, 1e-12);
+        REQUIRE(hits.size() == 1);
+        require_on_both(arc, ray, hits[0], 1e-12);
+        REQUIRE(hits[0].Point.x() == Approx(std::cos(angle)).margin(1e-12));
+        REQUIRE(hits[0].Point.y() == Approx(std::sin(angle)).margin(1e-12));
+        REQUIRE(hits[0].ParameterB == Approx(0.5).margin(1e-12));
+
+        SECTION("Tangency is reported once")
+        {
+            Curve tangent = make_line({1, -1, 0}, {1, 1, 0}, 1, 2);
+            auto touches = Intersect(arc, tangent, 1e-9);
+            REQUIRE(touches.size() == 1);
+            REQUIRE(touches[0].Distance <= 1e-9);
+            REQUIRE(touches[0].ParameterA == Approx(0.5).margin(1e-4));
+        }
+    }
+
+    SECTION("Collinear overlap is reported by its ends")
+    {
+        Curve a = make_line({0, 0, 0}, {2, 0, 0}, 3, 6);
+        Curve b = make_line({3, 0, 0}, {1, 0, 0}, 2, 3);
+        auto hits = Intersect(a, b);
+        REQUIRE(hits.size() == 2);
+        REQUIRE(hits[0].Point.x() == Approx(1.0).margin(1e-9));
+        REQUIRE(hits[1].Point.x() == Approx(2.0).margin(1e-9));
+        REQUIRE(hits[0].ParameterB == Approx(1.0).margin(1e-9));
+        REQUIRE(hits[1].ParameterB == Approx(0.5).margin(1e-9));
+    }
+
+    SECTION("Skew curves")
+    {
+        Curve a = make_line({0, 0, 0}, {1, 0, 0}, 3, 5);
+        Curve b = make_line({0.5, -1, 1e-6}, {0.5, 1, 1e-6}, 2, 4);
+        REQUIRE(Intersect(a, b).empty());
+        auto hits = Intersect(a, b, 1e-5);
+        REQUIRE(hits.size() == 1);
+        REQUIRE(hits[0].Distance == Approx(1e-6).margin(1e-12));
+        REQUIRE(hits[0].Point.x() == Approx(0.5).margin(1e-9));
+    }
+}
+
+TEST_CASE("Curve/ArcLengthTable", "[curve][arc_length]")
+{
+    SECTION("A quarter circle has length pi / 2")
+    {
+        Curve arc;
+        arc.Degree = 2;
+        arc.Knots = KnotVector{{0, 0, 0, 1, 1, 1}};
+        const Numeric w = std::sqrt(0.5);
+        arc.ControlPoints = {{1, 0, 0, 1}, {1, 1, 0, w}, {0, 1, 0, 1}};
+        ArcLengthTable table(arc);
+        REQUIRE(table.Length() == Approx(std::numbers::pi / 2).epsilon(1e-12));
+        for (int k = 0; k <= 90; ++k)
+        {
+            // Unit circle: arc length is the angle
+            const Numeric angle = std::numbers::pi / 2 * k / 90;
+            const Vec3 point = arc.Evaluate(table.ParameterAtLength(angle));
+            REQUIRE(point.x() == Approx(std::cos(angle)).margin(1e-9));
+            REQUIRE(point.y() == Approx(std::sin(angle)).margin(1e-9));
+        }
+    }
+
+    SECTION("LengthAt and ParameterAtLength are inverse")
+    {
+        GeomSegment segment = GeomSegment::Make({0, 0, 0}, {10, 0, 0});
+        segment.Degree = 3;
+        segment.ControlPointCount = 12;
+        Curve curve = segment.GetCurve();
+        for (int i = 0; i < 12; ++i)
+        {
+            curve.ControlPoints[i].y() = std::sin(1.3 * i);
+            curve.ControlPoints[i].z() = 0.2 * i * i;
+        }
+        curve.ControlPoints[4].w() = 3;
+        // A double knot and a repeated control point: a kink and a span of zero speed at its end
+        curve = curve.InsertKnot(0.5);
+        curve.ControlPoints[7] = curve.ControlPoints[8];
+
+        ArcLengthTable table(curve, 1e-10, 1);
+        Numeric sampled = 0;
+        Vec3 previous = curve.Evaluate(0);
+        for (int i = 1; i <= 200000; ++i)
+        {
+            const Vec3 point = curve.Evaluate(i / 200000.0);
+            sampled += (point - previous).norm();
+            previous = point;
+        }
+        REQUIRE(table.Length() == Approx(sampled).epsilon(1e-6));
+        REQUIRE(table.LengthAt(0) == 0);
+        REQUIRE(table.LengthAt(1) == Approx(table.Length()));
+
+        Numeric last = -1;
+        for (int k = 0; k <= 1000; ++k)
+        {
+            const Numeric s = table.Length() * k / 1000;
+            const Numeric x = table.ParameterAtLength(s);
+            REQUIRE(x >= last);
+            last = x;
+            REQUIRE(table.LengthAt(x) == Approx(s).margin(1e-8));
+        }
+
+        ArcLengthTable parallel(curve, 1e-10, 4);
+        REQUIRE(parallel.NodeCount() == table.NodeCount());
+        REQUIRE(parallel.Length() == table.Length());
+    }
+}
+
+TEST_CASE("Curve/FeedrateInterpolator", "[curve][arc_length]")
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {10, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = 12;
+    Curve curve = segment.GetCurve();
+    for (int i = 0; i < 12; ++i)
+    {
+        curve.ControlPoints[i].y() = std::sin(1.3 * i);
+        curve.ControlPoints[i].x() += 0.3 * std::cos(2.1 * i);
+    }
+    curve.ControlPoints[4].w() = 3;
+    ArcLengthTable table(curve);
+
+    SECTION("Steps cover equal arc lengths")
+    {
+        const Numeric length = 0.01;
+        FeedrateInterpolator interpolator(curve);
+        REQUIRE(interpolator.Point() == curve.Evaluate(0));
+        int count = 0;
+        Numeric travelled = 0;
+        while (!interpolator.Finished())
+        {
+            const Numeric before = interpolator.Parameter();
+            const Vec3 point = interpolator.Step(length);
+            REQUIRE((point - curve.Evaluate(interpolator.Parameter())).norm() < 1e-12);
+            const Numeric arc = table.LengthAt(interpolator.Parameter()) - table.LengthAt(before);
+            travelled += arc;
+            // Second order in the step: the relative error is about (length / radius)^2
+            if (!interpolator.Finished()) REQUIRE(arc == Approx(length).epsilon(5e-3));
+            count++;
+        }
+        REQUIRE(interpolator.Parameter() == 1);
+        REQUIRE(travelled == Approx(table.Length()));
+        REQUIRE(count == static_cast<int>(std::ceil(table.Length() / length)));
+
+        interpolator.Reset(0.5);
+        REQUIRE(interpolator.Parameter() == 0.5);
+        REQUIRE((interpolator.Velocity() - curve.EvaluateDerivative(0.5, 1)).norm() < 1e-9);
+    }
+
+    SECTION("Through a point where the curve stops")
+    {
+        Curve stop = curve;
+        stop.ControlPoints[5] = stop.ControlPoints[6] = stop.ControlPoints[7];
+        stop = stop.InsertKnot(0.5, 3);
+        FeedrateInterpolator interpolator(stop);
+        int count = 0;
+        while (!interpolator.Finished() && count < 100000)
+        {
+            interpolator.Step(0.01);
+            count++;
+        }
+        REQUIRE(interpolator.Finished());
+    }
+
+    SECTION("Over a span where the curve stands still")
+    {
+        Curve polyline;
+        polyline.Degree = 1;
+        polyline.Knots = KnotVector({0, 0, 0.25, 0.5, 0.75, 1, 1});
+        polyline.ControlPoints = {{0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 0, 1}, {1, 1, 0, 1}, {2, 1, 0, 1}};
+        FeedrateInterpolator interpolator(polyline);
+        int count = 0;
+        while (!interpolator.Finished() && count < 1000)
+        {
+            interpolator.Step(0.1);
+            count++;
+        }
+        REQUIRE(interpolator.Finished());
+        REQUIRE(interpolator.Point() == Vec3(2, 1, 0));
+        // Ten steps per unit leg, one to leave the standing span and maybe a rounding one per knot
+        REQUIRE(count <= 34);
+    }
+}
+
+TEST_CASE("Curve/Interpolate", "[curve][fitting]")
+{
+    SECTION("Passes through the points")
+    {
+        vector<Vec3> points;
+        for (int k = 0; k < 40; ++k)
+        {
+            points.emplace_back(0.1 * k * k, std::sin(0.4 * k), std::cos(0.3 * k));
+        }
+        for (auto parameterization : {Curve::Parameterization::Uniform, Curve::Parameterization::ChordLength,
+                                      Curve::Parameterization::Centripetal})
+        {
+            for (int degree : {1, 2, 3, 5})
+            {
+                const Curve curve = Curve::Interpolate(points, degree, parameterization);
+                REQUIRE(curve.Degree == degree);
+                REQUIRE(curve.ControlPoints.size() == 40);
+                REQUIRE(curve.Knots.IsValid());
+                REQUIRE((curve.Evaluate(0) - points.front()).norm() == Approx(0).margin(1e-12));
+                REQUIRE((curve.Evaluate(1) - points.back()).norm() == Approx(0).margin(1e-12));
+                for (const Vec3& point : points)
+                {
+                    REQUIRE(curve.ClosestPoint(point).Distance == Approx(0).margin(1e-9));
+                }
+            }
+        }
+    }
+
+    SECTION("Reproduces polynomials of the degree")
+    {
+        auto polynomial = [](Numeric t)
+        {
+            return Vec3(t, 2 * t * t - t, t * t * t - 0.5 * t);
+        };
+        vector<Vec3> points;
+        for (int k = 0; k <= 30; ++k)
+        {
+            points.push_back(polynomial(k / 30.0));
+        }
+        const Curve curve = Curve::Interpolate(points, 3, Curve::Parameterization::Uniform);
+        for (int k = 0; k <= 100; ++k)
+        {
+            REQUIRE((curve.Evaluate(k / 100.0) - polynomial(k / 100.0)).norm() == Approx(0).margin(1e-12));
+        }
+    }
+
+    SECTION("Many points")
+    {
+        vector<Vec3> points;
+        for (int k = 0; k < 100000; ++k)
+        {
+            points.emplace_back(0.01 * k, std::sin(0.01 * k), 0);
+        }
+        const Curve curve = Curve::Interpolate(points, 3, Curve::Parameterization::Uniform);
+        REQUIRE(curve.ControlPoints.size() == 100000);
+        for (int k = 0; k < 100000; k += 997)
+        {
+            REQUIRE((curve.Evaluate(k / 99999.0) - points[k]).norm() == Approx(0).margin(1e-9));
+        }
+    }
+
+    SECTION("Invalid input")
+    {
+        const vector<Vec3> points{{0, 0, 0}, {1, 0, 0}, {2, 1, 0}};
+        REQUIRE_THROWS_AS(Curve::Interpolate(points, 3), std::runtime_error);
+        REQUIRE_THROWS_AS(Curve::Interpolate(points, 0), std::runtime_error);
+        const vector<Vec3> repeated{{0, 0, 0}, {1, 0, 0}, {1, 0, 0}, {2, 1, 0}, {3, 0, 0}};
+        REQUIRE_THROWS_AS(Curve::Interpolate(repeated, 2), std::runtime_error);
+    }
+}
+
+TEST_CASE("Curve/Approximate", "[curve][fitting]")
+{
+    vector<Vec3> points;
+    for (int k = 0; k <= 2000; ++k)
+    {
+        const Numeric t = 10.0 * k / 2000;
+        points.emplace_back(t, std::sin(t), 0.1 * std::cos(2 * t));
+    }
+
+    SECTION("Least squares")
+    {
+        const Curve curve = Curve::Approximate(points, 3, 40);
+        REQUIRE(curve.Degree == 3);
+        REQUIRE(curve.ControlPoints.size() == 40);
+        REQUIRE(curve.Knots.IsValid());
+        REQUIRE((curve.Evaluate(0) - points.front()).norm() == Approx(0).margin(1e-12));
+        REQUIRE((curve.Evaluate(1) - points.back()).norm() == Approx(0).margin(1e-12));
+        for (int k = 0; k <= 2000; k += 50)
+        {
+            REQUIRE(curve.ClosestPoint(points[k]).Distance < 1e-4);
+        }
+
+        // As many control points as points interpolates
+        const vector<Vec3> few(points.begin(), points.begin() + 12);
+        const Curve exact = Curve::Approximate(few, 3, 12);
+        for (const Vec3& point : few)
+        {
+            REQUIRE(exact.ClosestPoint(point).Distance == Approx(0).margin(1e-9));
+        }
+    }
+
+    SECTION("Same as dense least squares")
+    {
+        vector<Numeric> weights(points.size());
+        for (size_t k = 0; k < weights.size(); ++k)
+        {
+            weights[k] = 1 + std::sin(0.01 * k) * std::sin(0.01 * k);
+        }
+        const Curve curve = Curve::Approximate(points, 3, 15, weights, Curve::Parameterization::Uniform);
+
+        // Normal equations of the interior control points, assembled densely from the basis
+        const int m = static_cast<int>(points.size()) - 1;
+        MatX a = MatX::Zero(13, 13);
+        MatX b = MatX::Zero(13, 3);
+        for (int k = 1; k < m; ++k)
+        {
+            const Numeric u = static_cast<Numeric>(k) / m;
+            const VecX basis = BSplineBasis::Evaluate(3, curve.Knots, u);
+            const int span = curve.Knots.FindSpanIndex(3, u);
+            VecX row = VecX::Zero(15);
+            row.segment(span - 3, 4) = basis;
+            const Vec3 residual = points[k] - row[0] * points.front() - row[14] * points.back();
+            a += weights[k] * row.segment(1, 13) * row.segment(1, 13).transpose();
+            b += weights[k] * row.segment(1, 13) * residual.transpose();
+        }
+        const MatX expected = a.ldlt().solve(b);
+        for (int i = 1; i < 14; ++i)
+        {
+            REQUIRE((curve.ControlPoints[i].head<3>() - expected.row(i - 1).transpose()).norm() ==
+                    Approx(0).margin(1e-9));
+        }
+    }
+
+    SECTION("Adaptive")
+    {
+        for (Numeric tolerance : {1e-2, 1e-4, 1e-6})
+        {
+            const Curve curve = Curve::ApproximateToTolerance(points, 3, tolerance);
+            for (int k = 0; k <= 2000; k += 10)
+            {
+                REQUIRE(curve.ClosestPoint(points[k]).Distance <= tolerance);
+            }
+            REQUIRE(curve.ControlPoints.size() < 200);
+        }
+    }
+
+    SECTION("Adaptive on clustered and noisy points")
+    {
+        // Noise below any reachable tolerance drives the refinement to the limit of what the points support
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<Numeric> noise(-1, 1);
+        for (int trial = 0; trial < 600; ++trial)
+        {
+            const int count = 36 + trial % 3;
+            vector<Vec3> noisy;
+            Numeric t = 0;
+            for (int k = 0; k < count; ++k)
+            {
+                // Runs of nearly and exactly coincident points between long jumps
+                t += k % 5 == 0 ? 1 + noise(generator) : (trial % 2 ? 1e-6 : 0) * std::abs(noise(generator));
+                noisy.emplace_back(t, noise(generator), 0.1 * noise(generator));
+            }
+            Curve curve;
+            REQUIRE_NOTHROW(curve = Curve::ApproximateToTolerance(noisy, 4, 1e-9));
+            REQUIRE(curve.Knots.IsValid());
+            REQUIRE(curve.ControlPoints.size() <= noisy.size());
+            REQUIRE((curve.Evaluate(0) - noisy.front()).norm() == Approx(0).margin(1e-9));
+            REQUIRE((curve.Evaluate(1) - noisy.back()).norm() == Approx(0).margin(1e-9));
+        }
+    }
+
+    SECTION("Invalid input")
+    {
+        REQUIRE_THROWS_AS(Curve::Approximate(points, 3, 3), std::runtime_error);
+        REQUIRE_THROWS_AS(Curve::Approximate(points, 3, 3000), std::runtime_error);
+        const vector<Numeric> weights(10, 1);
+        REQUIRE_THROWS_AS(Curve::Approximate(points, 3, 20, weights), std::runtime_error);
+    }
+}
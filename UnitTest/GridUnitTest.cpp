@@ -97,4 +97,29 @@ TEST_CASE("Core/Grid", "[grid]")
         REQUIRE(v[1] == Approx(-2));
         REQUIRE(v[2] == Approx(-3));
     }
+
+    SECTION("DirtyRegion")
+    {
+        REQUIRE(grid.DirtyRegion().IsEmpty());
+        grid.Set(1, 2, 5.0);
+        grid.Edit(0, 1) += 1.0;
+        REQUIRE(grid.Get(1, 2) == Approx(5.0));
+        REQUIRE(grid.Get(0, 1) == Approx(2.0));
+        const auto& region = grid.DirtyRegion();
+        REQUIRE(region.MinU == 0);
+        REQUIRE(region.MaxU == 1);
+        REQUIRE(region.MinV == 1);
+        REQUIRE(region.MaxV == 2);
+
+        grid.ClearDirtyRegion();
+        grid.SetU(2, {0.0, 0.0, 0.0});
+        REQUIRE(grid.DirtyRegion().MinU == 2);
+        REQUIRE(grid.DirtyRegion().MinV == 0);
+        REQUIRE(grid.DirtyRegion().MaxV == 2);
+
+        grid.ClearDirtyRegion();
+        grid.InsertV(1);
+        REQUIRE(grid.DirtyRegion().MaxU == 2);
+        REQUIRE(grid.DirtyRegion().MaxV == 3);
+    }
 }
@@ -121,6 +121,19 @@ TEST_CASE("KnotVector/FindSpanIndex", "[knot_vector]")
         REQUIRE(U.FindSpanIndex(2, 0.9) == 6);
         REQUIRE(U.FindSpanIndex(2, 1.0) == 6);
     }
+
+    SECTION("with hint")
+    {
+        KnotVector U{{0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 0.75, 1.0, 1.0, 1.0}};
+        for (Numeric u : {0.0, 0.1, 0.3, 0.4, 0.5, 0.6, 0.75, 0.9, 1.0})
+        {
+            for (int hint = -1; hint <= 8; ++hint)
+            {
+                INFO("u: " << u << ", hint: " << hint);
+                REQUIRE(U.FindSpanIndex(2, u, hint) == U.FindSpanIndex(2, u));
+            }
+        }
+    }
 }
 
 
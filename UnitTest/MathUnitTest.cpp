@@ -1,7 +1,15 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <libnurbs/Algorithm/Bernstein.hpp>
+#include <libnurbs/Algorithm/BezierDecomposition.hpp>
 #include <libnurbs/Algorithm/MathUtils.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+#include <algorithm>
+#include <array>
 
 using namespace std;
 using namespace libnurbs;
@@ -22,4 +30,176 @@ TEST_CASE("Algorithm/MathUtils", "[libnurbs_MathUtils]")
         REQUIRE(Factorial(8) == 40320);
         REQUIRE(Factorial(9) == 362880);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Algorithm/Bernstein", "[libnurbs_MathUtils]")
+{
+    // (t - 0.25)(t - 0.5)(t - 0.9) as a product of its factors in Bernstein form
+    vector<Numeric> a{-0.25, 0.75};
+    vector<Numeric> b{-0.5, 0.5};
+    vector<Numeric> c{-0.9, 0.1};
+    vector<Numeric> ab(3), abc(4);
+    BernsteinMultiply(a, b, ab);
+    BernsteinMultiply(ab, c, abc);
+
+    SECTION("Multiply")
+    {
+        for (Numeric t : {0.0, 0.1, 0.37, 0.5, 0.8, 1.0})
+        {
+            REQUIRE(BernsteinEvaluate(abc, t) == Approx((t - 0.25) * (t - 0.5) * (t - 0.9)).margin(1e-15));
+        }
+    }
+
+    SECTION("Roots")
+    {
+        vector<Numeric> roots;
+        FindBernsteinRoots(abc, 1e-14, roots);
+        REQUIRE(roots.size() == 3);
+        REQUIRE(roots[0] == Approx(0.25).margin(1e-12));
+        REQUIRE(roots[1] == Approx(0.5).margin(1e-12));
+        REQUIRE(roots[2] == Approx(0.9).margin(1e-12));
+    }
+
+    SECTION("Roots into a fixed buffer")
+    {
+        vector<Numeric> expected;
+        FindBernsteinRoots(abc, 1e-14, expected);
+        std::array<Numeric, 4> roots{};
+        REQUIRE(FindBernsteinRoots(abc, 1e-14, roots) == 3);
+        REQUIRE(std::equal(expected.begin(), expected.end(), roots.begin()));
+        REQUIRE(FindBernsteinRoots(abc, 1e-14, std::span(roots).first(2)) == 2);
+        REQUIRE(roots[1] == expected[1]);
+    }
+
+    SECTION("No roots")
+    {
+        vector<Numeric> roots;
+        FindBernsteinRoots(vector<Numeric>{1.0, -0.2, 1.0}, 1e-14, roots);
+        REQUIRE(roots.empty());
+    }
+}
+
+TEST_CASE("Algorithm/DecomposeCurve", "[libnurbs_MathUtils]")
+{
+    Curve curve;
+    curve.Degree = 3;
+    curve.Knots = KnotVector{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0}};
+    curve.ControlPoints =
+    {
+        {0.0, 0.0, 0.0, 1.0},
+        {1.0, 2.0, 0.0, 2.0},
+        {2.0, -1.0, 1.0, 1.0},
+        {3.0, 2.0, 0.0, 0.5},
+        {4.0, -1.0, 0.0, 1.0},
+        {5.0, 2.0, 0.0, 1.0},
+        {6.0, 0.0, 0.0, 1.0}
+    };
+
+    vector<Vec4> homogeneous;
+    for (const auto& point : curve.ControlPoints) homogeneous.push_back(ToHomo(point));
+    vector<Vec4> bezier_points;
+    vector<Numeric> breakpoints;
+    int count = DecomposeCurve(curve.Degree, curve.Knots, homogeneous, bezier_points, breakpoints);
+
+    REQUIRE(count == 3);
+    REQUIRE(bezier_points.size() == 12);
+    REQUIRE(breakpoints == vector<Numeric>{0.0, 0.3, 0.5, 1.0});
+
+    for (int s = 0; s < count; ++s)
+    {
+        for (Numeric t : {0.0, 0.2, 0.5, 0.9, 1.0})
+        {
+            Vec4 point = Vec4::Zero();
+            for (int i = 0; i <= 3; ++i)
+            {
+                point += Binomial(3, i) * std::pow(t, i) * std::pow(1 - t, 3 - i) * bezier_points[s * 4 + i];
+            }
+            Numeric u = breakpoints[s] + t * (breakpoints[s + 1] - breakpoints[s]);
+            INFO("segment: " << s << ", t: " << t);
+            REQUIRE((FromHomo(point).head<3>() - curve.Evaluate(u)).norm() < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("Algorithm/DecomposeSurface", "[libnurbs_MathUtils]")
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 3, 0}, {3, 3, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 2;
+    rect.ControlPointCountU = 6;
+    rect.ControlPointCountV = 5;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(i + 2.0 * j);
+        }
+    }
+    surface.ControlPoints.Get(2, 3).w() = 2.0;
+
+    Grid<Vec4> homogeneous = surface.ControlPoints;
+    for (auto& point : homogeneous.Values) point = ToHomo(point);
+    vector<Vec4> patch_points;
+    vector<Numeric> breakpoints_u, breakpoints_v;
+    DecomposeSurface(3, 2, surface.KnotsU, surface.KnotsV, homogeneous, patch_points, breakpoints_u, breakpoints_v);
+
+    const int count_u = static_cast<int>(breakpoints_u.size()) - 1;
+    const int count_v = static_cast<int>(breakpoints_v.size()) - 1;
+    REQUIRE(count_u == 3);
+    REQUIRE(count_v == 3);
+    REQUIRE(patch_points.size() == 9 * 4 * 3);
+
+    auto bernstein = [](int n, int i, Numeric t) { return Binomial(n, i) * std::pow(t, i) * std::pow(1 - t, n - i); };
+    for (int b = 0; b < count_v; ++b)
+    {
+        for (int a = 0; a < count_u; ++a)
+        {
+            const Vec4* patch = patch_points.data() + (b * count_u + a) * 12;
+            for (Numeric s : {0.0, 0.3, 1.0})
+            {
+                for (Numeric t : {0.0, 0.6, 1.0})
+                {
+                    Vec4 point = Vec4::Zero();
+                    for (int j = 0; j <= 2; ++j)
+                    {
+                        for (int i = 0; i <= 3; ++i)
+                        {
+                            point += bernstein(3, i, s) * bernstein(2, j, t) * patch[j * 4 + i];
+                        }
+                    }
+                    Numeric u = breakpoints_u[a] + s * (breakpoints_u[a + 1] - breakpoints_u[a]);
+                    Numeric v = breakpoints_v[b] + t * (breakpoints_v[b + 1] - breakpoints_v[b]);
+                    REQUIRE((FromHomo(point).head<3>() - surface.Evaluate(u, v)).norm() < 1e-12);
+                }
+            }
+        }
+    }
+
+    SECTION("ExtractBezierPatch matches the decomposition")
+    {
+        Grid<Vec4> local(4, 3);
+        Vec4 patch[12];
+        for (int b = 0; b < count_v; ++b)
+        {
+            for (int a = 0; a < count_u; ++a)
+            {
+                int span_u = surface.KnotsU.FindSpanIndex(3, breakpoints_u[a]);
+                int span_v = surface.KnotsV.FindSpanIndex(2, breakpoints_v[b]);
+                for (int j = 0; j <= 2; ++j)
+                {
+                    for (int i = 0; i <= 3; ++i)
+                    {
+                        local.Get(i, j) = homogeneous.Get(span_u - 3 + i, span_v - 2 + j);
+                    }
+                }
+                ExtractBezierPatch(3, 2, surface.KnotsU, surface.KnotsV, span_u, span_v, local, patch);
+                const Vec4* expected = patch_points.data() + (b * count_u + a) * 12;
+                for (int k = 0; k < 12; ++k)
+                {
+                    REQUIRE((patch[k] - expected[k]).norm() < 1e-12);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <libnurbs/Curve/CurveProjector.hpp>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Surface/SurfaceProjector.hpp>
+
+using namespace Catch;
+using namespace libnurbs;
+using namespace std;
+
+
+TEST_CASE("CurveProjector/Ordered stream", "[curve][projector]")
+{
+    GeomSegment segment = GeomSegment::Make({0, 0, 0}, {8, 0, 0});
+    segment.Degree = 3;
+    segment.ControlPointCount = 12;
+    Curve curve = segment.GetCurve();
+    for (int i = 0; i < segment.ControlPointCount; ++i)
+    {
+        curve.ControlPoints[i].y() = std::sin(1.3 * i);
+    }
+
+    // A scan line hovering above the curve, offsets along z keep C(u) the closest point.
+    vector<Vec3> points;
+    for (int i = 0; i <= 500; ++i)
+    {
+        points.push_back(curve.Evaluate(i / 500.0) + Vec3{0.0, 0.0, 0.05});
+    }
+
+    CurveProjector projector(curve);
+    auto expected = curve.ProjectPoints(points, 1e-10, 32, 1);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        auto result = projector.Project(points[i]);
+        INFO("i: " << i);
+        REQUIRE(result.Converged);
+        REQUIRE(result.Parameter == Approx(i / 500.0).margin(1e-8));
+        REQUIRE(result.Distance == Approx(expected[i].Distance).margin(1e-10));
+    }
+    REQUIRE(projector.GlobalSeedCount() == 1);
+
+    SECTION("Jump back to the start")
+    {
+        auto result = projector.Project(curve.Evaluate(0.0) + Vec3{0.0, 0.0, 0.05});
+        REQUIRE(result.Converged);
+        REQUIRE(result.Parameter == Approx(0.0).margin(1e-8));
+    }
+
+    SECTION("Reset")
+    {
+        projector.Reset();
+        auto result = projector.Project(points[250]);
+        REQUIRE(result.Parameter == Approx(0.5).margin(1e-8));
+        REQUIRE(projector.GlobalSeedCount() == 2);
+    }
+}
+
+
+TEST_CASE("SurfaceProjector/Ordered stream", "[surface][projector]")
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {4, 0, 0}, {0, 4, 0}, {4, 4, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 3;
+    rect.ControlPointCountU = 8;
+    rect.ControlPointCountV = 8;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = 0.4 * std::sin(0.9 * i) * std::cos(0.7 * j);
+        }
+    }
+
+    // Zig-zag scan lines, the first point of every line jumps back across the surface.
+    SurfaceProjector projector(surface);
+    for (int j = 0; j <= 10; ++j)
+    {
+        for (int i = 0; i <= 100; ++i)
+        {
+            Numeric u = i / 100.0, v = j / 10.0;
+            auto ders = surface.EvaluateAll(u, v, 1, 1);
+            Vec3 normal = ders.Get(1, 0).cross(ders.Get(0, 1)).normalized();
+            Numeric offset = (j == 0 || j == 10 || i == 0 || i == 100) ? 0.0 : 0.02;
+            auto result = projector.Project(ders.Get(0, 0) + offset * normal);
+            INFO("u: " << u << ", v: " << v);
+            REQUIRE(result.Converged);
+            REQUIRE(result.U == Approx(u).margin(1e-7));
+            REQUIRE(result.V == Approx(v).margin(1e-7));
+            REQUIRE(result.Distance == Approx(offset).margin(1e-8));
+        }
+    }
+    REQUIRE(projector.GlobalSeedCount() <= 11);
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Scene/SceneBvh.hpp>
+
+using namespace Catch;
+using namespace libnurbs;
+using namespace std;
+
+
+namespace
+{
+    // Small curves and surfaces scattered over a 20 x 20 x 4 block, some of them touching.
+    struct Scene
+    {
+        deque<Curve> Curves;
+        deque<Surface> Surfaces;
+        SceneBvh Bvh;
+
+        Scene()
+        {
+            for (int k = 0; k < 150; ++k)
+            {
+                Vec3 origin{std::fmod(k * 7.31, 20.0), std::fmod(k * 3.17, 20.0), std::fmod(k * 1.93, 4.0)};
+                GeomSegment segment = GeomSegment::Make(origin, origin + Vec3{1.5, 0.5 * std::sin(k), 0.3});
+                segment.Degree = 3;
+                segment.ControlPointCount = 6;
+                Curve& curve = Curves.emplace_back(segment.GetCurve());
+                curve.ControlPoints[2].z() += 0.4;
+                Bvh.AddCurve(curve);
+
+                origin = Vec3{std::fmod(k * 5.77, 20.0), std::fmod(k * 2.39, 20.0), std::fmod(k * 0.71, 4.0)};
+                GeomRect rect = GeomRect::Make(origin, origin + Vec3{1, 0, 0}, origin + Vec3{0, 1, 0},
+                                               origin + Vec3{1, 1, 0.5});
+                rect.DegreeU = 2;
+                rect.DegreeV = 2;
+                rect.ControlPointCountU = 4;
+                rect.ControlPointCountV = 4;
+                Bvh.AddSurface(Surfaces.emplace_back(rect.GetSurface()));
+            }
+            Bvh.Build();
+        }
+
+        void Transform(const Mat3x3& R)
+        {
+            for (auto& curve : Curves) curve = curve.Transform(R);
+            for (auto& surface : Surfaces) surface = surface.Transform(R);
+        }
+    };
+
+    void RequireMatchesBruteForce(const SceneBvh& bvh)
+    {
+        BoundingBox query({4, 4, 0}, {9, 7, 2});
+        vector<int> objects;
+        bvh.QueryBox(query, objects);
+        std::sort(objects.begin(), objects.end());
+        vector<int> expected;
+        for (int object = 0; object < bvh.ObjectCount(); ++object)
+        {
+            if (bvh.ObjectBox(object).Intersects(query)) expected.push_back(object);
+        }
+        REQUIRE(!expected.empty());
+        REQUIRE(objects == expected);
+
+        vector<pair<int, int>> pairs;
+        bvh.QueryOverlaps(pairs);
+        std::sort(pairs.begin(), pairs.end());
+        vector<pair<int, int>> expected_pairs;
+        for (int i = 0; i < bvh.ObjectCount(); ++i)
+        {
+            for (int j = i + 1; j < bvh.ObjectCount(); ++j)
+            {
+                if (bvh.ObjectBox(i).Intersects(bvh.ObjectBox(j))) expected_pairs.emplace_back(i, j);
+            }
+        }
+        REQUIRE(!expected_pairs.empty());
+        REQUIRE(pairs == expected_pairs);
+
+        Vec3 origin{-1, 3.3, 1.1};
+        Vec3 direction = Vec3{1, 0.4, 0.02}.normalized();
+        objects.clear();
+        bvh.QueryRay(origin, direction, 50, objects);
+        std::sort(objects.begin(), objects.end());
+        expected.clear();
+        for (int object = 0; object < bvh.ObjectCount(); ++object)
+        {
+            Numeric enter;
+            if (bvh.ObjectBox(object).IntersectRay(origin, direction.cwiseInverse(), 0, 50, enter))
+            {
+                expected.push_back(object);
+            }
+        }
+        REQUIRE(!expected.empty());
+        REQUIRE(objects == expected);
+    }
+}
+
+TEST_CASE("SceneBvh/Queries", "[scene]")
+{
+    Scene scene;
+    SceneBvh& bvh = scene.Bvh;
+    REQUIRE(bvh.ObjectCount() == 300);
+    REQUIRE(bvh.GetCurve(0) == &scene.Curves[0]);
+    REQUIRE(bvh.GetSurface(0) == nullptr);
+    REQUIRE(bvh.GetSurface(1) == &scene.Surfaces[0]);
+
+    SECTION("Tree layout")
+    {
+        const auto& nodes = bvh.Nodes();
+        vector<int> seen(bvh.ObjectCount(), 0);
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            const auto& node = nodes[index];
+            if (node.IsLeaf())
+            {
+                REQUIRE(node.Count <= SceneBvh::MAX_LEAF_SIZE);
+                for (int k = node.Start; k < node.Start + node.Count; ++k)
+                {
+                    seen[bvh.ObjectOrder()[k]]++;
+                    REQUIRE(node.Box.Contains(bvh.ObjectBox(bvh.ObjectOrder()[k])));
+                }
+                continue;
+            }
+            REQUIRE(node.Box.Contains(nodes[index + 1].Box));
+            REQUIRE(node.Box.Contains(nodes[node.Right].Box));
+        }
+        REQUIRE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+    }
+
+    SECTION("Box, overlap and ray queries")
+    {
+        RequireMatchesBruteForce(bvh);
+    }
+
+    SECTION("Nearest object")
+    {
+        for (Vec3 point : {Vec3{5.2, 6.1, 3.0}, Vec3{-2.0, 10.0, 1.0}, Vec3{12.5, 12.5, 2.0}})
+        {
+            auto nearest = bvh.FindNearest(point);
+            Numeric expected = std::numeric_limits<Numeric>::max();
+            for (const auto& curve : scene.Curves)
+            {
+                expected = std::min(expected, curve.ClosestPoint(point).Distance);
+            }
+            for (const auto& surface : scene.Surfaces)
+            {
+                expected = std::min(expected, surface.ProjectPoints(std::span(&point, 1), 1e-10, 32, 1)[0].Distance);
+            }
+            INFO("point: " << point.transpose());
+            REQUIRE(nearest.Object != INVALID_INDEX);
+            REQUIRE(nearest.Distance == Approx(expected).margin(1e-12));
+            REQUIRE((nearest.Point - point).norm() == Approx(nearest.Distance));
+        }
+    }
+
+    SECTION("Refit after Transform")
+    {
+        Mat3x3 R = Eigen::AngleAxis<Numeric>(0.7, Vec3{0.2, 0.3, 1.0}.normalized()).toRotationMatrix();
+        scene.Transform(R);
+        bvh.Refit();
+        const auto& nodes = bvh.Nodes();
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            if (nodes[index].IsLeaf()) continue;
+            REQUIRE(nodes[index].Box.Contains(nodes[index + 1].Box));
+            REQUIRE(nodes[index].Box.Contains(nodes[nodes[index].Right].Box));
+        }
+        RequireMatchesBruteForce(bvh);
+
+        REQUIRE(bvh.FindNearest(scene.Surfaces[3].Evaluate(0.3, 0.6)).Object == 7);
+
+        // Moving a single object only needs that object re-bounded
+        for (auto& point : scene.Surfaces[3].ControlPoints.Values) point.x() += 30;
+        int moved[] = {7};
+        bvh.Refit(moved);
+        REQUIRE(nodes[0].Box.Contains(bvh.ObjectBox(7)));
+        REQUIRE(bvh.ObjectBox(7).Min.x() > 20);
+        RequireMatchesBruteForce(bvh);
+
+        // The closest point precomputation built above follows the refit
+        const Vec3 point = scene.Surfaces[3].Evaluate(0.3, 0.6);
+        auto nearest = bvh.FindNearest(point);
+        REQUIRE(nearest.Object == 7);
+        REQUIRE(nearest.Distance == Approx(0).margin(1e-9));
+    }
+
+    SECTION("Refit after adding objects builds")
+    {
+        Curve& curve = scene.Curves.emplace_back(scene.Curves.front());
+        for (auto& point : curve.ControlPoints) point.z() += 50;
+        const int object = bvh.AddCurve(curve);
+        bvh.Refit();
+        REQUIRE(bvh.ObjectBox(object).Min.z() > 40);
+        RequireMatchesBruteForce(bvh);
+        REQUIRE(bvh.FindNearest(curve.Evaluate(0.5)).Object == object);
+    }
+}
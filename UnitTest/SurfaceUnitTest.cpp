@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <map>
+#include <numbers>
 #include <stdexcept>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -5,6 +8,9 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <libnurbs/Geometry/GeomRect.hpp>
 #include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Surface/SurfaceBvh.hpp>
+#include <libnurbs/Surface/SurfaceIntersection.hpp>
+#include <libnurbs/Tessellation/PlaneSlicing.hpp>
 
 using namespace Catch;
 using namespace libnurbs;
@@ -1021,6 +1027,60 @@ TEST_CASE("Surface/ElevateDegree", "[surface][elevate_degree]")
 }
 
 
+TEST_CASE("Surface/ProjectPoints", "[surface][search_parameter]")
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 3, 0}, {3, 3, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 2;
+    rect.ControlPointCountU = 6;
+    rect.ControlPointCountV = 5;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = 0.3 * std::sin(i + 2.0 * j);
+        }
+    }
+    surface.ControlPoints.Get(2, 2).w() = 2.0;
+
+    // Small offsets along the normal keep S(u, v) the closest point.
+    vector<std::pair<Numeric, Numeric>> parameters;
+    vector<Vec3> points;
+    for (int j = 0; j <= 20; ++j)
+    {
+        for (int i = 0; i <= 20; ++i)
+        {
+            Numeric u = i / 20.0, v = j / 20.0;
+            auto ders = surface.EvaluateAll(u, v, 1, 1);
+            Vec3 normal = ders.Get(1, 0).cross(ders.Get(0, 1)).normalized();
+            Numeric offset = (i == 0 || j == 0 || i == 20 || j == 20) ? 0.0 : 0.01;
+            parameters.emplace_back(u, v);
+            points.push_back(ders.Get(0, 0) + offset * normal);
+        }
+    }
+
+    auto results = surface.ProjectPoints(points);
+    REQUIRE(results.size() == points.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto [u, v] = parameters[i];
+        INFO("u: " << u << ", v: " << v);
+        REQUIRE(results[i].Converged);
+        REQUIRE(results[i].U == Approx(u).margin(1e-7));
+        REQUIRE(results[i].V == Approx(v).margin(1e-7));
+        REQUIRE(results[i].Distance == Approx((points[i] - surface.Evaluate(u, v)).norm()).margin(1e-8));
+    }
+
+    auto single = surface.ProjectPoints(points, 1e-10, 32, 1);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        REQUIRE(single[i].U == results[i].U);
+        REQUIRE(single[i].V == results[i].V);
+    }
+}
+
+
 TEST_CASE("Surface::LoadFromFile - Valid TXT Input", "[LoadFromFile]")
 {
     std::string valid_input = R"(LIBNURBS TXT SURFACE
@@ -1424,4 +1484,492 @@ TEST_CASE("Surface::LoadFromFile - Values Spanning Multiple Lines", "[LoadFromFi
     REQUIRE(surface.ControlPoints.Values.size() == 12);
 }
 
+namespace
+{
+    // Every mesh edge must be shared by two triangles with opposite directions, except edges on the
+    // parameter domain boundary, which are used once.
+    void RequireCrackFree(const TriangleMesh& mesh)
+    {
+        map<pair<uint32_t, uint32_t>, int> edges;
+        for (int t = 0; t < mesh.TriangleCount(); ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                uint32_t from = mesh.Indices[3 * t + k];
+                uint32_t to   = mesh.Indices[3 * t + (k + 1) % 3];
+                REQUIRE(from != to);
+                edges[{from, to}]++;
+            }
+        }
+        auto on_boundary = [&](uint32_t index)
+        {
+            Numeric u = mesh.UVs[2 * index], v = mesh.UVs[2 * index + 1];
+            return u == 0.0 || u == 1.0 || v == 0.0 || v == 1.0;
+        };
+        for (const auto& [edge, count] : edges)
+        {
+            REQUIRE(count == 1);
+            if (!edges.contains({edge.second, edge.first}))
+            {
+                REQUIRE(on_boundary(edge.first));
+                REQUIRE(on_boundary(edge.second));
+            }
+        }
+    }
+}
+
+TEST_CASE("Surface/Tessellate", "[surface][tessellate]")
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 3, 0}, {3, 3, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 2;
+    rect.ControlPointCountU = 7;
+    rect.ControlPointCountV = 5;
+
+    SECTION("Bilinear patches need two triangles each")
+    {
+        GeomRect bilinear = rect;
+        bilinear.DegreeU = 1;
+        bilinear.DegreeV = 1;
+        Surface surface = bilinear.GetSurface();
+        TriangleMesh mesh;
+        surface.Tessellate({}, mesh);
+        REQUIRE(mesh.TriangleCount() == 2 * 6 * 4);
+        REQUIRE(mesh.VertexCount() == 7 * 5);
+        RequireCrackFree(mesh);
+        for (int i = 0; i < mesh.VertexCount(); ++i)
+        {
+            REQUIRE(mesh.Normal(i).isApprox(Vec3{0, 0, 1}));
+        }
+    }
+
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = (i == 5 ? 1.0 : 0.3) * std::sin(i + 2.0 * j);
+        }
+    }
+    surface.ControlPoints.Get(2, 2).w() = 2.0;
+
+    SECTION("Chordal deviation, orientation and cracks")
+    {
+        Surface::TessellationOptions options;
+        options.NormalTolerance = 0;
+        TriangleMesh mesh;
+        for (Numeric tolerance : {1e-2, 1e-3})
+        {
+            options.ChordTolerance = tolerance;
+            surface.Tessellate(options, mesh);
+            INFO("tolerance: " << tolerance << ", triangles: " << mesh.TriangleCount());
+            RequireCrackFree(mesh);
+            for (int i = 0; i < mesh.VertexCount(); ++i)
+            {
+                REQUIRE((mesh.Position(i) - surface.Evaluate(mesh.UVs[2 * i], mesh.UVs[2 * i + 1])).norm() < 1e-12);
+            }
+            for (int t = 0; t < mesh.TriangleCount(); ++t)
+            {
+                uint32_t a = mesh.Indices[3 * t], b = mesh.Indices[3 * t + 1], c = mesh.Indices[3 * t + 2];
+                Vec3 face = (mesh.Position(b) - mesh.Position(a)).cross(mesh.Position(c) - mesh.Position(a));
+                REQUIRE(face.dot(mesh.Normal(a) + mesh.Normal(b) + mesh.Normal(c)) > 0);
+
+                for (Vec3 weights : {Vec3{1.0 / 3, 1.0 / 3, 1.0 / 3}, Vec3{0.5, 0.5, 0}, Vec3{0, 0.5, 0.5}, Vec3{0.5, 0, 0.5}})
+                {
+                    Numeric u = weights.dot(Vec3{mesh.UVs[2 * a], mesh.UVs[2 * b], mesh.UVs[2 * c]});
+                    Numeric v = weights.dot(Vec3{mesh.UVs[2 * a + 1], mesh.UVs[2 * b + 1], mesh.UVs[2 * c + 1]});
+                    Vec3 point = weights.x() * mesh.Position(a) + weights.y() * mesh.Position(b) +
+                                 weights.z() * mesh.Position(c);
+                    REQUIRE((surface.Evaluate(u, v) - point).norm() <= tolerance);
+                }
+            }
+        }
+    }
+
+    SECTION("Scaling all weights leaves the tessellation unchanged")
+    {
+        // Same surface, so the Bezier points projected for planning must be the same too
+        Surface scaled = surface;
+        for (auto& point : scaled.ControlPoints.Values) point.w() *= 3;
+        Surface::TessellationOptions options;
+        options.NormalTolerance = 0;
+        TriangleMesh mesh, expected;
+        surface.Tessellate(options, expected);
+        scaled.Tessellate(options, mesh);
+        REQUIRE(mesh.Indices == expected.Indices);
+        REQUIRE(mesh.UVs == expected.UVs);
+        for (int i = 0; i < mesh.VertexCount(); ++i)
+        {
+            REQUIRE((mesh.Position(i) - expected.Position(i)).norm() < 1e-12);
+        }
+    }
+
+    SECTION("Normal tolerance refines")
+    {
+        Surface::TessellationOptions options;
+        options.ChordTolerance = 0.1;
+        options.NormalTolerance = 0;
+        TriangleMesh mesh;
+        surface.Tessellate(options, mesh);
+        int coarse = mesh.TriangleCount();
+        options.NormalTolerance = 0.05;
+        surface.Tessellate(options, mesh);
+        REQUIRE(mesh.TriangleCount() > coarse);
+        RequireCrackFree(mesh);
+    }
+}
+
+static Surface MakeWavySurface()
+{
+    GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 3, 0}, {3, 3, 0});
+    rect.DegreeU = 3;
+    rect.DegreeV = 2;
+    rect.ControlPointCountU = 9;
+    rect.ControlPointCountV = 7;
+    Surface surface = rect.GetSurface();
+    for (int j = 0; j < surface.ControlPoints.VCount; ++j)
+    {
+        for (int i = 0; i < surface.ControlPoints.UCount; ++i)
+        {
+            surface.ControlPoints.Get(i, j).z() = std::sin(i + 2.0 * j);
+        }
+    }
+    surface.ControlPoints.Get(3, 2).w() = 2.5;
+    return surface;
+}
+
+TEST_CASE("Surface/GetBoundingBox", "[surface][bounding_box]")
+{
+    Surface surface = MakeWavySurface();
+    Vec3 first = surface.Evaluate(0, 0);
+    BoundingBox sampled(first, first);
+    for (int j = 0; j <= 200; ++j)
+    {
+        for (int i = 0; i <= 200; ++i)
+        {
+            sampled.ExpandToInclude(surface.Evaluate(i / 200.0, j / 200.0));
+        }
+    }
+
+    const Numeric epsilon = 1e-4;
+    BoundingBox box = surface.GetBoundingBox(epsilon);
+    INFO("box: " << box.Min.transpose() << " / " << box.Max.transpose());
+    INFO("sampled: " << sampled.Min.transpose() << " / " << sampled.Max.transpose());
+    // Sampling sees an inner box, subdivision may stay up to epsilon inside the exact one.
+    REQUIRE(((sampled.Min - box.Min).array() > -epsilon).all());
+    REQUIRE(((box.Max - sampled.Max).array() > -epsilon).all());
+    REQUIRE(((sampled.Min - box.Min).array() < 1e-3).all());
+    REQUIRE(((box.Max - sampled.Max).array() < 1e-3).all());
+
+    BoundingBox parallel = surface.GetBoundingBox(epsilon, 4);
+    REQUIRE(parallel.Min == box.Min);
+    REQUIRE(parallel.Max == box.Max);
+}
+
+TEST_CASE("Surface/SurfaceBvh", "[surface][bounding_box]")
+{
+    Surface surface = MakeWavySurface();
+    SurfaceBvh bvh(surface);
+    REQUIRE(bvh.PatchCount() == 6 * 5);
+    REQUIRE(bvh.PatchCountU() == 6);
+
+    SECTION("Patch boxes enclose their patches")
+    {
+        for (int patch = 0; patch < bvh.PatchCount(); ++patch)
+        {
+            Numeric u0, u1, v0, v1;
+            bvh.PatchDomain(patch, u0, u1, v0, v1);
+            for (int j = 0; j <= 8; ++j)
+            {
+                for (int i = 0; i <= 8; ++i)
+                {
+                    Vec3 point = surface.Evaluate(u0 + (u1 - u0) * i / 8, v0 + (v1 - v0) * j / 8);
+                    REQUIRE(bvh.PatchBox(patch).SquaredDistance(point) < 1e-20);
+                }
+            }
+            REQUIRE(bvh.GetBoundingBox().Contains(bvh.PatchBox(patch)));
+        }
+    }
+
+    SECTION("Box and overlap queries match brute force")
+    {
+        BoundingBox query({0.5, 0.5, -0.2}, {1.5, 2.0, 0.1});
+        std::vector<int> patches;
+        bvh.QueryBox(query, patches);
+        std::sort(patches.begin(), patches.end());
+        std::vector<int> expected;
+        for (int patch = 0; patch < bvh.PatchCount(); ++patch)
+        {
+            if (bvh.PatchBox(patch).Intersects(query)) expected.push_back(patch);
+        }
+        REQUIRE(!expected.empty());
+        REQUIRE(patches == expected);
+
+        Surface shifted = surface;
+        for (auto& point : shifted.ControlPoints.Values) point.x() += 2.0;
+        SurfaceBvh other(shifted);
+        std::vector<std::pair<int, int>> pairs;
+        bvh.QueryOverlaps(other, pairs);
+        std::sort(pairs.begin(), pairs.end());
+        std::vector<std::pair<int, int>> expected_pairs;
+        for (int a = 0; a < bvh.PatchCount(); ++a)
+        {
+            for (int b = 0; b < other.PatchCount(); ++b)
+            {
+                if (bvh.PatchBox(a).Intersects(other.PatchBox(b))) expected_pairs.emplace_back(a, b);
+            }
+        }
+        REQUIRE(!expected_pairs.empty());
+        REQUIRE(pairs == expected_pairs);
+    }
+
+    SECTION("Nearest and ray traversal find the brute force optimum")
+    {
+        for (Vec3 point : {Vec3{1.2, 0.7, 2.0}, Vec3{-1.0, 4.0, 0.0}, Vec3{2.9, 1.5, -0.3}})
+        {
+            Numeric best = std::numeric_limits<Numeric>::max();
+            bvh.TraverseNearest(point, [&](int, Numeric distance)
+            {
+                best = std::min(best, distance);
+                return best;
+            });
+            Numeric expected = std::numeric_limits<Numeric>::max();
+            for (int patch = 0; patch < bvh.PatchCount(); ++patch)
+            {
+                expected = std::min(expected, bvh.PatchBox(patch).SquaredDistance(point));
+            }
+            REQUIRE(best == expected);
+        }
+
+        Vec3 origin{-1.0, 1.3, 0.2};
+        Vec3 direction = Vec3{1.0, 0.1, -0.05}.normalized();
+        Numeric nearest = std::numeric_limits<Numeric>::max();
+        std::vector<int> visited;
+        bvh.TraverseRay(origin, direction, 100, [&](int patch, Numeric enter)
+        {
+            visited.push_back(patch);
+            nearest = std::min(nearest, enter);
+            return Numeric(100);
+        });
+        std::sort(visited.begin(), visited.end());
+        std::vector<int> expected;
+        Numeric expected_nearest = std::numeric_limits<Numeric>::max();
+        for (int patch = 0; patch < bvh.PatchCount(); ++patch)
+        {
+            Numeric enter;
+            if (bvh.PatchBox(patch).IntersectRay(origin, direction.cwiseInverse(), 0, 100, enter))
+            {
+                expected.push_back(patch);
+                expected_nearest = std::min(expected_nearest, enter);
+            }
+        }
+        REQUIRE(!expected.empty());
+        REQUIRE(visited == expected);
+        REQUIRE(nearest == expected_nearest);
+    }
+}
+
+TEST_CASE("Surface/IntersectRay", "[surface][intersection]")
+{
+    Surface surface = MakeWavySurface();
+
+    // Reference: nearest hit on a fine tessellation, Moller-Trumbore per triangle
+    TriangleMesh mesh;
+    Surface::TessellationOptions options;
+    options.ChordTolerance = 1e-5;
+    options.NormalTolerance = 0;
+    options.MaxSegments = 256;
+    surface.Tessellate(options, mesh);
+    auto mesh_hit = [&](const Vec3& origin, const Vec3& direction)
+    {
+        Numeric nearest = std::numeric_limits<Numeric>::infinity();
+        for (int t = 0; t < mesh.TriangleCount(); ++t)
+        {
+            Vec3 a = mesh.Position(mesh.Indices[3 * t]);
+            Vec3 e1 = mesh.Position(mesh.Indices[3 * t + 1]) - a;
+            Vec3 e2 = mesh.Position(mesh.Indices[3 * t + 2]) - a;
+            Vec3 h = direction.cross(e2);
+            Numeric det = e1.dot(h);
+            if (std::abs(det) < 1e-15) continue;
+            Vec3 s = origin - a;
+            Numeric b1 = s.dot(h) / det;
+            Vec3 k = s.cross(e1);
+            Numeric b2 = direction.dot(k) / det;
+            Numeric distance = e2.dot(k) / det;
+            if (b1 >= 0 && b2 >= 0 && b1 + b2 <= 1 && distance >= 0) nearest = std::min(nearest, distance);
+        }
+        return nearest;
+    };
+
+    vector<Vec3> origins, directions;
+    for (int j = 0; j < 12; ++j)
+    {
+        for (int i = 0; i < 12; ++i)
+        {
+            origins.emplace_back(0.1 + 0.25 * i, 0.1 + 0.25 * j, 4.0);
+            // Alternating vertical and oblique rays, the oblique ones cross several waves
+            directions.push_back((i + j) % 2 == 0 ? Vec3{0, 0, -1} : Vec3{0.3, 0.2, -1.0});
+        }
+    }
+
+    SECTION("Single rays match the tessellation")
+    {
+        int hit_count = 0;
+        for (size_t k = 0; k < origins.size(); ++k)
+        {
+            auto hit = surface.IntersectRay(origins[k], directions[k]);
+            Numeric expected = mesh_hit(origins[k], directions[k]);
+            INFO("ray " << k << ": " << origins[k].transpose() << " / " << directions[k].transpose());
+            REQUIRE(hit.Hit == std::isfinite(expected));
+            if (!hit.Hit) continue;
+            hit_count++;
+            REQUIRE(hit.T == Approx(expected).margin(1e-3));
+            REQUIRE((hit.Point - (origins[k] + hit.T * directions[k])).norm() < 1e-9);
+            REQUIRE((surface.Evaluate(hit.U, hit.V) - hit.Point).norm() < 1e-9);
+        }
+        REQUIRE(hit_count > 100);
+    }
+
+    SECTION("Misses")
+    {
+        REQUIRE(!surface.IntersectRay({1, 1, 4}, {0, 0, 1}).Hit);
+        REQUIRE(!surface.IntersectRay({5, 5, 0}, {1, 0, 0}).Hit);
+    }
+
+    SECTION("Hits do not depend on the model scale")
+    {
+        // At this scale the rounding of a point exceeds the default epsilon as an absolute distance.
+        constexpr Numeric scale = 1e7;
+        Surface scaled = surface;
+        for (auto& point : scaled.ControlPoints.Values)
+        {
+            point.head<3>() *= scale;
+        }
+        for (size_t k = 0; k < origins.size(); ++k)
+        {
+            auto hit = surface.IntersectRay(origins[k], directions[k]);
+            auto scaled_hit = scaled.IntersectRay(scale * origins[k], directions[k]);
+            INFO("ray " << k);
+            REQUIRE(scaled_hit.Hit == hit.Hit);
+            if (!hit.Hit) continue;
+            REQUIRE(scaled_hit.T == Approx(scale * hit.T).epsilon(1e-9));
+            REQUIRE(scaled_hit.U == Approx(hit.U).margin(1e-6));
+            REQUIRE(scaled_hit.V == Approx(hit.V).margin(1e-6));
+        }
+    }
+
+    SECTION("Packets match single rays")
+    {
+        auto hits = surface.IntersectRays(origins, directions, 1e-10, 1);
+        auto parallel = surface.IntersectRays(origins, directions, 1e-10, 4);
+        REQUIRE(hits.size() == origins.size());
+        for (size_t k = 0; k < origins.size(); ++k)
+        {
+            auto hit = surface.IntersectRay(origins[k], directions[k]);
+            INFO("ray " << k);
+            REQUIRE(hits[k].Hit == hit.Hit);
+            REQUIRE(parallel[k].Hit == hit.Hit);
+            if (!hit.Hit) continue;
+            REQUIRE(hits[k].T == Approx(hit.T).margin(1e-9));
+            REQUIRE(parallel[k].T == hits[k].T);
+        }
+    }
+}
+
+TEST_CASE("Surface/Intersect", "[surface][intersection]")
+{
+    Surface wavy = MakeWavySurface();
+    SurfaceIntersectionOptions options;
+    options.ThreadCount = 2;
 
+    // Every point on both surfaces and on the fitted curve
+    auto require_on_both = [&](const Surface& a, const Surface& b, const vector<SurfaceIntersection>& branches)
+    {
+        for (const auto& branch : branches)
+        {
+            const auto& path = branch.Path;
+            REQUIRE(path.Count() >= 2);
+            REQUIRE(branch.ParametersA.size() == path.Points.size());
+            REQUIRE(branch.ParametersB.size() == path.Points.size());
+            for (int i = 0; i < path.Count(); ++i)
+            {
+                const auto& uv_a = branch.ParametersA[i];
+                const auto& uv_b = branch.ParametersB[i];
+                REQUIRE((a.Evaluate(uv_a.x(), uv_a.y()) - path.Points[i]).norm() < 1e-9);
+                REQUIRE((b.Evaluate(uv_b.x(), uv_b.y()) - path.Points[i]).norm() < 1e-9);
+                REQUIRE((branch.Fitted.Evaluate(path.Parameters[i]) - path.Points[i]).norm() < 1e-9);
+                if (i + 1 < path.Count()) REQUIRE(path.Parameters[i] < path.Parameters[i + 1]);
+            }
+            if (branch.Closed)
+            {
+                REQUIRE((branch.Fitted.Evaluate(1) - path.Points.front()).norm() < 1e-9);
+            }
+        }
+    };
+
+    SECTION("A horizontal plane cuts the contours of slicing")
+    {
+        Surface plane = GeomRect::Make({-1, -1, 0.3}, {4, -1, 0.3}, {-1, 4, 0.3}, {4, 4, 0.3}).GetSurface();
+        const auto branches = Intersect(wavy, plane, options);
+        require_on_both(wavy, plane, branches);
+        for (const auto& branch : branches)
+        {
+            for (const auto& point : branch.Path.Points) REQUIRE(point.z() == Approx(0.3).margin(1e-9));
+            // Between the points the fit stays within the chord tolerance of the plane
+            for (int i = 0; i <= 1000; ++i)
+            {
+                REQUIRE(branch.Fitted.Evaluate(i / 1000.0).z() == Approx(0.3).margin(options.ChordTolerance));
+            }
+        }
+
+        const vector<Numeric> levels{0.3};
+        const auto contours = SliceSurface(wavy, levels);
+        REQUIRE(branches.size() == contours[0].size());
+        int closed = 0;
+        for (const auto& branch : branches) closed += branch.Closed;
+        for (const auto& contour : contours[0]) closed -= contour.Closed;
+        REQUIRE(closed == 0);
+
+        // Same branches with the surfaces swapped
+        const auto swapped = Intersect(plane, wavy, options);
+        REQUIRE(swapped.size() == branches.size());
+    }
+
+    SECTION("A tilted plane")
+    {
+        Surface plane = GeomRect::Make({-1, -1, -1.5}, {4, -1, -0.5}, {-1, 4, 0.5}, {4, 4, 1.5}).GetSurface();
+        const auto branches = Intersect(wavy, plane, options);
+        REQUIRE(!branches.empty());
+        require_on_both(wavy, plane, branches);
+    }
+
+    SECTION("A dome and a plane meet in a closed loop")
+    {
+        GeomRect rect = GeomRect::Make({0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 0});
+        rect.DegreeU = 3;
+        rect.DegreeV = 3;
+        rect.ControlPointCountU = 7;
+        rect.ControlPointCountV = 7;
+        Surface dome = rect.GetSurface();
+        for (int j = 0; j < 7; ++j)
+        {
+            for (int i = 0; i < 7; ++i)
+            {
+                dome.ControlPoints.Get(i, j).z() = std::sin(std::numbers::pi * i / 6) * std::sin(std::numbers::pi * j / 6);
+            }
+        }
+        const Numeric height = 0.5 * dome.Evaluate(0.5, 0.5).z();
+        Surface plane = GeomRect::Make({-1, -1, height}, {3, -1, height}, {-1, 3, height}, {3, 3, height}).GetSurface();
+        const auto branches = Intersect(dome, plane, options);
+        REQUIRE(branches.size() == 1);
+        REQUIRE(branches[0].Closed);
+        REQUIRE(branches[0].Path.Count() >= 8);
+        require_on_both(dome, plane, branches);
+    }
+
+    SECTION("Disjoint surfaces")
+    {
+        Surface plane = GeomRect::Make({-1, -1, 3}, {4, -1, 3}, {-1, 4, 3}, {4, 4, 3}).GetSurface();
+        REQUIRE(Intersect(wavy, plane, options).empty());
+    }
+}
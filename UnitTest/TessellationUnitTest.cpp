@@ -0,0 +1,586 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <libnurbs/Geometry/GeomRect.hpp>
+#include <libnurbs/Geometry/GeomSegment.hpp>
+#include <libnurbs/Tessellation/IncrementalTessellation.hpp>
+#include <libnurbs/Tessellation/MeshWriter.hpp>
+#include <libnurbs/Tessellation/PlaneSlicing.hpp>
+#include <libnurbs/Tessellation/TessellationCache.hpp>
+#include <libnurbs/Tessellation/TessellationEngine.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Catch;
+using namespace libnurbs;
+using namespace std;
+
+namespace
+{
+    Surface MakeWavySurface(int control_point_count, Numeric phase)
+    {
+        GeomRect rect = GeomRect::Make({0, 0, 0}, {3, 0, 0}, {0, 3, 0}, {3, 3, 0});
+        rect.DegreeU = 3;
+        rect.DegreeV = 2;
+        rect.ControlPointCountU = control_point_count;
+        rect.ControlPointCountV = control_point_count;
+        Surface surface = rect.GetSurface();
+        for (int j = 0; j < control_point_count; ++j)
+        {
+            for (int i = 0; i < control_point_count; ++i)
+            {
+                surface.ControlPoints.Get(i, j).z() = 0.3 * std::sin(i + 2.0 * j + phase);
+            }
+        }
+        return surface;
+    }
+
+    Curve MakeWavyCurve(int control_point_count, Numeric phase)
+    {
+        GeomSegment segment = GeomSegment::Make({0, 0, 0}, {10, 0, 0});
+        segment.Degree = 3;
+        segment.ControlPointCount = control_point_count;
+        Curve curve = segment.GetCurve();
+        for (int i = 0; i < control_point_count; ++i)
+        {
+            curve.ControlPoints[i].y() = std::sin(0.9 * i + phase);
+        }
+        return curve;
+    }
+
+    template <typename T>
+    T ReadValue(const string& bytes, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        return value;
+    }
+
+    // Three small surfaces streamed through a writer by the engine, plus the meshes for reference.
+    vector<TriangleMesh> StreamModel(MeshWriter& writer)
+    {
+        vector<Surface> surfaces;
+        for (int i = 0; i < 3; ++i)
+        {
+            surfaces.push_back(MakeWavySurface(5, i));
+        }
+        TessellationSettings settings;
+        settings.SurfaceOptions.ChordTolerance = 1e-2;
+        vector<TriangleMesh> meshes;
+        TessellationEngine engine(2);
+        engine.Run(surfaces, {}, settings,
+                   [&](int, const TriangleMesh& mesh)
+                   {
+                       writer.Write(mesh);
+                       meshes.push_back(mesh);
+                   });
+        writer.Finish();
+        return meshes;
+    }
+}
+
+TEST_CASE("Tessellation/TessellationEngine", "[tessellation]")
+{
+    vector<Surface> surfaces;
+    vector<Curve> curves;
+    for (int i = 0; i < 12; ++i)
+    {
+        // Mix of single task and multi task surfaces
+        surfaces.push_back(MakeWavySurface(i % 3 == 0 ? 20 : 5, i));
+        curves.push_back(MakeWavyCurve(10 + i, i));
+    }
+
+    TessellationSettings settings;
+    settings.SurfaceOptions.ChordTolerance = 1e-3;
+    settings.CurveChordTolerance = 1e-4;
+    settings.PatchesPerTask = 8;
+
+    for (int thread_count : {1, 4})
+    {
+        INFO("threads: " << thread_count);
+        TessellationEngine engine(thread_count);
+        REQUIRE(engine.ThreadCount() == thread_count);
+
+        // Sinks run on worker threads: collect there, check here.
+        vector<int> surface_order, curve_order;
+        vector<TriangleMesh> meshes;
+        vector<Polyline> polylines;
+        engine.Run(surfaces, curves, settings,
+                   [&](int index, const TriangleMesh& mesh)
+                   {
+                       surface_order.push_back(index);
+                       meshes.push_back(mesh);
+                   },
+                   [&](int index, const Polyline& polyline)
+                   {
+                       curve_order.push_back(index);
+                       polylines.push_back(polyline);
+                   });
+
+        REQUIRE(surface_order.size() == surfaces.size());
+        REQUIRE(curve_order.size() == curves.size());
+        for (int i = 0; i < static_cast<int>(surfaces.size()); ++i)
+        {
+            REQUIRE(surface_order[i] == i);
+            TriangleMesh expected;
+            surfaces[i].Tessellate(settings.SurfaceOptions, expected);
+            REQUIRE(meshes[i].Positions == expected.Positions);
+            REQUIRE(meshes[i].Normals == expected.Normals);
+            REQUIRE(meshes[i].UVs == expected.UVs);
+            REQUIRE(meshes[i].Indices == expected.Indices);
+
+            REQUIRE(curve_order[i] == i);
+            Polyline expected_polyline;
+            curves[i].Tessellate(settings.CurveChordTolerance, settings.CurveAngleTolerance, expected_polyline);
+            REQUIRE(polylines[i].Points == expected_polyline.Points);
+            REQUIRE(polylines[i].Parameters == expected_polyline.Parameters);
+        }
+    }
+}
+
+TEST_CASE("Tessellation/MeshWriter", "[tessellation]")
+{
+    SECTION("Binary STL")
+    {
+        std::stringstream stream;
+        StlWriter writer(stream);
+        auto meshes = StreamModel(writer);
+        const string bytes = stream.str();
+
+        uint64_t triangle_count = 0;
+        for (const auto& mesh : meshes) triangle_count += mesh.TriangleCount();
+        REQUIRE(writer.TriangleCount() == triangle_count);
+        REQUIRE(ReadValue<uint32_t>(bytes, 80) == triangle_count);
+        REQUIRE(bytes.size() == 84 + 50 * triangle_count);
+
+        // Last triangle of the last mesh, after the facet normal.
+        const auto& mesh = meshes.back();
+        const size_t record = 84 + 50 * (triangle_count - 1);
+        for (int k = 0; k < 3; ++k)
+        {
+            Vec3 corner = mesh.Position(mesh.Indices[mesh.Indices.size() - 3 + k]);
+            for (int d = 0; d < 3; ++d)
+            {
+                REQUIRE(ReadValue<float>(bytes, record + 12 + 12 * k + 4 * d) == static_cast<float>(corner[d]));
+            }
+        }
+    }
+
+    SECTION("Binary PLY")
+    {
+        std::stringstream stream;
+        PlyWriter writer(stream);
+        auto meshes = StreamModel(writer);
+        const string bytes = stream.str();
+
+        uint64_t vertex_count = 0, triangle_count = 0;
+        for (const auto& mesh : meshes)
+        {
+            vertex_count += mesh.VertexCount();
+            triangle_count += mesh.TriangleCount();
+        }
+        REQUIRE(writer.VertexCount() == vertex_count);
+        const size_t header_end = bytes.find("end_header\n") + 11;
+        std::istringstream header(bytes.substr(0, header_end));
+        string line, keyword, element;
+        uint64_t header_vertices = 0, header_faces = 0;
+        while (std::getline(header, line))
+        {
+            std::istringstream words(line);
+            uint64_t count;
+            if (words >> keyword >> element >> count && keyword == "element")
+            {
+                (element == "vertex" ? header_vertices : header_faces) = count;
+            }
+        }
+        REQUIRE(header_vertices == vertex_count);
+        REQUIRE(header_faces == triangle_count);
+        REQUIRE(bytes.size() == header_end + 32 * vertex_count + 13 * triangle_count);
+
+        // Faces of later meshes are offset by the vertices written before.
+        const size_t faces = header_end + 32 * vertex_count;
+        const auto& last = meshes.back();
+        const size_t face = faces + 13 * (triangle_count - last.TriangleCount());
+        REQUIRE(ReadValue<uint8_t>(bytes, face) == 3);
+        for (int k = 0; k < 3; ++k)
+        {
+            REQUIRE(ReadValue<uint32_t>(bytes, face + 1 + 4 * k) ==
+                    last.Indices[k] + vertex_count - last.VertexCount());
+        }
+        const size_t vertex = header_end + 32 * (vertex_count - last.VertexCount());
+        REQUIRE(ReadValue<float>(bytes, vertex) == static_cast<float>(last.Positions[0]));
+        REQUIRE(ReadValue<float>(bytes, vertex + 28) == static_cast<float>(last.UVs[1]));
+    }
+
+    SECTION("OBJ")
+    {
+        std::stringstream stream;
+        ObjWriter writer(stream);
+        auto meshes = StreamModel(writer);
+
+        vector<Vec3> positions;
+        vector<uint64_t> indices;
+        string line;
+        while (std::getline(stream, line))
+        {
+            std::istringstream words(line);
+            string tag;
+            words >> tag;
+            if (tag == "v")
+            {
+                Vec3 position;
+                words >> position.x() >> position.y() >> position.z();
+                positions.push_back(position);
+            }
+            else if (tag == "f")
+            {
+                string corner;
+                while (words >> corner)
+                {
+                    indices.push_back(std::stoull(corner));
+                }
+            }
+        }
+
+        // Positions read back exactly, faces resolve to the same corners as the meshes.
+        size_t index = 0;
+        for (const auto& mesh : meshes)
+        {
+            for (uint32_t local : mesh.Indices)
+            {
+                REQUIRE(indices[index] >= 1);
+                REQUIRE(positions[indices[index] - 1] == mesh.Position(local));
+                ++index;
+            }
+        }
+        REQUIRE(index == indices.size());
+        REQUIRE(positions.size() == writer.VertexCount());
+    }
+
+    SECTION("Finish is idempotent and closes the writer")
+    {
+        auto check = [](MeshWriter& writer, std::stringstream& stream)
+        {
+            auto meshes = StreamModel(writer);
+            const string bytes = stream.str();
+            writer.Finish();
+            REQUIRE(stream.str() == bytes);
+            REQUIRE_THROWS_AS(writer.Write(meshes.front()), std::runtime_error);
+            REQUIRE(stream.str() == bytes);
+        };
+        std::stringstream stl_stream, ply_stream, obj_stream;
+        StlWriter stl(stl_stream);
+        PlyWriter ply(ply_stream);
+        ObjWriter obj(obj_stream);
+        check(stl, stl_stream);
+        check(ply, ply_stream);
+        check(obj, obj_stream);
+    }
+}
+
+TEST_CASE("Tessellation/TessellationCache", "[tessellation]")
+{
+    Surface surface = MakeWavySurface(8, 0.5);
+    Surface other = MakeWavySurface(6, 1.5);
+    Surface::TessellationOptions coarsest;
+    coarsest.ChordTolerance = 1e-1;
+
+    SECTION("Refinement reuses coarse vertices exactly")
+    {
+        SurfaceTessellation coarse(surface, coarsest);
+        Surface::EvaluationScratch scratch;
+        for (int patch = 0; patch < coarse.PatchCount(); ++patch) coarse.PlanPatch(patch, scratch);
+        coarse.Layout();
+        TriangleMesh coarse_mesh;
+        coarse_mesh.Resize(coarse.VertexCount(), coarse.TriangleCount());
+        for (int patch = 0; patch < coarse.PatchCount(); ++patch) coarse.EmitPatch(patch, coarse_mesh, scratch);
+
+        for (int doublings : {1, 2})
+        {
+            SurfaceTessellation fine = coarse.Refined(doublings);
+            REQUIRE(fine.Options().ChordTolerance == Approx(coarsest.ChordTolerance / (doublings == 1 ? 4 : 16)));
+            REQUIRE(fine.TriangleCount() > coarse.TriangleCount());
+            TriangleMesh reused, evaluated;
+            reused.Resize(fine.VertexCount(), fine.TriangleCount());
+            evaluated.Resize(fine.VertexCount(), fine.TriangleCount());
+            for (int patch = 0; patch < fine.PatchCount(); ++patch)
+            {
+                fine.EmitPatch(patch, reused, scratch, coarse, coarse_mesh);
+                fine.EmitPatch(patch, evaluated, scratch);
+            }
+            REQUIRE(reused.Positions == evaluated.Positions);
+            REQUIRE(reused.Normals == evaluated.Normals);
+            REQUIRE(reused.UVs == evaluated.UVs);
+            REQUIRE(reused.Indices == evaluated.Indices);
+        }
+    }
+
+    SECTION("Ladder, counters and refinement")
+    {
+        TessellationCache cache(coarsest, size_t(1) << 30);
+        REQUIRE(cache.Level(1.0) == 0);
+        REQUIRE(cache.Level(1e-1) == 0);
+        REQUIRE(cache.Level(5e-2) == 1);
+        REQUIRE(cache.Level(1e-2) == 2);
+
+        int coarse_triangles = cache.Get(surface, 1e-1).TriangleCount();
+        REQUIRE(cache.MissCount() == 1);
+        REQUIRE(cache.RefineCount() == 0);
+
+        // Finer level from the coarse one, then both served from the cache
+        const TriangleMesh& fine = cache.Get(surface, 1e-2);
+        REQUIRE(fine.TriangleCount() > coarse_triangles);
+        REQUIRE(cache.MissCount() == 2);
+        REQUIRE(cache.RefineCount() == 1);
+        REQUIRE(&cache.Get(surface, 9e-3) == &fine);
+        REQUIRE(cache.Get(surface, 0.5).TriangleCount() == coarse_triangles);
+        REQUIRE(cache.HitCount() == 2);
+        REQUIRE(cache.EntryCount() == 2);
+
+        // Chord deviation at triangle centroids stays within the level tolerance
+        for (int t = 0; t < fine.TriangleCount(); ++t)
+        {
+            Vec3 centroid = Vec3::Zero();
+            Numeric u = 0, v = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                uint32_t index = fine.Indices[3 * t + k];
+                centroid += fine.Position(index) / 3;
+                u += fine.UVs[2 * index] / 3;
+                v += fine.UVs[2 * index + 1] / 3;
+            }
+            REQUIRE((surface.Evaluate(u, v) - centroid).norm() <= coarsest.ChordTolerance / 16);
+        }
+
+        cache.Get(other, 1e-1);
+        REQUIRE(cache.EntryCount() == 3);
+        cache.Invalidate(surface);
+        REQUIRE(cache.EntryCount() == 1);
+        cache.Get(surface, 1e-2);
+        REQUIRE(cache.RefineCount() == 1);
+        REQUIRE(cache.MissCount() == 4);
+    }
+
+    SECTION("Least recently used levels are evicted over budget")
+    {
+        TessellationCache unlimited(coarsest, size_t(1) << 30);
+        unlimited.Get(surface, 1e-1);
+        const size_t one_entry = unlimited.MemoryUsage();
+        unlimited.Get(other, 1e-1);
+        const size_t two_entries = unlimited.MemoryUsage();
+
+        TessellationCache cache(coarsest, two_entries);
+        cache.Get(surface, 1e-1);
+        cache.Get(other, 1e-1);
+        REQUIRE(cache.EntryCount() == 2);
+        REQUIRE(cache.MemoryUsage() == two_entries);
+
+        // surface is the most recent, so other goes first
+        Surface third = MakeWavySurface(6, 2.5);
+        cache.Get(surface, 1e-1);
+        cache.Get(third, 1e-1);
+        REQUIRE(cache.EntryCount() == 2);
+        REQUIRE(cache.MemoryUsage() <= two_entries);
+        cache.Get(surface, 1e-1);
+        REQUIRE(cache.HitCount() == 2);
+        cache.Get(other, 1e-1);
+        REQUIRE(cache.MissCount() == 4);
+
+        // A level larger than the whole budget is still kept, alone
+        cache.Get(surface, 1e-3);
+        REQUIRE(cache.EntryCount() == 1);
+        REQUIRE(cache.MemoryUsage() > one_entry);
+
+        cache.Clear();
+        REQUIRE(cache.EntryCount() == 0);
+        REQUIRE(cache.MemoryUsage() == 0);
+    }
+}
+
+TEST_CASE("Tessellation/IncrementalTessellation", "[tessellation]")
+{
+    Surface surface = MakeWavySurface(12, 0.0);
+    Surface::TessellationOptions options;
+    options.ChordTolerance = 1e-3;
+    IncrementalTessellation incremental(surface, options);
+    REQUIRE(incremental.Update() == 0);
+
+    auto require_fresh = [&]()
+    {
+        TriangleMesh expected;
+        surface.Tessellate(options, expected);
+        const TriangleMesh& mesh = incremental.Mesh();
+        REQUIRE(mesh.VertexCount() == expected.VertexCount());
+        REQUIRE(mesh.Indices == expected.Indices);
+        REQUIRE(mesh.UVs == expected.UVs);
+        for (int i = 0; i < mesh.VertexCount(); ++i)
+        {
+            REQUIRE((mesh.Position(i) - expected.Position(i)).norm() < 1e-12);
+            REQUIRE((mesh.Normal(i) - expected.Normal(i)).norm() < 1e-12);
+        }
+        BoundingBox box = incremental.GetBoundingBox();
+        for (int i = 0; i < mesh.VertexCount(); ++i)
+        {
+            REQUIRE((mesh.Position(i).array() >= box.Min.array() - 1e-12).all());
+            REQUIRE((mesh.Position(i).array() <= box.Max.array() + 1e-12).all());
+        }
+    };
+
+    SECTION("A dragged control point updates its support only")
+    {
+        surface.ControlPoints.Edit(5, 6).z() += 2.0;
+        surface.ControlPoints.Edit(5, 6).w() = 1.5;
+        const int updated = incremental.Update();
+        REQUIRE(updated > 0);
+        REQUIRE(updated <= (3 + 1) * (2 + 1));
+        REQUIRE(updated < incremental.PatchCount());
+        REQUIRE(surface.ControlPoints.DirtyRegion().IsEmpty());
+        require_fresh();
+        REQUIRE(incremental.GetBoundingBox().Max.z() > 1.0);
+
+        surface.ControlPoints.Set(0, 0, Vec4{0, 0, -3, 1});
+        REQUIRE(incremental.Update() == 1);
+        require_fresh();
+        REQUIRE(incremental.GetBoundingBox().Min.z() == Approx(-3.0));
+    }
+
+    SECTION("Structural changes tessellate everything")
+    {
+        surface = surface.InsertKnotU(0.55);
+        surface.ControlPoints.Edit(3, 3).z() = 1.0;
+        const int updated = incremental.Update();
+        REQUIRE(updated == incremental.PatchCount());
+        require_fresh();
+    }
+}
+
+TEST_CASE("Tessellation/PlaneSlicing", "[tessellation]")
+{
+    SECTION("Curve slices match sampled sign changes")
+    {
+        Curve curve = MakeWavyCurve(12, 0.4);
+        curve.ControlPoints[5].w() = 2.0;
+        vector<Numeric> levels;
+        for (int k = 0; k < 15; ++k) levels.push_back(-0.85 + 0.12 * k);
+        SliceOptions options;
+        options.Normal = {0, 1, 0};
+        options.ThreadCount = 2;
+        const auto slices = SliceCurve(curve, levels, options);
+        REQUIRE(slices.size() == levels.size());
+
+        vector<Numeric> heights;
+        for (int i = 0; i <= 20000; ++i) heights.push_back(curve.Evaluate(i / 20000.0).y());
+        for (size_t k = 0; k < levels.size(); ++k)
+        {
+            int changes = 0;
+            for (size_t i = 1; i < heights.size(); ++i)
+            {
+                changes += (heights[i - 1] < levels[k]) != (heights[i] < levels[k]);
+            }
+            REQUIRE(slices[k].Count() == changes);
+            for (int i = 0; i < slices[k].Count(); ++i)
+            {
+                REQUIRE(slices[k].Points[i].y() == Approx(levels[k]).margin(1e-9));
+                REQUIRE((curve.Evaluate(slices[k].Parameters[i]) - slices[k].Points[i]).norm() < 1e-12);
+                if (i > 0) REQUIRE(slices[k].Parameters[i - 1] < slices[k].Parameters[i]);
+            }
+        }
+    }
+
+    SECTION("Surface contours lie on the surface and in their plane")
+    {
+        Surface surface = MakeWavySurface(9, 0.7);
+        surface.ControlPoints.Get(4, 4).w() = 1.5;
+        vector<Numeric> levels;
+        for (int k = 0; k < 11; ++k) levels.push_back(-0.25 + 0.05 * k);
+        SliceOptions options;
+        options.ThreadCount = 1;
+        const auto slices = SliceSurface(surface, levels, options);
+        REQUIRE(slices.size() == levels.size());
+
+        auto on_boundary = [](const Eigen::Vector2<Numeric>& uv)
+        {
+            return std::min({uv.x(), uv.y(), 1 - uv.x(), 1 - uv.y()}) < 1e-12;
+        };
+        size_t contour_count = 0;
+        for (size_t k = 0; k < levels.size(); ++k)
+        {
+            for (const auto& contour : slices[k])
+            {
+                contour_count++;
+                REQUIRE(contour.Points.size() >= 2);
+                REQUIRE(contour.Parameters.size() == contour.Points.size());
+                for (size_t i = 0; i < contour.Points.size(); ++i)
+                {
+                    REQUIRE(contour.Points[i].z() == Approx(levels[k]).margin(1e-9));
+                    const auto& uv = contour.Parameters[i];
+                    REQUIRE((surface.Evaluate(uv.x(), uv.y()) - contour.Points[i]).norm() < 1e-12);
+                    // Consecutive points are close: chained through neighbouring cells
+                    if (i > 0) REQUIRE((contour.Parameters[i] - contour.Parameters[i - 1]).norm() < 0.2);
+                }
+                if (!contour.Closed)
+                {
+                    REQUIRE(on_boundary(contour.Parameters.front()));
+                    REQUIRE(on_boundary(contour.Parameters.back()));
+                }
+            }
+        }
+        REQUIRE(contour_count > levels.size());
+
+        options.ThreadCount = 4;
+        const auto parallel = SliceSurface(surface, levels, options);
+        for (size_t k = 0; k < levels.size(); ++k)
+        {
+            REQUIRE(parallel[k].size() == slices[k].size());
+            for (size_t c = 0; c < slices[k].size(); ++c)
+            {
+                REQUIRE(parallel[k][c].Points == slices[k][c].Points);
+                REQUIRE(parallel[k][c].Closed == slices[k][c].Closed);
+            }
+        }
+    }
+
+    SECTION("A dome is cut into closed loops")
+    {
+        GeomRect rect = GeomRect::Make({0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 0});
+        rect.DegreeU = 3;
+        rect.DegreeV = 3;
+        rect.ControlPointCountU = 7;
+        rect.ControlPointCountV = 7;
+        Surface surface = rect.GetSurface();
+        for (int j = 0; j < 7; ++j)
+        {
+            for (int i = 0; i < 7; ++i)
+            {
+                surface.ControlPoints.Get(i, j).z() = std::sin(std::numbers::pi * i / 6) * std::sin(std::numbers::pi * j / 6);
+            }
+        }
+        const Numeric top = surface.Evaluate(0.5, 0.5).z();
+        const vector<Numeric> levels{0.1 * top, 0.5 * top, 0.9 * top, 1.5 * top};
+        const auto slices = SliceSurface(surface, levels);
+        for (int k = 0; k < 3; ++k)
+        {
+            REQUIRE(slices[k].size() == 1);
+            const SliceContour& loop = slices[k][0];
+            REQUIRE(loop.Closed);
+            REQUIRE(loop.Points.size() >= 8);
+            REQUIRE(loop.Points.front() != loop.Points.back());
+            // Oriented with the higher side on the left: counterclockwise around the top in (u, v)
+            Numeric area = 0;
+            for (size_t i = 0; i < loop.Parameters.size(); ++i)
+            {
+                const auto& a = loop.Parameters[i];
+                const auto& b = loop.Parameters[(i + 1) % loop.Parameters.size()];
+                area += a.x() * b.y() - a.y() * b.x();
+            }
+            REQUIRE(area > 0);
+        }
+        REQUIRE(slices[3].empty());
+    }
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <libnurbs/Utils/ThreadPool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace libnurbs::Utils;
+using namespace std;
+
+TEST_CASE("Utils/ThreadPool", "[thread_pool]")
+{
+    ThreadPool pool(4);
+    REQUIRE(pool.ThreadCount() == 4);
+
+    SECTION("Tasks spawning tasks")
+    {
+        atomic<int> count{0};
+        vector<atomic<int>> workers(pool.ThreadCount());
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.Submit([&](int worker)
+            {
+                workers[worker]++;
+                for (int k = 0; k < 10; ++k)
+                {
+                    pool.Submit([&](int) { count++; });
+                }
+            });
+        }
+        pool.Wait();
+        REQUIRE(count == 1000);
+        int total = 0;
+        for (auto& worker : workers) total += worker;
+        REQUIRE(total == 100);
+    }
+
+    SECTION("Exceptions reach Wait")
+    {
+        atomic<int> count{0};
+        for (int i = 0; i < 10; ++i)
+        {
+            pool.Submit([&, i](int)
+            {
+                count++;
+                if (i == 3) throw runtime_error("task failed");
+            });
+        }
+        REQUIRE_THROWS_AS(pool.Wait(), runtime_error);
+        REQUIRE(count == 10);
+
+        // The pool stays usable
+        pool.Submit([&](int) { count++; });
+        pool.Wait();
+        REQUIRE(count == 11);
+    }
+}
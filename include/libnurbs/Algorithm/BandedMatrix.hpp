@@ -0,0 +1,84 @@
+#pragma once
+
+#include <libnurbs/Core/Typedefs.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Square matrix whose entries (i, j) vanish outside -Lower <= j - i <= Upper, stored row by
+     *        row as the Lower + Upper + 1 diagonals, and factorized in place in O(n * Lower * Upper).
+     *        B-spline collocation matrices are totally positive and their normal equations symmetric
+     *        positive definite, so neither factorization pivots.
+     */
+    class BandedMatrix
+    {
+    public:
+        BandedMatrix() = default;
+
+        BandedMatrix(int size, int lower, int upper)
+            : m_Size(size),
+              m_Lower(lower),
+              m_Upper(upper),
+              m_Values(Storage::Zero(size, lower + upper + 1))
+        {
+        }
+
+        [[nodiscard]] int Size() const
+        {
+            return m_Size;
+        }
+
+        [[nodiscard]] int Lower() const
+        {
+            return m_Lower;
+        }
+
+        [[nodiscard]] int Upper() const
+        {
+            return m_Upper;
+        }
+
+        // Entry (row, column), which must lie inside the band
+        Numeric& operator()(int row, int column)
+        {
+            return m_Values(row, column - row + m_Lower);
+        }
+
+        const Numeric& operator()(int row, int column) const
+        {
+            return m_Values(row, column - row + m_Lower);
+        }
+
+        /**
+         * @brief Doolittle LU without pivoting, L below the diagonal with unit diagonal and U above.
+         * @return false on a zero pivot, the matrix is then left partially factorized.
+         */
+        bool FactorizeLU();
+
+        /**
+         * @brief Solves A X = B for every column of rhs, in place, after FactorizeLU.
+         */
+        void SolveLU(MatX& rhs) const;
+
+        /**
+         * @brief Cholesky A = L L^T of a symmetric positive definite matrix, from and into the lower band.
+         *        Only the entries on and below the diagonal are read, so Upper may be 0.
+         * @return false if A is not positive definite.
+         */
+        bool FactorizeCholesky();
+
+        /**
+         * @brief Solves A X = B for every column of rhs, in place, after FactorizeCholesky.
+         */
+        void SolveCholesky(MatX& rhs) const;
+
+    private:
+        // One row per matrix row, so the band of a row is contiguous for the sweeps
+        using Storage = Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+        int m_Size{0};
+        int m_Lower{0};
+        int m_Upper{0};
+        Storage m_Values{};
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "libnurbs/Core/Typedefs.hpp"
+
+namespace libnurbs
+{
+    /**
+     * @brief Highest polynomial degree handled by the Bernstein utilities, their buffers live on the stack.
+     */
+    constexpr int MAX_BERNSTEIN_DEGREE{63};
+
+    /**
+     * @brief Coefficients of the product of two polynomials in Bernstein form on [0, 1].
+     * @param result Receives a.size() + b.size() - 1 coefficients.
+     */
+    void BernsteinMultiply(std::span<const Numeric> a, std::span<const Numeric> b, std::span<Numeric> result);
+
+    /**
+     * @brief Evaluates a polynomial in Bernstein form on [0, 1] by de Casteljau's algorithm.
+     */
+    Numeric BernsteinEvaluate(std::span<const Numeric> coefficients, Numeric t);
+
+    /**
+     * @brief Roots of a polynomial in Bernstein form on [0, 1], appended to roots in ascending order.
+     *        Intervals are subdivided until their coefficients show at most one sign change
+     *        (variation diminishing property), single roots are then polished by regula falsi.
+     *        Roots closer together than tolerance may be reported once.
+     */
+    void FindBernsteinRoots(std::span<const Numeric> coefficients, Numeric tolerance, std::vector<Numeric>& roots);
+
+    /**
+     * @brief FindBernsteinRoots into a fixed buffer, without allocating. A nonzero polynomial has at most
+     *        coefficients.size() - 1 roots; roots beyond the size of the buffer are dropped.
+     * @return Number of roots written to the front of roots.
+     */
+    int FindBernsteinRoots(std::span<const Numeric> coefficients, Numeric tolerance, std::span<Numeric> roots);
+}
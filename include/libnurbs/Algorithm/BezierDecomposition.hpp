@@ -0,0 +1,93 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "libnurbs/Core/Typedefs.hpp"
+
+namespace libnurbs
+{
+    class KnotVector;
+
+    template <typename T>
+    class Grid;
+
+    /**
+     * @brief Splits a B-spline curve into Bezier segments by knot insertion, see The NURBS Book A5.6.
+     *        Points are blended linearly, pass homogeneous coordinates (ToHomo) for rational curves.
+     * @param bezier_points Receives degree + 1 points per segment, segments stored back to back.
+     * @param breakpoints Receives segment count + 1 distinct knot values bounding the segments.
+     * @return Number of segments.
+     */
+    int DecomposeCurve(int degree,
+                       const KnotVector& knot_vector,
+                       std::span<const Vec4> points,
+                       std::vector<Vec4>& bezier_points,
+                       std::vector<Numeric>& breakpoints);
+
+    /**
+     * @brief Splits a B-spline surface into Bezier patches, see The NURBS Book A5.7.
+     *        Rows are decomposed in u first, then the resulting columns in v.
+     * @param patch_points Receives (degree_u + 1) * (degree_v + 1) points per patch, u running fastest
+     *                     inside a patch. Patch (a, b) starts at index (b * patch count in u + a).
+     * @param breakpoints_u Receives patch count in u + 1 distinct knot values.
+     * @param breakpoints_v Receives patch count in v + 1 distinct knot values.
+     */
+    void DecomposeSurface(int degree_u,
+                          int degree_v,
+                          const KnotVector& knot_vector_u,
+                          const KnotVector& knot_vector_v,
+                          const Grid<Vec4>& points,
+                          std::vector<Vec4>& patch_points,
+                          std::vector<Numeric>& breakpoints_u,
+                          std::vector<Numeric>& breakpoints_v);
+
+    /**
+     * @brief Bezier points of a single patch, computed as blossoms of the (degree_u + 1) x (degree_v + 1)
+     *        control points it depends on. Suited for refreshing a few patches after local edits.
+     *        Points are blended linearly, pass homogeneous coordinates for rational surfaces.
+     * @param span_u Non-empty knot span of the patch in u, likewise span_v.
+     * @param local_points Control points (span_u - degree_u .. span_u) x (span_v - degree_v .. span_v).
+     * @param patch Receives the points in the layout of DecomposeSurface.
+     */
+    void ExtractBezierPatch(int degree_u,
+                            int degree_v,
+                            const KnotVector& knot_vector_u,
+                            const KnotVector& knot_vector_v,
+                            int span_u,
+                            int span_v,
+                            const Grid<Vec4>& local_points,
+                            Vec4* patch);
+
+    /**
+     * @brief Restricts Bezier points to the parameter range [s0, s1] in place by de Casteljau's algorithm:
+     *        the left part at s1 first, then the right part of that at s0 / s1.
+     * @param stride Distance between consecutive points, e.g. to restrict one row of a patch.
+     */
+    template <typename Point>
+    void RestrictBezier(Point* points, int degree, int stride, Numeric s0, Numeric s1)
+    {
+        auto at = [&](int i) -> Point& { return points[i * stride]; };
+        if (s1 < 1)
+        {
+            for (int r = 1; r <= degree; ++r)
+            {
+                for (int i = degree; i >= r; --i)
+                {
+                    at(i) = (1 - s1) * at(i - 1) + s1 * at(i);
+                }
+            }
+        }
+        if (s0 > 0)
+        {
+            const Numeric t = s0 / s1;
+            for (int r = 1; r <= degree; ++r)
+            {
+                for (int i = 0; i <= degree - r; ++i)
+                {
+                    at(i) = (1 - t) * at(i) + t * at(i + 1);
+                }
+            }
+        }
+    }
+}
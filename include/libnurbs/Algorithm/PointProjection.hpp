@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "libnurbs/Core/BoundingBox.hpp"
+#include "libnurbs/Curve/Curve.hpp"
+#include "libnurbs/Surface/Surface.hpp"
+#include "libnurbs/Surface/SurfaceBvh.hpp"
+
+namespace libnurbs
+{
+    /**
+     * @brief Coarse samples used to seed local point projection.
+     *        Samples are grouped per non-empty knot span, SamplesPerSpan each. Every span keeps
+     *        the bounding box of the control points it depends on, which encloses that piece of geometry.
+     *        ParametersV stays empty for curves.
+     */
+    struct ProjectionSeeds
+    {
+        int SamplesPerSpan{0};
+        std::vector<BoundingBox> SpanBoxes{};
+        std::vector<Vec3> Points{};
+        std::vector<Numeric> ParametersU{};
+        std::vector<Numeric> ParametersV{};
+    };
+
+    /**
+     * @param samples_per_span Samples per non-empty knot span (per direction for surfaces).
+     */
+    ProjectionSeeds BuildProjectionSeeds(const Curve& curve, int samples_per_span);
+
+    ProjectionSeeds BuildProjectionSeeds(const Surface& surface, int samples_per_span);
+
+    /**
+     * @brief Index of the seed closest to point.
+     *        Spans whose bounding box is farther away than the best seed found so far are skipped.
+     */
+    int FindNearestSeed(const ProjectionSeeds& seeds, const Vec3& point);
+
+    /**
+     * @brief Index of the seed closest to point, with spans visited through the patch BVH of the surface
+     *        the seeds were built from (patch k is span k). Only spans near point are touched.
+     */
+    int FindNearestSeed(const ProjectionSeeds& seeds, const SurfaceBvh& bvh, const Vec3& point);
+
+    /**
+     * @brief Iteration budget of RefineProjection from a coherent guess, such as the previous query of a
+     *        projector. Newton converges in a few steps from there, more means the stream jumped.
+     */
+    constexpr int LOCAL_ITERATION_COUNT{8};
+
+    /**
+     * @brief Refines u with Newton iterations on f(u) = C'(u)·(C(u) - P) = 0, see The NURBS Book 6.1.
+     * @param index_span Span cursor, in: span of a nearby parameter or INVALID_INDEX, out: span of u.
+     * @param closest Receives C(u) at the final parameter.
+     * @return Whether point coincidence, zero cosine or a vanishing step was reached.
+     */
+    bool RefineProjection(const Curve& curve, const Vec3& point, Numeric& u, int& index_span, Vec3& closest,
+                          Curve::EvaluationScratch& scratch, Numeric epsilon, int max_iteration_count);
+
+    /**
+     * @brief Refines (u, v) with Newton iterations on the surface counterpart of the curve equation.
+     */
+    bool RefineProjection(const Surface& surface, const Vec3& point, Numeric& u, Numeric& v,
+                          int& index_span_u, int& index_span_v, Vec3& closest,
+                          Surface::EvaluationScratch& scratch, Numeric epsilon, int max_iteration_count);
+}
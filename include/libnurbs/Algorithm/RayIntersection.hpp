@@ -0,0 +1,52 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "libnurbs/Surface/Surface.hpp"
+#include "libnurbs/Surface/SurfaceBvh.hpp"
+
+namespace libnurbs
+{
+    /**
+     * @brief Working memory of ray intersection, one per thread.
+     */
+    struct RayIntersectionScratch
+    {
+        Surface::EvaluationScratch Evaluation{};
+        // Bezier clipping pieces, stacked depth first
+        std::vector<Eigen::Vector2<Numeric>> Coefficients{};
+    };
+
+    /**
+     * @brief Nearest intersection of the ray origin + t * direction, t in [0, t_max], with one Bezier patch.
+     *        The patch is projected onto two planes through the ray, which turns the intersection into
+     *        the common root of two polynomial Bezier functions. Bezier clipping (Nishita, Sederberg and
+     *        Kakimoto 1990) cuts the parameter box down to that root with the convex hull of the
+     *        projected control points, halving where a clip gains less than 20 percent. The remaining
+     *        boxes are finished by Newton iterations on S(u, v) - origin - t * direction.
+     * @param hit Receives the intersection if one nearer than t_max is found.
+     * @param epsilon Residual at which Newton stops, relative to the bounding box diagonal of the patch.
+     * @return Whether hit was updated.
+     */
+    bool IntersectRayPatch(const Surface& surface, const SurfaceBvh& bvh, int patch,
+                           const Vec3& origin, const Vec3& direction, Numeric t_max,
+                           Surface::RayHit& hit, RayIntersectionScratch& scratch, Numeric epsilon);
+
+    /**
+     * @brief Nearest intersection of the ray with the surface, patches are visited nearest box first
+     *        and skipped once they lie beyond the nearest hit.
+     */
+    Surface::RayHit IntersectRay(const Surface& surface, const SurfaceBvh& bvh,
+                                 const Vec3& origin, const Vec3& direction, Numeric t_max,
+                                 RayIntersectionScratch& scratch, Numeric epsilon);
+
+    /**
+     * @brief Nearest intersections of a packet of up to SurfaceBvh::MAX_PACKET_SIZE rays, which share
+     *        one BVH traversal.
+     * @param hits Receives one result per ray.
+     */
+    void IntersectRayPacket(const Surface& surface, const SurfaceBvh& bvh,
+                            std::span<const Vec3> origins, std::span<const Vec3> directions,
+                            std::span<Surface::RayHit> hits, RayIntersectionScratch& scratch, Numeric epsilon);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <span>
+
+#include <Eigen/Sparse>
+
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+namespace libnurbs
+{
+    // Compressed sparse rows
+    using SparseMatrix = Eigen::SparseMatrix<Numeric, Eigen::RowMajor, int>;
+
+    /**
+     * @brief Collocation matrix of a curve at the sample parameters: row k holds the basis functions
+     *        at parameters[k], one column per control point, so that it maps control points to sample
+     *        points and is the Jacobian dC/dP of the samples with respect to the control points.
+     *        For rational curves the entries are the rational bases N_i w_i / W, i.e. the Jacobian with
+     *        respect to the Cartesian control points at fixed weights.
+     *        Every row has exactly Degree + 1 entries, so the compressed storage is allocated once from
+     *        the span structure and rows are filled in parallel, each evaluating its basis straight
+     *        into the matrix; entries that vanish at knots are stored as explicit zeros.
+     *        Knot spans are searched from the span of the previous sample, so sorted samples are fastest.
+     * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+     */
+    SparseMatrix CollocationMatrix(const Curve& curve, std::span<const Numeric> parameters, int thread_count = 0);
+
+    /**
+     * @brief Same as above for a surface at the sample parameters (u, v). Rows have
+     *        (DegreeU + 1) * (DegreeV + 1) entries, column j * UCount + i is control point Get(i, j),
+     *        the order of ControlPoints.Values.
+     */
+    SparseMatrix CollocationMatrix(const Surface& surface, std::span<const Eigen::Vector2<Numeric>> parameters,
+                                   int thread_count = 0);
+}
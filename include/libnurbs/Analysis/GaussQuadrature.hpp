@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include <libnurbs/Core/KnotVector.hpp>
+#include <libnurbs/Core/Typedefs.hpp>
+
+namespace libnurbs
+{
+    constexpr int MAX_QUADRATURE_POINT_COUNT{64};
+
+    /**
+     * @brief Nodes and weights of a quadrature rule on [-1, 1], nodes ascending.
+     */
+    struct QuadratureRule
+    {
+        std::vector<Numeric> Nodes{};
+        std::vector<Numeric> Weights{};
+
+        [[nodiscard]] int Count() const
+        {
+            return static_cast<int>(Nodes.size());
+        }
+    };
+
+    /**
+     * @brief Gauss-Legendre rule with point_count nodes, exact for polynomials up to degree 2 point_count - 1.
+     *        All rules up to MAX_QUADRATURE_POINT_COUNT are computed once, on first use, and shared
+     *        between threads.
+     */
+    const QuadratureRule& GaussLegendre(int point_count);
+
+    /**
+     * @brief Gauss-Legendre points of every non-empty knot span, mapped into the span with the weights
+     *        scaled by its length, so that the sum of f(Points) * Weights over a span integrates f on it,
+     *        together with the non-zero basis functions and their derivatives at the points.
+     *        Points and weights of span k lie at [k * PointCount, (k + 1) * PointCount).
+     */
+    struct SpanQuadrature
+    {
+        int Degree{INVALID_DEGREE};
+        int Order{0};
+        int PointCount{0};
+        // Knot span index of each non-empty span, ascending
+        std::vector<int> Spans{};
+        std::vector<Numeric> Points{};
+        std::vector<Numeric> Weights{};
+        // Derivatives 0..Order of the Degree + 1 basis functions non-zero at each point, see Basis()
+        std::vector<Numeric> BasisValues{};
+
+        SpanQuadrature() = default;
+
+        /**
+         * @param order Highest basis derivative to cache.
+         */
+        SpanQuadrature(const KnotVector& knots, int degree, int point_count, int order = 0);
+
+        [[nodiscard]] int SpanCount() const
+        {
+            return static_cast<int>(Spans.size());
+        }
+
+        /**
+         * @brief k-th derivatives at point q of the basis functions Spans[q / PointCount] - Degree + r,
+         *        r = 0..Degree.
+         */
+        [[nodiscard]] const Numeric* Basis(int q, int k = 0) const
+        {
+            return BasisValues.data() + (static_cast<size_t>(q) * (Order + 1) + k) * (Degree + 1);
+        }
+    };
+}
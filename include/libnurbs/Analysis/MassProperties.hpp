@@ -0,0 +1,44 @@
+#pragma once
+
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+namespace libnurbs
+{
+    struct IntegrationOptions
+    {
+        // Gauss-Legendre points per knot span and direction, 0 means twice the degree
+        int PointCount{0};
+        // Knot spans (curves) or elements (surfaces) are integrated in parallel, values <= 0 mean hardware concurrency
+        int ThreadCount{0};
+    };
+
+    /**
+     * @brief Mass properties at unit density per length (curves) or per area (surfaces).
+     */
+    struct MassProperties
+    {
+        // Length of a curve, area of a surface
+        Numeric Measure{0};
+        Vec3 Centroid = Vec3::Zero();
+        // Inertia tensor about the centroid
+        Mat3x3 Inertia = Mat3x3::Zero();
+    };
+
+    /**
+     * @brief Length, centroid and inertia of a curve by Gauss-Legendre quadrature on every knot span.
+     *        Points are evaluated from the basis values cached once per span point, see SpanQuadrature.
+     *        The default rule is exact for straight polynomial curves, curved and rational ones
+     *        converge with PointCount. Each span sums its own moments about a common reference point,
+     *        the spans are then added in order, so the result does not depend on the thread count.
+     */
+    MassProperties ComputeMassProperties(const Curve& curve, const IntegrationOptions& options = {});
+
+    /**
+     * @brief Area, centroid and inertia of a surface, as above on the tensor product rule of every
+     *        element KnotsU span × KnotsV span. The control points of an element are contracted with the
+     *        cached v basis once per v point and then with the u basis per point (sum factorization).
+     *        Exact by default for planar polynomial surfaces.
+     */
+    MassProperties ComputeMassProperties(const Surface& surface, const IntegrationOptions& options = {});
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <libnurbs/Analysis/GaussQuadrature.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Utils/Parallel.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Isogeometric elements of a surface: one per non-empty KnotsU span × KnotsV span, with the
+     *        rational basis functions non-zero there evaluated once at its Gauss points, for assembly
+     *        passes that would otherwise evaluate the same bases again for every element and solve.
+     *        Per point the cache holds position, Jacobian [Su Sv] and integration weight times area
+     *        element; per point and function the value R and the surface gradient J (J^T J)^-1 (Ru, Rv),
+     *        from which J^T recovers the parameter derivatives. The arrays are contiguous per element,
+     *        element by element, with u running fastest, and are built in parallel per element.
+     *        Local function f = s * (DegreeU + 1) + r belongs to control point Get(first_u + r, first_v + s).
+     */
+    class SurfaceElements
+    {
+    public:
+        using Jacobian = Eigen::Matrix<Numeric, 3, 2>;
+
+        /**
+         * @param point_count Gauss points per direction, values <= 0 mean degree + 1 in each.
+         * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+         */
+        explicit SurfaceElements(const Surface& surface, int point_count = 0, int thread_count = 0);
+
+        /**
+         * @brief Recomputes geometry and rational bases after the control points changed.
+         *        Degrees and knot vectors must be those of construction, the B-spline bases are kept.
+         */
+        void Update(const Surface& surface, int thread_count = 0);
+
+        [[nodiscard]] int ElementCount() const
+        {
+            return static_cast<int>(m_Spans.size());
+        }
+
+        // Gauss points per element
+        [[nodiscard]] int PointCount() const
+        {
+            return m_QuadratureU.PointCount * m_QuadratureV.PointCount;
+        }
+
+        // Non-zero basis functions per element
+        [[nodiscard]] int FunctionCount() const
+        {
+            return (m_QuadratureU.Degree + 1) * (m_QuadratureV.Degree + 1);
+        }
+
+        // Knot span indices (u, v) of the element
+        [[nodiscard]] std::pair<int, int> Spans(int element) const
+        {
+            return m_Spans[element];
+        }
+
+        // Indices into ControlPoints.Values of the local functions
+        [[nodiscard]] std::span<const int> Functions(int element) const
+        {
+            return {m_Functions.data() + static_cast<size_t>(element) * FunctionCount(), static_cast<size_t>(FunctionCount())};
+        }
+
+        // Surface parameters (u, v) of the Gauss points
+        [[nodiscard]] std::span<const Eigen::Vector2<Numeric>> Parameters(int element) const
+        {
+            return {m_Parameters.data() + PointOffset(element), static_cast<size_t>(PointCount())};
+        }
+
+        [[nodiscard]] std::span<const Vec3> Points(int element) const
+        {
+            return {m_Points.data() + PointOffset(element), static_cast<size_t>(PointCount())};
+        }
+
+        [[nodiscard]] std::span<const Jacobian> Jacobians(int element) const
+        {
+            return {m_Jacobians.data() + PointOffset(element), static_cast<size_t>(PointCount())};
+        }
+
+        // Gauss weight times |Su × Sv|, the integral over the element is the sum of f * Measures
+        [[nodiscard]] std::span<const Numeric> Measures(int element) const
+        {
+            return {m_Measures.data() + PointOffset(element), static_cast<size_t>(PointCount())};
+        }
+
+        // Rational basis values at one Gauss point, FunctionCount() of them
+        [[nodiscard]] std::span<const Numeric> Values(int element, int point) const
+        {
+            return {m_Values.data() + FunctionOffset(element, point), static_cast<size_t>(FunctionCount())};
+        }
+
+        // Surface gradients of the rational bases at one Gauss point
+        [[nodiscard]] std::span<const Vec3> Gradients(int element, int point) const
+        {
+            return {m_Gradients.data() + FunctionOffset(element, point), static_cast<size_t>(FunctionCount())};
+        }
+
+        /**
+         * @brief Calls func(element, worker) for every element on thread_count workers, see Utils::ParallelFor.
+         */
+        template <typename Func>
+        void ForEachElement(Func&& func, int thread_count = 0) const
+        {
+            const int count = ElementCount();
+            Utils::ParallelFor(count, Utils::ResolveThreadCount(thread_count, count), std::forward<Func>(func), 4);
+        }
+
+    private:
+        [[nodiscard]] size_t PointOffset(int element) const
+        {
+            return static_cast<size_t>(element) * PointCount();
+        }
+
+        [[nodiscard]] size_t FunctionOffset(int element, int point) const
+        {
+            return (PointOffset(element) + point) * FunctionCount();
+        }
+
+        void Evaluate(const Surface& surface, int element);
+
+        SpanQuadrature m_QuadratureU{};
+        SpanQuadrature m_QuadratureV{};
+        std::vector<std::pair<int, int>> m_Spans{};
+        std::vector<int> m_Functions{};
+        std::vector<Eigen::Vector2<Numeric>> m_Parameters{};
+        std::vector<Vec3> m_Points{};
+        std::vector<Jacobian> m_Jacobians{};
+        std::vector<Numeric> m_Measures{};
+        std::vector<Numeric> m_Values{};
+        std::vector<Vec3> m_Gradients{};
+    };
+}
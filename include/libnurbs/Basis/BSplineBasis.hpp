@@ -11,10 +11,28 @@ namespace libnurbs
 
     struct BSplineBasis
     {
+        /**
+         * @brief Working memory of EvaluateAll, reused between calls to avoid heap allocations in hot loops.
+         */
+        struct Scratch
+        {
+            MatX Ndu{};
+            MatX A{};
+            VecX Left{};
+            VecX Right{};
+        };
+
         static VecX Evaluate(int degree, const KnotVector& knot_vec, Numeric x);
 
         static VecX Evaluate(int degree, const vector<Numeric>& knots, int index_span, Numeric x);
 
+        /**
+         * @brief Same as Evaluate, but writes the degree + 1 values to result
+         *        and only allocates when scratch is smaller than required.
+         */
+        static void Evaluate(int degree, const vector<Numeric>& knots, int index_span, Numeric x,
+                             Numeric* result, Scratch& scratch);
+
         static VecX EvaluateDerivative(int degree, const KnotVector& knot_vec, Numeric x, int order = 1);
 
         static VecX EvaluateDerivative(int degree, const std::vector<Numeric>& knots, int index_span, Numeric x, int order);
@@ -23,5 +41,12 @@ namespace libnurbs
 
         static MatX EvaluateAll(int degree, const std::vector<Numeric>& knots, int index_span, Numeric x, int order);
 
+        /**
+         * @brief Same as EvaluateAll, but writes into result and only allocates
+         *        when result or scratch are smaller than required.
+         */
+        static void EvaluateAll(int degree, const std::vector<Numeric>& knots, int index_span, Numeric x, int order,
+                                MatX& result, Scratch& scratch);
+
     };
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include <utility>
+
 #include "Typedefs.hpp"
 
 namespace libnurbs
@@ -23,7 +25,7 @@ namespace libnurbs
         void ExpandToInclude(const Vec3& point)
         {
             Min = Min.cwiseMin(point);
-            Max = Min.cwiseMax(point);
+            Max = Max.cwiseMax(point);
         }
 
         void ExpandToInclude(const BoundingBox& box)
@@ -43,6 +45,42 @@ namespace libnurbs
             return Contains(box.Min) && Contains(box.Max);
         }
 
+        bool Intersects(const BoundingBox& box) const
+        {
+            return (Min.array() <= box.Max.array()).all() &&
+                   (box.Min.array() <= Max.array()).all();
+        }
+
+        /**
+         * @brief Slab test of the ray origin + t * direction, t in [t_min, t_max], against the box.
+         * @param inverse_direction Componentwise 1 / direction, infinities for zero components are fine.
+         * @param t_enter Receives the parameter where the ray enters the box, clamped to t_min.
+         */
+        bool IntersectRay(const Vec3& origin, const Vec3& inverse_direction, Numeric t_min, Numeric t_max,
+                          Numeric& t_enter) const
+        {
+            for (int d = 0; d < 3; ++d)
+            {
+                Numeric t0 = (Min[d] - origin[d]) * inverse_direction[d];
+                Numeric t1 = (Max[d] - origin[d]) * inverse_direction[d];
+                if (t0 > t1) std::swap(t0, t1);
+                // NaN from 0 * inf (origin on a slab plane of a parallel ray) leaves the bounds untouched.
+                t_min = t0 > t_min ? t0 : t_min;
+                t_max = t1 < t_max ? t1 : t_max;
+                if (t_min > t_max) return false;
+            }
+            t_enter = t_min;
+            return true;
+        }
+
+        /**
+         * @brief Squared distance from point to the box, zero if the point is inside.
+         */
+        Numeric SquaredDistance(const Vec3& point) const
+        {
+            return (Min - point).cwiseMax(point - Max).cwiseMax(Numeric(0)).squaredNorm();
+        }
+
         Vec3 Center() const
         {
             return (Min + Max) * 0.5;
@@ -58,5 +96,11 @@ namespace libnurbs
             Vec3 length = Length();
             return length.prod();
         }
+
+        Numeric SurfaceArea() const
+        {
+            Vec3 length = Length();
+            return 2 * (length.x() * length.y() + length.y() * length.z() + length.z() * length.x());
+        }
     };
 }
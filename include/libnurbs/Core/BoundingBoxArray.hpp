@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BoundingBox.hpp"
+
+namespace libnurbs
+{
+    /**
+     * @brief Boxes stored as structure of arrays, one coordinate array per bound, for testing one
+     *        query against many boxes. Tests run PACK_SIZE boxes at a time in SIMD registers (AVX, else
+     *        SSE2, else scalar lanes) and report their outcome as bit masks: bit k stands for box start + k.
+     *        Storage is padded by a pack of empty boxes, so a pack starting at any box stays in bounds.
+     */
+    class BoundingBoxArray
+    {
+    public:
+        static constexpr int PACK_SIZE = 4;
+
+        BoundingBoxArray() = default;
+
+        explicit BoundingBoxArray(const std::vector<BoundingBox>& boxes)
+        {
+            Resize(static_cast<int>(boxes.size()));
+            for (int i = 0; i < Size(); ++i)
+            {
+                Set(i, boxes[i]);
+            }
+        }
+
+        [[nodiscard]] int Size() const
+        {
+            return m_Size;
+        }
+
+        void Resize(int size)
+        {
+            m_Size = size;
+            const size_t padded = size + PACK_SIZE - 1;
+            for (int d = 0; d < 3; ++d)
+            {
+                m_Min[d].assign(padded, std::numeric_limits<Numeric>::infinity());
+                m_Max[d].assign(padded, -std::numeric_limits<Numeric>::infinity());
+            }
+        }
+
+        void Set(int index, const BoundingBox& box)
+        {
+            for (int d = 0; d < 3; ++d)
+            {
+                m_Min[d][index] = box.Min[d];
+                m_Max[d][index] = box.Max[d];
+            }
+        }
+
+        [[nodiscard]] BoundingBox Get(int index) const
+        {
+            BoundingBox box;
+            for (int d = 0; d < 3; ++d)
+            {
+                box.Min[d] = m_Min[d][index];
+                box.Max[d] = m_Max[d][index];
+            }
+            return box;
+        }
+
+        /**
+         * @brief Boxes start .. start + count - 1 that overlap query, count <= 64.
+         */
+        [[nodiscard]] uint64_t IntersectsMask(const BoundingBox& query, int start, int count) const;
+
+        /**
+         * @brief Boxes start .. start + count - 1 that contain point, count <= 64.
+         */
+        [[nodiscard]] uint64_t ContainsMask(const Vec3& point, int start, int count) const;
+
+        /**
+         * @brief Slab test of the ray origin + t * direction, t in [t_min, t_max], against boxes
+         *        start .. start + count - 1, count <= 64, as BoundingBox::IntersectRay.
+         * @param t_enter Receives count entry parameters, meaningful for the boxes hit.
+         */
+        uint64_t IntersectRayMask(const Vec3& origin, const Vec3& inverse_direction, Numeric t_min, Numeric t_max,
+                                  int start, int count, Numeric* t_enter) const;
+
+        /**
+         * @brief Squared distances from point to boxes start .. start + count - 1, zero inside.
+         */
+        void SquaredDistances(const Vec3& point, int start, int count, Numeric* distances) const;
+
+    private:
+        int m_Size{0};
+        std::vector<Numeric> m_Min[3]{};
+        std::vector<Numeric> m_Max[3]{};
+    };
+}
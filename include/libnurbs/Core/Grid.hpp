@@ -1,10 +1,36 @@
 #pragma once
 
 #include <libnurbs/Core/Typedefs.hpp>
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace libnurbs
 {
+    /**
+     * @brief Inclusive rectangle of grid indices, empty while Min > Max.
+     */
+    struct GridRegion
+    {
+        int MinU{std::numeric_limits<int>::max()};
+        int MinV{std::numeric_limits<int>::max()};
+        int MaxU{std::numeric_limits<int>::min()};
+        int MaxV{std::numeric_limits<int>::min()};
+
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return MinU > MaxU || MinV > MaxV;
+        }
+
+        void ExpandToInclude(int index_u, int index_v)
+        {
+            MinU = std::min(MinU, index_u);
+            MinV = std::min(MinV, index_v);
+            MaxU = std::max(MaxU, index_u);
+            MaxV = std::max(MaxV, index_v);
+        }
+    };
+
     template<typename T>
     class Grid
     {
@@ -51,6 +77,35 @@ namespace libnurbs
             return Values[index_v * UCount + index_u];
         }
 
+        /**
+         * @brief Mutable access like Get that also records the cell in the dirty region.
+         *        Writes through Get or Values are not tracked.
+         */
+        T& Edit(int index_u, int index_v)
+        {
+            m_DirtyRegion.ExpandToInclude(index_u, index_v);
+            return Get(index_u, index_v);
+        }
+
+        void Set(int index_u, int index_v, const T& value)
+        {
+            Edit(index_u, index_v) = value;
+        }
+
+        /**
+         * @brief Cells edited through Edit, Set, SetU and SetV since the last ClearDirtyRegion.
+         *        Inserting rows or columns marks the whole grid.
+         */
+        [[nodiscard]] const GridRegion& DirtyRegion() const
+        {
+            return m_DirtyRegion;
+        }
+
+        void ClearDirtyRegion()
+        {
+            m_DirtyRegion = {};
+        }
+
         [[nodiscard]] std::vector<T> GetU(int index_u) const
         {
             assert(index_u < UCount);
@@ -81,6 +136,8 @@ namespace libnurbs
             {
                 Values[i * UCount + index_u] = values[i];
             }
+            m_DirtyRegion.ExpandToInclude(index_u, 0);
+            m_DirtyRegion.ExpandToInclude(index_u, VCount - 1);
         }
 
         void SetV(int index_v, const std::vector<T>& values)
@@ -91,6 +148,8 @@ namespace libnurbs
             {
                 Values[index_v * UCount + i] = values[i];
             }
+            m_DirtyRegion.ExpandToInclude(0, index_v);
+            m_DirtyRegion.ExpandToInclude(UCount - 1, index_v);
         }
 
         [[nodiscard]] int Count() const noexcept
@@ -104,6 +163,7 @@ namespace libnurbs
             auto iter = Values.begin() + v_index * UCount;
             Values.insert(iter, UCount, default_value);
             VCount += 1;
+            MarkAllDirty();
         }
 
         void InsertU(int u_index, const T& default_value = T())
@@ -129,6 +189,16 @@ namespace libnurbs
                 }
                 Values[insertion_idx] = default_value;
             }
+            MarkAllDirty();
+        }
+
+    private:
+        void MarkAllDirty()
+        {
+            m_DirtyRegion.ExpandToInclude(0, 0);
+            m_DirtyRegion.ExpandToInclude(UCount - 1, VCount - 1);
         }
+
+        GridRegion m_DirtyRegion{};
     };
 }
@@ -67,6 +67,13 @@ namespace libnurbs
          */
         [[nodiscard]] int FindSpanIndex(int degree, Numeric u) const;
 
+        /**
+         * @brief Same as FindSpanIndex, but walks from the span of a nearby parameter,
+         *        which beats the binary search when consecutive queries are coherent.
+         * @param hint Span index of a previous query, out-of-range values fall back to the binary search.
+         */
+        [[nodiscard]] int FindSpanIndex(int degree, Numeric u, int hint) const;
+
         [[nodiscard]] KnotSpan FindSpan(Numeric u) const;
 
         [[nodiscard]] int DetectDegree() const;
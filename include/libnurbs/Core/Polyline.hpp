@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+#include "Typedefs.hpp"
+
+namespace libnurbs
+{
+    /**
+     * @brief Points of a tessellated curve together with their curve parameters.
+     *        Meant to be reused across calls: Clear keeps the allocated capacity.
+     */
+    struct Polyline
+    {
+        std::vector<Numeric> Parameters{};
+        std::vector<Vec3> Points{};
+
+        void Clear()
+        {
+            Parameters.clear();
+            Points.clear();
+        }
+
+        [[nodiscard]] int Count() const
+        {
+            return static_cast<int>(Points.size());
+        }
+    };
+}
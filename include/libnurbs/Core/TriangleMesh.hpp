@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Typedefs.hpp"
+
+namespace libnurbs
+{
+    /**
+     * @brief Indexed triangle mesh in flat arrays, ready to hand to a renderer without conversion.
+     *        Positions and Normals hold xyz per vertex, UVs the surface parameters per vertex and
+     *        Indices three vertex indices per triangle, counter-clockwise around the normal.
+     *        Meant to be reused: Clear and Resize keep the allocated capacity.
+     */
+    struct TriangleMesh
+    {
+        std::vector<Numeric> Positions{};
+        std::vector<Numeric> Normals{};
+        std::vector<Numeric> UVs{};
+        std::vector<uint32_t> Indices{};
+
+        void Clear()
+        {
+            Positions.clear();
+            Normals.clear();
+            UVs.clear();
+            Indices.clear();
+        }
+
+        void Resize(int vertex_count, int triangle_count)
+        {
+            Positions.resize(3 * vertex_count);
+            Normals.resize(3 * vertex_count);
+            UVs.resize(2 * vertex_count);
+            Indices.resize(3 * triangle_count);
+        }
+
+        [[nodiscard]] int VertexCount() const
+        {
+            return static_cast<int>(Positions.size() / 3);
+        }
+
+        [[nodiscard]] int TriangleCount() const
+        {
+            return static_cast<int>(Indices.size() / 3);
+        }
+
+        void SetVertex(int index, const Vec3& position, const Vec3& normal, Numeric u, Numeric v)
+        {
+            Positions[3 * index]     = position.x();
+            Positions[3 * index + 1] = position.y();
+            Positions[3 * index + 2] = position.z();
+            Normals[3 * index]       = normal.x();
+            Normals[3 * index + 1]   = normal.y();
+            Normals[3 * index + 2]   = normal.z();
+            UVs[2 * index]           = u;
+            UVs[2 * index + 1]       = v;
+        }
+
+        [[nodiscard]] Vec3 Position(int index) const
+        {
+            return {Positions[3 * index], Positions[3 * index + 1], Positions[3 * index + 2]};
+        }
+
+        [[nodiscard]] Vec3 Normal(int index) const
+        {
+            return {Normals[3 * index], Normals[3 * index + 1], Normals[3 * index + 2]};
+        }
+
+        void SetTriangle(int index, uint32_t a, uint32_t b, uint32_t c)
+        {
+            Indices[3 * index]     = a;
+            Indices[3 * index + 1] = b;
+            Indices[3 * index + 2] = c;
+        }
+    };
+}
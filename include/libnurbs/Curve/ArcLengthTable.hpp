@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include <libnurbs/Curve/Curve.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Arc length of a curve as a function of its parameter, and the inverse, for constant speed
+     *        traversal. Every knot span is integrated by 8 point Gauss-Legendre on |C'(x)| and halved
+     *        until the halves agree with the whole to the tolerance; spans are integrated in parallel.
+     *        The resulting nodes store parameter, cumulative length and dx/ds = 1 / |C'(x)|.
+     *        ParameterAtLength finds the node interval by binary search, interpolates the parameter by a
+     *        cubic Hermite in s whose slopes are limited after Fritsch and Carlson so it stays monotone,
+     *        and polishes it by Newton on LengthAt(x) = s.
+     *        The curve is referenced, not copied: it must outlive the table and stay unchanged.
+     */
+    class ArcLengthTable
+    {
+    public:
+        /**
+         * @param tolerance Relative length error per integrated piece.
+         * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+         */
+        explicit ArcLengthTable(const Curve& curve, Numeric tolerance = 1e-10, int thread_count = 0);
+
+        [[nodiscard]] Numeric Length() const
+        {
+            return m_Lengths.back();
+        }
+
+        [[nodiscard]] int NodeCount() const
+        {
+            return static_cast<int>(m_Parameters.size());
+        }
+
+        /**
+         * @brief Arc length from the start of the curve to parameter x.
+         */
+        [[nodiscard]] Numeric LengthAt(Numeric x, Curve::EvaluationScratch& scratch) const;
+
+        [[nodiscard]] Numeric LengthAt(Numeric x) const;
+
+        /**
+         * @brief Parameter at arc length s from the start, s is clamped to [0, Length()].
+         */
+        [[nodiscard]] Numeric ParameterAtLength(Numeric s, Curve::EvaluationScratch& scratch) const;
+
+        [[nodiscard]] Numeric ParameterAtLength(Numeric s) const;
+
+    private:
+        // Length of [m_Parameters[node], x] for x inside that node interval
+        Numeric IntegrateFrom(int node, Numeric x, Curve::EvaluationScratch& scratch) const;
+
+        const Curve* m_Curve;
+        Numeric m_Tolerance;
+        std::vector<Numeric> m_Parameters{};
+        std::vector<Numeric> m_Lengths{};
+        // dx/ds at the nodes, limited for monotone interpolation
+        std::vector<Numeric> m_Slopes{};
+        // Knot span of the interval starting at each node
+        std::vector<int> m_Spans{};
+    };
+}
@@ -4,9 +4,11 @@
 #include <vector>
 #include <tuple>
 #include <string>
+#include <libnurbs/Basis/BSplineBasis.hpp>
 #include <libnurbs/Core/KnotVector.hpp>
 #include <libnurbs/Core/Typedefs.hpp>
 #include <libnurbs/Core/BoundingBox.hpp>
+#include <libnurbs/Core/Polyline.hpp>
 
 using std::vector;
 using std::string;
@@ -15,6 +17,21 @@ namespace libnurbs
 {
     class Curve
     {
+    public:
+        struct EvaluationScratch;
+        struct ProjectionResult;
+
+        /**
+         * @brief How fitting assigns curve parameters to data points.
+         */
+        enum class Parameterization
+        {
+            Uniform,
+            ChordLength,
+            // Square roots of the chord lengths, follows sharp turns more closely
+            Centripetal
+        };
+
     public:
         int Degree{INVALID_DEGREE};
         KnotVector Knots{};
@@ -31,6 +48,43 @@ namespace libnurbs
 
         void SaveToFile(std::ostream& os, bool binary_mode = false) const;
 
+        /**
+         * @brief Global interpolation (The NURBS Book, A9.1): the non-rational curve of the given degree
+         *        through all points, with one control point per point. Parameters come from the
+         *        parameterization, knots by averaging them. The collocation system then has at most
+         *        degree entries on either side of the diagonal and is totally positive, so it is solved
+         *        by a banded LU without pivoting in O(n * degree^2) time and O(n * degree) memory.
+         *        Throws std::runtime_error for fewer than degree + 1 points or coincident neighbours.
+         */
+        [[nodiscard]] static Curve Interpolate(std::span<const Vec3> points, int degree,
+                                               Parameterization parameterization = Parameterization::ChordLength);
+
+        /**
+         * @brief Weighted least squares approximation (The NURBS Book, A9.7): the non-rational curve with
+         *        control_point_count control points through the first and last point that minimizes the
+         *        weighted sum of squared distances |C(u_k) - Q_k|^2 to the others. Knots are placed so
+         *        that every span holds parameters (9.68). The basis functions of all points are evaluated
+         *        in one pass and accumulated into the banded normal equations, half bandwidth degree,
+         *        which a banded Cholesky solves in O(m * degree^2) time and O(n * degree) memory.
+         *        Throws std::runtime_error unless degree + 1 <= control_point_count <= point count.
+         * @param weights Non-negative weight per point, empty means all 1.
+         */
+        [[nodiscard]] static Curve Approximate(std::span<const Vec3> points, int degree, int control_point_count,
+                                               std::span<const Numeric> weights = {},
+                                               Parameterization parameterization = Parameterization::ChordLength);
+
+        /**
+         * @brief Adaptive variant of Approximate: starts from a single Bezier segment and, after every fit,
+         *        splits each span holding a point farther than tolerance from its curve point by a knot
+         *        strictly between the median two of its weighted points, until all points are within
+         *        tolerance or no span can be split. Splits breaking the Schoenberg-Whitney condition are
+         *        dropped, and should a refit still be singular the previous fit is returned.
+         *        Distances are measured at the fitted parameters, an upper bound of the true distance.
+         */
+        [[nodiscard]] static Curve ApproximateToTolerance(std::span<const Vec3> points, int degree, Numeric tolerance,
+                                                          std::span<const Numeric> weights = {},
+                                                          Parameterization parameterization =
+                                                              Parameterization::ChordLength);
 
         [[nodiscard]] Vec3 Evaluate(Numeric x) const;
 
@@ -38,6 +92,16 @@ namespace libnurbs
 
         [[nodiscard]] vector<Vec3> EvaluateAll(Numeric x, int order) const;
 
+        /**
+         * @brief Allocation-free variant of EvaluateAll for hot loops.
+         * @param scratch Per-thread working memory, the result lives in it until the next call.
+         * @param index_span Knot span containing x, INVALID_INDEX to look it up.
+         * @return Derivatives of order 0..order.
+         */
+        std::span<const Vec3> EvaluateAll(Numeric x, int order,
+                                          EvaluationScratch& scratch,
+                                          int index_span = INVALID_INDEX) const;
+
         [[nodiscard]] bool IsRational() const;
 
         [[nodiscard]] Numeric SearchParameter(const Vec3& point,
@@ -49,6 +113,27 @@ namespace libnurbs
                                                     Numeric epsilon         = 1e-8,
                                                     int max_iteration_count = 512) const;
 
+        /**
+         * @brief Projects a batch of points onto the curve, in parallel.
+         *        Each point is seeded from a per-span sample table and refined with Newton iterations.
+         * @param points Points to project
+         * @param epsilon Distance and cosine tolerance of the Newton iterations, default is 1e-10
+         * @param max_iteration_count Maximum Newton iterations per point, default is 32
+         * @param thread_count Number of threads, <= 0 means hardware concurrency
+         * @return One result per point, in input order.
+         */
+        [[nodiscard]] vector<ProjectionResult> ProjectPoints(std::span<const Vec3> points,
+                                                           Numeric epsilon         = 1e-10,
+                                                           int max_iteration_count = 32,
+                                                           int thread_count        = 0) const;
+
+        /**
+         * @brief Global closest point on the curve by Bezier root isolation, see CurvePointInversion.
+         *        Unlike the Newton based searches the result never gets stuck in a local minimum.
+         *        To query many points, construct a CurvePointInversion once instead.
+         */
+        [[nodiscard]] ProjectionResult ClosestPoint(const Vec3& point) const;
+
 
         [[nodiscard]] Curve InsertKnot(Numeric knot_value) const;
 
@@ -66,9 +151,65 @@ namespace libnurbs
 
         vector<Curve> ExtractBezier() const;
 
-        BoundingBox GetBoundingBox(Numeric epsilon = 1e-3) const;
+        /**
+         * @brief Adaptive polyline approximation of the curve.
+         *        Each Bezier segment is halved until its control polygon is flat: every control point
+         *        lies within chord_tolerance of the chord and every leg within angle_tolerance of its
+         *        direction. By the convex hull property the curve then deviates at most chord_tolerance
+         *        from the polyline, and its tangent at most angle_tolerance from the chord.
+         * @param chord_tolerance Maximum distance between curve and polyline
+         * @param angle_tolerance Maximum angle in radians between tangent and chord, <= 0 disables the check
+         * @param output Cleared and filled with increasing parameters and their points, both ends included.
+         */
+        void Tessellate(Numeric chord_tolerance, Numeric angle_tolerance, Polyline& output) const;
+
+        /**
+         * @brief Uniform sampling of every Bezier segment by forward differencing.
+         *        The difference table of a segment is set up once, after which each point costs
+         *        degree additions in homogeneous coordinates plus one division by the weight.
+         *        The table is built from the power form of the segment, so its entry of order j carries
+         *        rounding proportional to h^j; accumulated over n steps the drift stays within a few
+         *        hundred ulps of the control point magnitude for the usual degrees (<= 1e-12 relative
+         *        for p = 3 and 10000 samples per span). Each segment starts from a fresh table and ends
+         *        on its exact end point, so drift never carries over.
+         * @param n_per_span Intervals per non-empty knot span
+         * @param output Cleared and filled with n_per_span * span count + 1 parameters and points.
+         */
+        void SampleUniform(int n_per_span, Polyline& output) const;
+
+        /**
+         * @brief Box of the curve by recursive halving of its Bezier segments.
+         *        A piece stops splitting once its control polygon box is within epsilon or matches the box
+         *        of its end points. The result is the union of those end point boxes, at most about epsilon
+         *        inside the exact box. Segments are processed in parallel, each worker subdividing on a
+         *        fixed arena.
+         * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+         */
+        BoundingBox GetBoundingBox(Numeric epsilon = 1e-3, int thread_count = 1) const;
+
+        /**
+         * @brief Exact box of the curve. Per Bezier segment and axis, the extrema lie at the segment ends
+         *        or at roots of the hodograph (x'w - xw' for rational segments), isolated in Bernstein form.
+         */
+        BoundingBox GetExactBoundingBox(int thread_count = 1) const;
 
     private:
-        [[nodiscard]] vector<Vec4> HomogeneousDerivative(Numeric x, int order) const;
+        void HomogeneousDerivative(Numeric x, int index_span, int order, EvaluationScratch& scratch) const;
+    };
+
+    struct Curve::EvaluationScratch
+    {
+        BSplineBasis::Scratch Basis{};
+        MatX BasisDerivatives{};
+        vector<Vec4> HomogeneousDerivatives{};
+        vector<Vec3> Derivatives{};
+    };
+
+    struct Curve::ProjectionResult
+    {
+        Numeric Parameter{INVALID_VALUE};
+        Vec3 Point = Vec3::Zero();
+        Numeric Distance{INVALID_VALUE};
+        bool Converged{false};
     };
 }
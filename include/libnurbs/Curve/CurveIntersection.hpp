@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include <libnurbs/Curve/Curve.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief A point where two curves meet within tolerance.
+     */
+    struct CurveIntersection
+    {
+        Numeric ParameterA{INVALID_VALUE};
+        Numeric ParameterB{INVALID_VALUE};
+        // Point on the first curve
+        Vec3 Point = Vec3::Zero();
+        // Distance between the curves at the parameters
+        Numeric Distance{INVALID_VALUE};
+    };
+
+    /**
+     * @brief Intersections of two curves, sorted by ParameterA.
+     *        Both curves are split into Bezier segments, and segment pairs whose boxes do not overlap
+     *        are pruned. Each remaining pair is narrowed by Bezier clipping (Sederberg and Nishita 1990):
+     *        one piece is clipped against the fat region of the other, the two slabs around its chord
+     *        that bound its control points. Pieces are halved where a clip gains less than 20 percent,
+     *        which separates several intersections. Small pieces are finished by Newton on the
+     *        squared distance |A(s) - B(t)|^2, and kept if the curves come within tolerance there.
+     *        Stretches where both curves are straight and coincide are reported by their end points.
+     * @param tolerance Distance below which the curves count as meeting.
+     */
+    std::vector<CurveIntersection> Intersect(const Curve& a, const Curve& b, Numeric tolerance = 1e-9);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include <libnurbs/Core/BoundingBox.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Global closest point queries by Bezier root isolation.
+     *        The curve is split into Bezier segments once. On each segment the stationarity condition
+     *        (C(t) - P)·C'(t) = 0, multiplied by the weight powers of a rational curve, is the polynomial
+     *        S(t) - P·V(t) whose coefficients S and V are precomputed, so a query costs O(degree) per
+     *        segment to set up. All roots are isolated by subdivision, which makes the result the global
+     *        minimum regardless of curvature or self-approaching regions. Segments whose control point
+     *        bounding box lies farther away than the best candidate found are skipped.
+     *        Unlike CurveProjector the curve is copied, the inversion stays valid on its own.
+     */
+    class CurvePointInversion
+    {
+    public:
+        /**
+         * @param tolerance Parameter tolerance of the roots, relative to each Bezier segment.
+         */
+        explicit CurvePointInversion(const Curve& curve, Numeric tolerance = 1e-12);
+
+        [[nodiscard]] Curve::ProjectionResult Project(const Vec3& point) const;
+
+        [[nodiscard]] int SegmentCount() const
+        {
+            return static_cast<int>(m_Boxes.size());
+        }
+
+    private:
+        [[nodiscard]] Vec3 EvaluateSegment(int segment, Numeric t) const;
+
+        int m_Degree;
+        int m_PolynomialDegree;
+        Numeric m_Tolerance;
+        // Homogeneous Bezier points, m_Degree + 1 per segment
+        std::vector<Vec4> m_Points{};
+        std::vector<Numeric> m_Breakpoints{};
+        std::vector<BoundingBox> m_Boxes{};
+        // Stationarity polynomial S(t) - P·V(t), m_PolynomialDegree + 1 coefficients per segment
+        std::vector<Numeric> m_S{};
+        std::vector<Vec3> m_V{};
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <libnurbs/Algorithm/PointProjection.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Stateful point projection for ordered point streams such as scan lines and toolpaths.
+     *        Every query starts from the previous parameter, advanced by the previous increment,
+     *        and walks the knot span cursor instead of searching spans. The global seed table is
+     *        built and consulted only when that local Newton solve fails.
+     *        The curve is referenced, not copied: it must outlive the projector and stay unchanged.
+     */
+    class CurveProjector
+    {
+    public:
+        explicit CurveProjector(const Curve& curve,
+                                Numeric epsilon         = 1e-10,
+                                int max_iteration_count = 32);
+
+        Curve::ProjectionResult Project(const Vec3& point);
+
+        /**
+         * @brief Forgets the stream state, the next query is seeded globally.
+         */
+        void Reset();
+
+        /**
+         * @brief Number of queries that needed the global seed table.
+         */
+        [[nodiscard]] int GlobalSeedCount() const
+        {
+            return m_GlobalSeedCount;
+        }
+
+    private:
+        const Curve* m_Curve;
+        Numeric m_Epsilon;
+        int m_MaxIterationCount;
+        ProjectionSeeds m_Seeds{};
+        Curve::EvaluationScratch m_Scratch{};
+
+        bool m_HasLast{false};
+        Numeric m_Parameter{0};
+        Numeric m_Increment{0};
+        int m_SpanCursor{INVALID_INDEX};
+        Vec3 m_LastPoint = Vec3::Zero();
+        Numeric m_LastDistance{0};
+        int m_GlobalSeedCount{0};
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <libnurbs/Curve/Curve.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Steps along a curve by a given chord length per control cycle, e.g. feed rate times period.
+     *        Each step advances the parameter by the second order Taylor expansion of the arc length,
+     *        du = L / |C'| - L^2 (C'·C'') / (2 |C'|^4), from the derivatives cached at the current point,
+     *        then evaluates point, first and second derivative at the new parameter for the next step.
+     *        Where the curve stops (|C'| = 0) the step falls back to du = (k! L / |C^(k)|)^(1/k) with the
+     *        first non-zero derivative k, and jumps to the end of the span if the curve stands still on it.
+     *        Work per step is one EvaluateAll of order 2 and a knot span walk from the previous span, and
+     *        nothing is allocated after construction. The chord error of a step is of third order in L.
+     *        The curve is referenced, not copied: it must outlive the interpolator and stay unchanged.
+     */
+    class FeedrateInterpolator
+    {
+    public:
+        explicit FeedrateInterpolator(const Curve& curve, Numeric start = 0);
+
+        /**
+         * @brief Moves back to parameter start.
+         */
+        void Reset(Numeric start = 0);
+
+        /**
+         * @brief Advances by about length along the curve, the last step stops at the end.
+         * @return The new point.
+         */
+        const Vec3& Step(Numeric length);
+
+        [[nodiscard]] Numeric Parameter() const
+        {
+            return m_Parameter;
+        }
+
+        [[nodiscard]] const Vec3& Point() const
+        {
+            return m_Derivatives[0];
+        }
+
+        // First derivative C' at the current point
+        [[nodiscard]] const Vec3& Velocity() const
+        {
+            return m_Derivatives[1];
+        }
+
+        [[nodiscard]] bool Finished() const
+        {
+            return m_Parameter >= 1;
+        }
+
+    private:
+        void Evaluate();
+
+        // Parameter step away from a point where C' vanishes
+        Numeric StationaryStep(Numeric length);
+
+        const Curve* m_Curve;
+        Curve::EvaluationScratch m_Scratch{};
+        // Derivatives up to the degree, only needed where the curve stops
+        Curve::EvaluationScratch m_StationaryScratch{};
+        Numeric m_Parameter{0};
+        int m_Span{INVALID_INDEX};
+        // Point, first and second derivative at m_Parameter
+        Vec3 m_Derivatives[3];
+    };
+}
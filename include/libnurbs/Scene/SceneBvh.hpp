@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <libnurbs/Algorithm/PointProjection.hpp>
+#include <libnurbs/Core/BoundingBox.hpp>
+#include <libnurbs/Core/BoundingBoxArray.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Curve/CurvePointInversion.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Surface/SurfaceBvh.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Bounding volume hierarchy over a collection of curves and surfaces.
+     *        Objects are bounded by the box of their control points (convex hull property). The tree is
+     *        built with the surface area heuristic over binned centroids and stored as a flat node array,
+     *        leaf boxes are tested in SIMD packs from a BoundingBoxArray in tree order.
+     *        After objects moved or changed, e.g. replaced by their Transform, Refit updates the boxes
+     *        bottom up without rebuilding; Build again once the tree has degraded.
+     *        The closest point precomputation of an object, the Bezier inversion of a curve or the seeds and
+     *        patch BVH of a surface, is built by the first FindNearest visiting it and kept until the object
+     *        is re-bounded, so only objects near some query point pay for it.
+     *        Objects are referenced by address and must outlive the BVH.
+     */
+    class SceneBvh
+    {
+    public:
+        static constexpr int MAX_LEAF_SIZE = 4;
+        static constexpr int MAX_DEPTH = 64;
+        static constexpr int BIN_COUNT = 16;
+
+        /**
+         * @brief Nodes are stored depth first: the left child of an inner node follows it directly,
+         *        Right indexes the right child. Leaves hold Count objects starting at Start in ObjectOrder.
+         */
+        struct Node
+        {
+            BoundingBox Box{};
+            int Start{0};
+            int Count{0};
+            int Right{INVALID_INDEX};
+
+            [[nodiscard]] bool IsLeaf() const
+            {
+                return Count > 0;
+            }
+        };
+
+        struct NearestResult;
+
+        /**
+         * @return Object index, objects are numbered in the order they are added.
+         */
+        int AddCurve(const Curve& curve);
+
+        int AddSurface(const Surface& surface);
+
+        /**
+         * @brief Bounds all objects and builds the tree from scratch.
+         */
+        void Build();
+
+        /**
+         * @brief Re-bounds all objects and updates the node boxes, keeping the tree topology.
+         *        Objects added since the last Build are not in the tree, Build is called instead then.
+         */
+        void Refit();
+
+        /**
+         * @brief Re-bounds only the given objects and updates the node boxes, or Builds like Refit().
+         */
+        void Refit(std::span<const int> objects);
+
+        [[nodiscard]] int ObjectCount() const
+        {
+            return static_cast<int>(m_Objects.size());
+        }
+
+        /**
+         * @return The curve of object, nullptr if it is a surface.
+         */
+        [[nodiscard]] const Curve* GetCurve(int object) const
+        {
+            auto curve = std::get_if<const Curve*>(&m_Objects[object]);
+            return curve ? *curve : nullptr;
+        }
+
+        /**
+         * @return The surface of object, nullptr if it is a curve.
+         */
+        [[nodiscard]] const Surface* GetSurface(int object) const
+        {
+            auto surface = std::get_if<const Surface*>(&m_Objects[object]);
+            return surface ? *surface : nullptr;
+        }
+
+        [[nodiscard]] const BoundingBox& ObjectBox(int object) const
+        {
+            return m_ObjectBoxes[object];
+        }
+
+        [[nodiscard]] const std::vector<Node>& Nodes() const
+        {
+            return m_Nodes;
+        }
+
+        [[nodiscard]] const std::vector<int>& ObjectOrder() const
+        {
+            return m_ObjectOrder;
+        }
+
+        /**
+         * @brief Objects whose boxes overlap box, appended to objects.
+         */
+        void QueryBox(const BoundingBox& box, std::vector<int>& objects) const;
+
+        /**
+         * @brief Pairs (i, j), i < j, of objects with overlapping boxes, appended to pairs.
+         *        These are the candidates of clash detection.
+         */
+        void QueryOverlaps(std::vector<std::pair<int, int>>& pairs) const;
+
+        /**
+         * @brief Objects whose boxes the ray origin + t * direction, t in [0, t_max], passes,
+         *        appended to objects in traversal order.
+         */
+        void QueryRay(const Vec3& origin, const Vec3& direction, Numeric t_max, std::vector<int>& objects) const;
+
+        /**
+         * @brief Object closest to point, measured by curve and surface projection.
+         *        Objects whose boxes are farther away than the best distance found are never projected.
+         *        Queries may run concurrently, the precomputation of an object is built once.
+         */
+        [[nodiscard]] NearestResult FindNearest(const Vec3& point) const;
+
+        /**
+         * @brief Visits objects near point first, nearer subtrees before farther ones.
+         *        visit(object, squared box distance) returns the squared distance still worth searching;
+         *        subtrees farther away than that are skipped.
+         */
+        template <typename Visitor>
+        void TraverseNearest(const Vec3& point, Visitor&& visit) const;
+
+        /**
+         * @brief Visits the objects whose boxes the ray origin + t * direction, t in [0, t_max], passes,
+         *        nearer subtrees first. visit(object, t_enter) returns the new t_max, e.g. the nearest hit.
+         */
+        template <typename Visitor>
+        void TraverseRay(const Vec3& origin, const Vec3& direction, Numeric t_max, Visitor&& visit) const;
+
+    private:
+        // Seed table and patch BVH of a surface, as built by Surface::ProjectPoints per call
+        struct SurfaceProjection
+        {
+            ProjectionSeeds Seeds;
+            SurfaceBvh Bvh;
+        };
+
+        // Built once by whichever concurrent FindNearest gets there first
+        struct Projection
+        {
+            std::once_flag Built{};
+            // Read only by Build and Refit, which never run concurrently with queries
+            bool Ready{false};
+            std::variant<SurfaceProjection, CurvePointInversion> Value{};
+        };
+
+        [[nodiscard]] const Projection& GetProjection(int object) const;
+
+        int BuildNode(int start, int count, int depth);
+
+        // Box and center of object, its closest point precomputation is dropped
+        void UpdateObject(int object);
+
+        void UpdateNodeBoxes();
+
+        /**
+         * @brief Pairs of the object at tree position k with the overlapping ones at positions [begin, end).
+         */
+        void AppendOverlaps(int k, int begin, int end, std::vector<std::pair<int, int>>& pairs) const;
+
+        std::vector<std::variant<const Curve*, const Surface*>> m_Objects{};
+        std::vector<BoundingBox> m_ObjectBoxes{};
+        std::vector<std::unique_ptr<Projection>> m_Projections{};
+        std::vector<Vec3> m_Centers{};
+        std::vector<int> m_ObjectOrder{};
+        // m_ObjectBoxes in the order of m_ObjectOrder
+        BoundingBoxArray m_LeafBoxes{};
+        std::vector<Node> m_Nodes{};
+    };
+
+    struct SceneBvh::NearestResult
+    {
+        int Object{INVALID_INDEX};
+        Numeric Distance{std::numeric_limits<Numeric>::max()};
+        Vec3 Point = Vec3::Zero();
+        Numeric U{0};
+        // Zero for curves
+        Numeric V{0};
+    };
+
+    template <typename Visitor>
+    void SceneBvh::TraverseNearest(const Vec3& point, Visitor&& visit) const
+    {
+        if (m_Nodes.empty()) return;
+        struct Entry
+        {
+            int Node;
+            Numeric Distance;
+        };
+        Entry stack[MAX_DEPTH + 1];
+        int top = 0;
+        stack[top++] = {0, m_Nodes[0].Box.SquaredDistance(point)};
+        Numeric bound = std::numeric_limits<Numeric>::max();
+        while (top > 0)
+        {
+            Entry entry = stack[--top];
+            if (entry.Distance > bound) continue;
+            const Node& node = m_Nodes[entry.Node];
+            if (node.IsLeaf())
+            {
+                Numeric distances[MAX_LEAF_SIZE];
+                for (int k = node.Start; k < node.Start + node.Count; k += MAX_LEAF_SIZE)
+                {
+                    const int count = std::min(MAX_LEAF_SIZE, node.Start + node.Count - k);
+                    m_LeafBoxes.SquaredDistances(point, k, count, distances);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        if (distances[i] <= bound) bound = visit(m_ObjectOrder[k + i], distances[i]);
+                    }
+                }
+                continue;
+            }
+            // Push the farther child first so the nearer one is searched first
+            Entry near{entry.Node + 1, m_Nodes[entry.Node + 1].Box.SquaredDistance(point)};
+            Entry far{node.Right, m_Nodes[node.Right].Box.SquaredDistance(point)};
+            if (far.Distance < near.Distance) std::swap(near, far);
+            stack[top++] = far;
+            stack[top++] = near;
+        }
+    }
+
+    template <typename Visitor>
+    void SceneBvh::TraverseRay(const Vec3& origin, const Vec3& direction, Numeric t_max, Visitor&& visit) const
+    {
+        if (m_Nodes.empty()) return;
+        const Vec3 inverse = direction.cwiseInverse();
+        struct Entry
+        {
+            int Node;
+            Numeric Enter;
+        };
+        Entry stack[MAX_DEPTH + 1];
+        int top = 0;
+        Numeric enter;
+        if (!m_Nodes[0].Box.IntersectRay(origin, inverse, 0, t_max, enter)) return;
+        stack[top++] = {0, enter};
+        while (top > 0)
+        {
+            Entry entry = stack[--top];
+            if (entry.Enter > t_max) continue;
+            const Node& node = m_Nodes[entry.Node];
+            if (node.IsLeaf())
+            {
+                Numeric enters[MAX_LEAF_SIZE];
+                for (int k = node.Start; k < node.Start + node.Count; k += MAX_LEAF_SIZE)
+                {
+                    const int count = std::min(MAX_LEAF_SIZE, node.Start + node.Count - k);
+                    for (uint64_t hits = m_LeafBoxes.IntersectRayMask(origin, inverse, 0, t_max, k, count, enters);
+                         hits != 0; hits &= hits - 1)
+                    {
+                        const int i = std::countr_zero(hits);
+                        // Earlier visits may have shortened the ray
+                        if (enters[i] <= t_max) t_max = visit(m_ObjectOrder[k + i], enters[i]);
+                    }
+                }
+                continue;
+            }
+            Numeric enter_left, enter_right;
+            bool hit_left  = m_Nodes[entry.Node + 1].Box.IntersectRay(origin, inverse, 0, t_max, enter_left);
+            bool hit_right = m_Nodes[node.Right].Box.IntersectRay(origin, inverse, 0, t_max, enter_right);
+            Entry near{entry.Node + 1, enter_left};
+            Entry far{node.Right, enter_right};
+            if (!hit_left)
+            {
+                if (hit_right) stack[top++] = far;
+                continue;
+            }
+            if (hit_right)
+            {
+                if (far.Enter < near.Enter) std::swap(near, far);
+                stack[top++] = far;
+            }
+            stack[top++] = near;
+        }
+    }
+}
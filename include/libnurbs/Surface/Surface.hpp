@@ -1,14 +1,23 @@
 #pragma once
 
 #include <span>
+#include <libnurbs/Basis/BSplineBasis.hpp>
+#include <libnurbs/Core/BoundingBox.hpp>
 #include <libnurbs/Core/Typedefs.hpp>
 #include <libnurbs/Core/KnotVector.hpp>
 #include <libnurbs/Core/Grid.hpp>
+#include <libnurbs/Core/TriangleMesh.hpp>
 
 namespace libnurbs
 {
     class Surface
     {
+    public:
+        struct EvaluationScratch;
+        struct ProjectionResult;
+        struct RayHit;
+        struct TessellationOptions;
+
     public:
         int DegreeU{INVALID_DEGREE};
         int DegreeV{INVALID_DEGREE};
@@ -33,6 +42,18 @@ namespace libnurbs
 
         [[nodiscard]] Grid<Vec3> EvaluateAll(Numeric u, Numeric v, int order_u, int order_v) const;
 
+        /**
+         * @brief Allocation-free variant of EvaluateAll for hot loops.
+         * @param scratch Per-thread working memory, the result lives in it until the next call.
+         * @param index_span_u Knot span containing u, INVALID_INDEX to look it up.
+         * @param index_span_v Knot span containing v, INVALID_INDEX to look it up.
+         * @return Grid of derivatives, Get(k, l) is the k-th derivative in u and l-th in v.
+         */
+        const Grid<Vec3>& EvaluateAll(Numeric u, Numeric v, int order_u, int order_v,
+                                      EvaluationScratch& scratch,
+                                      int index_span_u = INVALID_INDEX,
+                                      int index_span_v = INVALID_INDEX) const;
+
         [[nodiscard]] bool IsRational() const;
 
         /**
@@ -63,6 +84,58 @@ namespace libnurbs
                                                    Numeric epsilon = 1e-8,
                                                    Numeric max_iteration_count = 512) const -> std::pair<Numeric, Numeric>;
 
+        /**
+         * @brief Projects a batch of points onto the surface, in parallel.
+         *        Each point is seeded from a per-span sample table and refined with Newton iterations.
+         * @param points Points to project
+         * @param epsilon Distance and cosine tolerance of the Newton iterations, default is 1e-10
+         * @param max_iteration_count Maximum Newton iterations per point, default is 32
+         * @param thread_count Number of threads, <= 0 means hardware concurrency
+         * @return One result per point, in input order.
+         */
+        [[nodiscard]] vector<ProjectionResult> ProjectPoints(std::span<const Vec3> points,
+                                                           Numeric epsilon = 1e-10,
+                                                           int max_iteration_count = 32,
+                                                           int thread_count = 0) const;
+
+        /**
+         * @brief Nearest intersection of the ray origin + t * direction, t >= 0, with the surface,
+         *        found by Bezier clipping of the patches along the ray, see IntersectRayPatch.
+         *        Builds a SurfaceBvh per call, use IntersectRays or a SurfaceBvh for many rays.
+         * @param epsilon Distance between surface and ray at which Newton refinement stops, relative to
+         *        the bounding box diagonal of the Bezier patch
+         */
+        [[nodiscard]] RayHit IntersectRay(const Vec3& origin, const Vec3& direction, Numeric epsilon = 1e-10) const;
+
+        /**
+         * @brief Intersects a batch of rays with the surface, in parallel.
+         *        Consecutive rays are traced as packets sharing one BVH traversal, so pass coherent
+         *        rays (e.g. the pixels of a tile) next to each other.
+         * @param thread_count Number of threads, <= 0 means hardware concurrency
+         * @return One result per ray, in input order.
+         */
+        [[nodiscard]] vector<RayHit> IntersectRays(std::span<const Vec3> origins,
+                                                   std::span<const Vec3> directions,
+                                                   Numeric epsilon = 1e-10,
+                                                   int thread_count = 0) const;
+
+        /**
+         * @brief Adaptive triangle mesh of the surface, see SurfaceTessellation.
+         *        Every Bezier patch gets its own grid resolution; patches share their edge vertices,
+         *        so the mesh is free of cracks and T-junctions.
+         * @param output Resized to the exact vertex and triangle counts and filled.
+         */
+        void Tessellate(const TessellationOptions& options, TriangleMesh& output) const;
+
+        /**
+         * @brief Box of the surface by recursive halving of its Bezier patches, alternating u and v.
+         *        A piece stops splitting once its control net box is within epsilon or matches the box
+         *        of its corners. The result is the union of those corner boxes, at most about epsilon
+         *        inside the exact box. Patches are processed in parallel, each worker subdividing on a
+         *        fixed arena. SurfaceBvh keeps the coarser per-patch boxes for repeated queries.
+         * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+         */
+        BoundingBox GetBoundingBox(Numeric epsilon = 1e-3, int thread_count = 1) const;
 
         [[nodiscard]] Surface InsertKnotU(Numeric knot_value) const;
 
@@ -101,6 +174,46 @@ namespace libnurbs
         [[nodiscard]] Surface AlignParameterDomain(AlignAxis u_axis, AlignAxis v_axis);
 
     private:
-        [[nodiscard]] Grid<Vec4> HomogeneousDerivative(Numeric u, Numeric v, int order_u, int order_v) const;
+        void HomogeneousDerivative(Numeric u, Numeric v, int index_span_u, int index_span_v,
+                                   int order_u, int order_v, EvaluationScratch& scratch) const;
+    };
+
+    struct Surface::EvaluationScratch
+    {
+        BSplineBasis::Scratch Basis{};
+        MatX BasisDerivativesU{};
+        MatX BasisDerivativesV{};
+        vector<Vec4> Temp{};
+        Grid<Vec4> HomogeneousDerivatives{};
+        Grid<Vec3> Derivatives{};
+    };
+
+    struct Surface::ProjectionResult
+    {
+        Numeric U{INVALID_VALUE};
+        Numeric V{INVALID_VALUE};
+        Vec3 Point = Vec3::Zero();
+        Numeric Distance{INVALID_VALUE};
+        bool Converged{false};
+    };
+
+    struct Surface::RayHit
+    {
+        Numeric U{INVALID_VALUE};
+        Numeric V{INVALID_VALUE};
+        // Ray parameter of the hit, in units of the direction vector
+        Numeric T{INVALID_VALUE};
+        Vec3 Point = Vec3::Zero();
+        bool Hit{false};
+    };
+
+    struct Surface::TessellationOptions
+    {
+        // Maximum distance between surface and mesh
+        Numeric ChordTolerance{1e-3};
+        // Maximum angle in radians between the normals of neighbouring vertices, <= 0 disables the check
+        Numeric NormalTolerance{0.2};
+        // Upper limit of the grid resolution per patch and direction
+        int MaxSegments{64};
     };
 }
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <libnurbs/Core/BoundingBox.hpp>
+#include <libnurbs/Core/BoundingBoxArray.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Bounding volume hierarchy over the Bezier patches of one surface.
+     *        Every patch is bounded by the box of its Bezier points (convex hull property), the tree
+     *        splits patch sets at the median of their centers along the longest axis. Built once, it serves
+     *        ray casting (TraverseRay), nearest patch searches such as projection seeding (TraverseNearest)
+     *        and clash queries (QueryBox, QueryOverlaps). Patch indices run u fastest, as in DecomposeSurface,
+     *        which matches the span order of ProjectionSeeds. Leaf boxes are also kept in tree order in a
+     *        BoundingBoxArray, so each leaf is tested in SIMD packs.
+     *        The BVH copies what it needs and does not reference the surface.
+     */
+    class SurfaceBvh
+    {
+    public:
+        static constexpr int MAX_LEAF_SIZE = 4;
+        static constexpr int MAX_DEPTH = 64;
+        static constexpr int MAX_PACKET_SIZE = 64;
+
+        /**
+         * @brief Nodes are stored depth first: the left child of an inner node follows it directly,
+         *        Right indexes the right child. Leaves hold Count patches starting at Start in PatchOrder.
+         */
+        struct Node
+        {
+            BoundingBox Box{};
+            int Start{0};
+            int Count{0};
+            int Right{INVALID_INDEX};
+
+            [[nodiscard]] bool IsLeaf() const
+            {
+                return Count > 0;
+            }
+        };
+
+        SurfaceBvh() = default;
+
+        explicit SurfaceBvh(const Surface& surface);
+
+        [[nodiscard]] int PatchCount() const
+        {
+            return static_cast<int>(m_PatchBoxes.size());
+        }
+
+        [[nodiscard]] int PatchCountU() const
+        {
+            return static_cast<int>(m_BreakpointsU.size()) - 1;
+        }
+
+        [[nodiscard]] const BoundingBox& GetBoundingBox() const
+        {
+            return m_Nodes.front().Box;
+        }
+
+        [[nodiscard]] const BoundingBox& PatchBox(int patch) const
+        {
+            return m_PatchBoxes[patch];
+        }
+
+        /**
+         * @brief Homogeneous Bezier points of a patch, laid out as by DecomposeSurface.
+         */
+        [[nodiscard]] std::span<const Vec4> PatchPoints(int patch) const
+        {
+            return {m_PatchPoints.data() + patch * m_PatchSize, static_cast<size_t>(m_PatchSize)};
+        }
+
+        /**
+         * @brief Parameter rectangle [u0, u1] x [v0, v1] of a patch.
+         */
+        void PatchDomain(int patch, Numeric& u0, Numeric& u1, Numeric& v0, Numeric& v1) const
+        {
+            const int a = patch % PatchCountU();
+            const int b = patch / PatchCountU();
+            u0 = m_BreakpointsU[a];
+            u1 = m_BreakpointsU[a + 1];
+            v0 = m_BreakpointsV[b];
+            v1 = m_BreakpointsV[b + 1];
+        }
+
+        [[nodiscard]] const std::vector<Node>& Nodes() const
+        {
+            return m_Nodes;
+        }
+
+        [[nodiscard]] const std::vector<int>& PatchOrder() const
+        {
+            return m_PatchOrder;
+        }
+
+        /**
+         * @brief Patches whose boxes overlap box, appended to patches.
+         */
+        void QueryBox(const BoundingBox& box, std::vector<int>& patches) const;
+
+        /**
+         * @brief Pairs (patch of this, patch of other) with overlapping boxes, appended to pairs.
+         */
+        void QueryOverlaps(const SurfaceBvh& other, std::vector<std::pair<int, int>>& pairs) const;
+
+        /**
+         * @brief Visits patches near point first, nearer subtrees before farther ones.
+         *        visit(patch, squared box distance) returns the squared distance still worth searching;
+         *        subtrees farther away than that are skipped.
+         */
+        template <typename Visitor>
+        void TraverseNearest(const Vec3& point, Visitor&& visit) const;
+
+        /**
+         * @brief Visits the patches whose boxes the ray origin + t * direction, t in [0, t_max], passes,
+         *        nearer subtrees first. visit(patch, t_enter) returns the new t_max, e.g. the nearest hit.
+         */
+        template <typename Visitor>
+        void TraverseRay(const Vec3& origin, const Vec3& direction, Numeric t_max, Visitor&& visit) const;
+
+        /**
+         * @brief Traverses the tree once for a packet of count <= MAX_PACKET_SIZE rays, testing every node
+         *        against the rays still active in it. Coherent rays share most nodes, so each node is
+         *        fetched once per packet instead of once per ray.
+         *        visit(ray, patch, t_enter) returns the new t_max of that ray, t_max is updated in place.
+         */
+        template <typename Visitor>
+        void TraversePacket(int count, const Vec3* origins, const Vec3* directions, Numeric* t_max,
+                            Visitor&& visit) const;
+
+    private:
+        int Build(int start, int count, int depth);
+
+        int m_PatchSize{0};
+        std::vector<Vec4> m_PatchPoints{};
+        std::vector<Numeric> m_BreakpointsU{};
+        std::vector<Numeric> m_BreakpointsV{};
+        std::vector<BoundingBox> m_PatchBoxes{};
+        std::vector<int> m_PatchOrder{};
+        // m_PatchBoxes in the order of m_PatchOrder
+        BoundingBoxArray m_LeafBoxes{};
+        std::vector<Node> m_Nodes{};
+    };
+
+    template <typename Visitor>
+    void SurfaceBvh::TraverseNearest(const Vec3& point, Visitor&& visit) const
+    {
+        if (m_Nodes.empty()) return;
+        struct Entry
+        {
+            int Node;
+            Numeric Distance;
+        };
+        Entry stack[MAX_DEPTH + 1];
+        int top = 0;
+        stack[top++] = {0, m_Nodes[0].Box.SquaredDistance(point)};
+        Numeric bound = std::numeric_limits<Numeric>::max();
+        while (top > 0)
+        {
+            Entry entry = stack[--top];
+            if (entry.Distance > bound) continue;
+            const Node& node = m_Nodes[entry.Node];
+            if (node.IsLeaf())
+            {
+                Numeric distances[MAX_LEAF_SIZE];
+                for (int k = node.Start; k < node.Start + node.Count; k += MAX_LEAF_SIZE)
+                {
+                    const int count = std::min(MAX_LEAF_SIZE, node.Start + node.Count - k);
+                    m_LeafBoxes.SquaredDistances(point, k, count, distances);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        if (distances[i] <= bound) bound = visit(m_PatchOrder[k + i], distances[i]);
+                    }
+                }
+                continue;
+            }
+            // Push the farther child first so the nearer one is searched first
+            Entry near{entry.Node + 1, m_Nodes[entry.Node + 1].Box.SquaredDistance(point)};
+            Entry far{node.Right, m_Nodes[node.Right].Box.SquaredDistance(point)};
+            if (far.Distance < near.Distance) std::swap(near, far);
+            stack[top++] = far;
+            stack[top++] = near;
+        }
+    }
+
+    template <typename Visitor>
+    void SurfaceBvh::TraverseRay(const Vec3& origin, const Vec3& direction, Numeric t_max, Visitor&& visit) const
+    {
+        if (m_Nodes.empty()) return;
+        const Vec3 inverse = direction.cwiseInverse();
+        struct Entry
+        {
+            int Node;
+            Numeric Enter;
+        };
+        Entry stack[MAX_DEPTH + 1];
+        int top = 0;
+        Numeric enter;
+        if (!m_Nodes[0].Box.IntersectRay(origin, inverse, 0, t_max, enter)) return;
+        stack[top++] = {0, enter};
+        while (top > 0)
+        {
+            Entry entry = stack[--top];
+            if (entry.Enter > t_max) continue;
+            const Node& node = m_Nodes[entry.Node];
+            if (node.IsLeaf())
+            {
+                Numeric enters[MAX_LEAF_SIZE];
+                for (int k = node.Start; k < node.Start + node.Count; k += MAX_LEAF_SIZE)
+                {
+                    const int count = std::min(MAX_LEAF_SIZE, node.Start + node.Count - k);
+                    for (uint64_t hits = m_LeafBoxes.IntersectRayMask(origin, inverse, 0, t_max, k, count, enters);
+                         hits != 0; hits &= hits - 1)
+                    {
+                        const int i = std::countr_zero(hits);
+                        // Earlier visits may have shortened the ray
+                        if (enters[i] <= t_max) t_max = visit(m_PatchOrder[k + i], enters[i]);
+                    }
+                }
+                continue;
+            }
+            Numeric enter_left, enter_right;
+            bool hit_left  = m_Nodes[entry.Node + 1].Box.IntersectRay(origin, inverse, 0, t_max, enter_left);
+            bool hit_right = m_Nodes[node.Right].Box.IntersectRay(origin, inverse, 0, t_max, enter_right);
+            Entry near{entry.Node + 1, enter_left};
+            Entry far{node.Right, enter_right};
+            if (!hit_left)
+            {
+                if (hit_right) stack[top++] = far;
+                continue;
+            }
+            if (hit_right)
+            {
+                if (far.Enter < near.Enter) std::swap(near, far);
+                stack[top++] = far;
+            }
+            stack[top++] = near;
+        }
+    }
+
+    template <typename Visitor>
+    void SurfaceBvh::TraversePacket(int count, const Vec3* origins, const Vec3* directions, Numeric* t_max,
+                                    Visitor&& visit) const
+    {
+        assert(count <= MAX_PACKET_SIZE);
+        if (m_Nodes.empty() || count == 0) return;
+        Vec3 inverse[MAX_PACKET_SIZE];
+        for (int i = 0; i < count; ++i)
+        {
+            inverse[i] = directions[i].cwiseInverse();
+        }
+        Numeric enters[MAX_PACKET_SIZE];
+        // Rays of active that pass box, the nearest entry of them goes to nearest.
+        auto test = [&](const BoundingBox& box, uint64_t active, Numeric& nearest)
+        {
+            uint64_t hits = 0;
+            nearest = std::numeric_limits<Numeric>::max();
+            for (; active != 0; active &= active - 1)
+            {
+                const int i = std::countr_zero(active);
+                if (box.IntersectRay(origins[i], inverse[i], 0, t_max[i], enters[i]))
+                {
+                    hits |= uint64_t(1) << i;
+                    nearest = std::min(nearest, enters[i]);
+                }
+            }
+            return hits;
+        };
+
+        struct Entry
+        {
+            int Node;
+            uint64_t Active;
+        };
+        Entry stack[MAX_DEPTH + 1];
+        int top = 0;
+        Numeric nearest;
+        const uint64_t all = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+        uint64_t active = test(m_Nodes[0].Box, all, nearest);
+        if (active == 0) return;
+        stack[top++] = {0, active};
+        while (top > 0)
+        {
+            Entry entry = stack[--top];
+            const Node& node = m_Nodes[entry.Node];
+            if (node.IsLeaf())
+            {
+                for (int k = node.Start; k < node.Start + node.Count; ++k)
+                {
+                    const int patch = m_PatchOrder[k];
+                    for (uint64_t hits = test(m_PatchBoxes[patch], entry.Active, nearest); hits != 0; hits &= hits - 1)
+                    {
+                        const int i = std::countr_zero(hits);
+                        t_max[i] = visit(i, patch, enters[i]);
+                    }
+                }
+                continue;
+            }
+            Numeric enter_left, enter_right;
+            Entry near{entry.Node + 1, test(m_Nodes[entry.Node + 1].Box, entry.Active, enter_left)};
+            Entry far{node.Right, test(m_Nodes[node.Right].Box, entry.Active, enter_right)};
+            if (enter_right < enter_left) std::swap(near, far);
+            if (far.Active != 0) stack[top++] = far;
+            if (near.Active != 0) stack[top++] = near;
+        }
+    }
+}
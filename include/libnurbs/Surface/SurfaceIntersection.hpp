@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include <libnurbs/Core/Polyline.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Surface/SurfaceBvh.hpp>
+
+namespace libnurbs
+{
+    struct SurfaceIntersectionOptions
+    {
+        // Distance between the surfaces at which a marched point counts as on both
+        Numeric Tolerance{1e-10};
+        // Maximum distance between the intersection curve and the chords of the polyline
+        Numeric ChordTolerance{1e-3};
+        // Maximum angle in radians between the tangents at consecutive points
+        Numeric AngleTolerance{0.2};
+        // Patch pairs are searched for start points in parallel, values <= 0 mean hardware concurrency
+        int ThreadCount{0};
+    };
+
+    /**
+     * @brief One branch of the intersection of two surfaces.
+     */
+    struct SurfaceIntersection
+    {
+        // Marched points, Parameters are those of Fitted at the points
+        Polyline Path{};
+        // Surface parameters (u, v) of the points on the first and second surface
+        std::vector<Eigen::Vector2<Numeric>> ParametersA{};
+        std::vector<Eigen::Vector2<Numeric>> ParametersB{};
+        // Cubic Hermite curve through the points along their marched tangents, C1 and parameterized by chord
+        // length on [0, 1]. It is local and uses the exact tangents, so it is the final result rather than a
+        // stand-in for Curve::Interpolate, which would ignore them; refit Path.Points for a C2 curve.
+        Curve Fitted{};
+        // Closed branches do not repeat their first point in Path, Fitted returns to it
+        bool Closed{false};
+    };
+
+    /**
+     * @brief Intersection curves of two surfaces, one entry per branch.
+     *        Start points: overlapping patch pairs of the two BVHs are subdivided while neither their
+     *        boxes nor the planes through their corners separate them, until the pieces are flat relative
+     *        to the angle between them, so that they meet in at most one arc. Every remaining pair seeds
+     *        Newton iterations onto both surfaces.
+     *        Marching: from each start point not already on a traced branch, steps follow the tangent
+     *        nA × nB in both directions. A step predicts parameters on both surfaces from the first
+     *        derivatives and corrects them by Newton in the plane normal to the tangent. The step length
+     *        adapts to the chord and angle tolerances, and a branch ends on a domain boundary, where the
+     *        surfaces touch tangentially, or back at its start. Both surfaces keep the knot spans of the
+     *        previous step as cursors, so each evaluation walks at most a few spans.
+     *        Tangential intersections and loops smaller than the flatness tolerance can be missed.
+     */
+    std::vector<SurfaceIntersection> Intersect(const Surface& a, const SurfaceBvh& bvh_a,
+                                               const Surface& b, const SurfaceBvh& bvh_b,
+                                               const SurfaceIntersectionOptions& options = {});
+
+    /**
+     * @brief Same as above, builds both BVHs per call.
+     */
+    std::vector<SurfaceIntersection> Intersect(const Surface& a, const Surface& b,
+                                               const SurfaceIntersectionOptions& options = {});
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <libnurbs/Algorithm/PointProjection.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Surface/SurfaceBvh.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Stateful point projection for ordered point streams such as scan lines and toolpaths.
+     *        Every query starts from the previous (u, v), advanced by the previous increment,
+     *        and walks the knot span cursors instead of searching spans. The global seed table and
+     *        the patch BVH are built and consulted only when that local Newton solve fails.
+     *        The surface is referenced, not copied: it must outlive the projector and stay unchanged.
+     */
+    class SurfaceProjector
+    {
+    public:
+        explicit SurfaceProjector(const Surface& surface,
+                                  Numeric epsilon = 1e-10,
+                                  int max_iteration_count = 32);
+
+        Surface::ProjectionResult Project(const Vec3& point);
+
+        /**
+         * @brief Forgets the stream state, the next query is seeded globally.
+         */
+        void Reset();
+
+        /**
+         * @brief Number of queries that needed the global seed table.
+         */
+        [[nodiscard]] int GlobalSeedCount() const
+        {
+            return m_GlobalSeedCount;
+        }
+
+    private:
+        const Surface* m_Surface;
+        Numeric m_Epsilon;
+        int m_MaxIterationCount;
+        ProjectionSeeds m_Seeds{};
+        SurfaceBvh m_Bvh{};
+        Surface::EvaluationScratch m_Scratch{};
+
+        bool m_HasLast{false};
+        Numeric m_U{0};
+        Numeric m_V{0};
+        Numeric m_IncrementU{0};
+        Numeric m_IncrementV{0};
+        int m_SpanCursorU{INVALID_INDEX};
+        int m_SpanCursorV{INVALID_INDEX};
+        Vec3 m_LastPoint = Vec3::Zero();
+        Numeric m_LastDistance{0};
+        int m_GlobalSeedCount{0};
+    };
+}
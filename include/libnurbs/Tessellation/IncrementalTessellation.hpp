@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <libnurbs/Core/BoundingBox.hpp>
+#include <libnurbs/Core/TriangleMesh.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Tessellation/SurfaceTessellation.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Keeps the tessellation and bounding boxes of an interactively edited surface up to date.
+     *        Edits made through ControlPoints.Edit or Set are recorded in the dirty region of the grid.
+     *        Update then re-extracts and replans only the Bezier patches in the support of the edited
+     *        control points. It re-evaluates only the vertices in that support and copies every other
+     *        vertex from the previous mesh. Changes of degree, knots or grid size fall back to a full
+     *        tessellation.
+     *        The surface is referenced and must outlive this object.
+     */
+    class IncrementalTessellation
+    {
+    public:
+        /**
+         * @brief Tessellates the whole surface and clears its dirty region.
+         */
+        IncrementalTessellation(Surface& surface, const Surface::TessellationOptions& options);
+
+        /**
+         * @brief Applies the edits recorded since the last update and clears the dirty region.
+         * @return Number of patches recomputed.
+         */
+        int Update();
+
+        [[nodiscard]] const TriangleMesh& Mesh() const
+        {
+            return m_Mesh;
+        }
+
+        /**
+         * @brief Box of the Bezier points of all patches, which encloses the surface.
+         */
+        [[nodiscard]] const BoundingBox& GetBoundingBox() const
+        {
+            return m_BoundingBox;
+        }
+
+        [[nodiscard]] int PatchCount() const
+        {
+            return m_Tessellation->PatchCount();
+        }
+
+        [[nodiscard]] const BoundingBox& PatchBoundingBox(int patch) const
+        {
+            return m_PatchBoxes[patch];
+        }
+
+    private:
+        void Rebuild();
+
+        [[nodiscard]] bool IsStructureUnchanged() const;
+
+        void UpdatePatchBox(int patch);
+
+        void UpdateBoundingBox();
+
+        Surface* m_Surface;
+        Surface::TessellationOptions m_Options;
+        std::unique_ptr<SurfaceTessellation> m_Tessellation{};
+        TriangleMesh m_Mesh{};
+        TriangleMesh m_Spare{};
+        Surface::EvaluationScratch m_Scratch{};
+        std::vector<BoundingBox> m_PatchBoxes{};
+        BoundingBox m_BoundingBox{};
+
+        // Structure the tessellation was built for
+        int m_DegreeU{INVALID_DEGREE};
+        int m_DegreeV{INVALID_DEGREE};
+        int m_CountU{0};
+        int m_CountV{0};
+        std::vector<Numeric> m_KnotsU{};
+        std::vector<Numeric> m_KnotsV{};
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <libnurbs/Core/TriangleMesh.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Streams meshes into a single file, one mesh at a time.
+     *        Every Write encodes the mesh and hands it to the stream right away, so only the mesh
+     *        being written is held in memory. Meshes are independent parts: their indices are local
+     *        and get offset by the vertices written before. A writer fits a TessellationEngine sink:
+     *        [&](int, const TriangleMesh& mesh) { writer.Write(mesh); }
+     *        Stream failures throw std::runtime_error.
+     */
+    class MeshWriter
+    {
+    public:
+        virtual ~MeshWriter() = default;
+
+        virtual void Write(const TriangleMesh& mesh) = 0;
+
+        /**
+         * @brief Completes the file. Must be called after the last Write; further calls do nothing.
+         */
+        virtual void Finish() = 0;
+
+        [[nodiscard]] uint64_t VertexCount() const
+        {
+            return m_VertexCount;
+        }
+
+        [[nodiscard]] uint64_t TriangleCount() const
+        {
+            return m_TriangleCount;
+        }
+
+    protected:
+        uint64_t m_VertexCount{0};
+        uint64_t m_TriangleCount{0};
+        bool m_Finished{false};
+        std::vector<char> m_Buffer{};
+    };
+
+    /**
+     * @brief Binary STL. Triangles are written as they come with facet normals from their corners;
+     *        the triangle count in the header is patched by Finish, so the stream must be seekable.
+     */
+    class StlWriter : public MeshWriter
+    {
+    public:
+        explicit StlWriter(std::ostream& os);
+
+        void Write(const TriangleMesh& mesh) override;
+
+        void Finish() override;
+
+    private:
+        std::ostream& m_Stream;
+        std::streampos m_CountPosition;
+    };
+
+    /**
+     * @brief Binary little endian PLY with positions, normals and surface parameters per vertex.
+     *        PLY stores all vertices before all faces, so vertices go straight to the stream while
+     *        faces are spooled to a temporary file and appended by Finish. The element counts are
+     *        fixed width fields in the header, patched by Finish; the stream must be seekable.
+     */
+    class PlyWriter : public MeshWriter
+    {
+    public:
+        explicit PlyWriter(std::ostream& os);
+
+        void Write(const TriangleMesh& mesh) override;
+
+        void Finish() override;
+
+    private:
+        struct FileCloser
+        {
+            void operator()(std::FILE* file) const
+            {
+                std::fclose(file);
+            }
+        };
+
+        std::ostream& m_Stream;
+        std::unique_ptr<std::FILE, FileCloser> m_Faces;
+        std::streampos m_VertexCountPosition;
+        std::streampos m_FaceCountPosition;
+    };
+
+    /**
+     * @brief Wavefront OBJ with positions, normals and surface parameters as texture coordinates.
+     *        Every mesh becomes its own object, no seeking is needed.
+     */
+    class ObjWriter : public MeshWriter
+    {
+    public:
+        explicit ObjWriter(std::ostream& os);
+
+        void Write(const TriangleMesh& mesh) override;
+
+        void Finish() override;
+
+    private:
+        std::ostream& m_Stream;
+        int m_ObjectCount{0};
+    };
+}
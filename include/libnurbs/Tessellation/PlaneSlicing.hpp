@@ -0,0 +1,60 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <libnurbs/Core/Polyline.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief A family of parallel planes Normal·x = level and how finely to trace them.
+     */
+    struct SliceOptions
+    {
+        Vec3 Normal{0, 0, 1};
+        // Curves: parameter tolerance of the roots. Surfaces: height tolerance of the contour points.
+        Numeric Tolerance{1e-10};
+        // Resolution of the parameter grid a surface is contoured on, as for tessellation
+        Surface::TessellationOptions Grid{};
+        // Levels are sliced in parallel, values <= 0 mean hardware concurrency
+        int ThreadCount{0};
+    };
+
+    /**
+     * @brief One connected contour of a surface slice.
+     */
+    struct SliceContour
+    {
+        std::vector<Vec3> Points{};
+        // Surface parameters (u, v) of the points
+        std::vector<Eigen::Vector2<Numeric>> Parameters{};
+        // Closed contours do not repeat their first point
+        bool Closed{false};
+    };
+
+    /**
+     * @brief Points where the curve crosses each plane, ordered by curve parameter, one Polyline per level
+     *        in the order of levels. Every Bezier segment of the curve is bounded by the heights of its
+     *        control points, so a level only visits the segments spanning it. There the height
+     *        Normal·X - level w of the homogeneous segment is a polynomial in Bernstein form whose roots
+     *        are isolated by FindBernsteinRoots.
+     */
+    std::vector<Polyline> SliceCurve(const Curve& curve, std::span<const Numeric> levels,
+                                     const SliceOptions& options = {});
+
+    /**
+     * @brief Contours of the surface in each plane, in the order of levels.
+     *        The Bezier patches are planned as for tessellation and the finest resolution of each patch
+     *        column and row makes up one tensor grid of parameters, so neighbouring patches share their
+     *        edge samples. Heights of the grid nodes are evaluated once for all levels. A level only
+     *        visits the cells of patches whose control point heights span it; marching squares there
+     *        yields segments between cell edges, and each edge crossing is solved on the surface to
+     *        the height tolerance. Segments are oriented with the higher side on their left in (u, v)
+     *        and chained into open contours, which run between boundary edges, and closed ones.
+     */
+    std::vector<std::vector<SliceContour>> SliceSurface(const Surface& surface, std::span<const Numeric> levels,
+                                                        const SliceOptions& options = {});
+}
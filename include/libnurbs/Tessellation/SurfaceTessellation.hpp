@@ -0,0 +1,189 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <libnurbs/Core/Grid.hpp>
+#include <libnurbs/Core/TriangleMesh.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Adaptive, crack-free tessellation of one surface, split into phases so patches can be
+     *        processed independently:
+     *        1. PlanPatch picks a grid resolution per Bezier patch. The chordal bound
+     *           (1/8)(M_uu du^2 + 2 M_uv du dv + M_vv dv^2) uses second derivative bounds M taken from
+     *           the second differences of the patch control points; rational patches scale them by
+     *           (w_max / w_min)^2, an estimate rather than a strict bound. The bound is parametric,
+     *           so flat but non-uniformly parameterized patches get refined too. The resolution is
+     *           then doubled while neighbouring vertex normals differ by more than the normal tolerance.
+     *        2. Layout gives every edge between patches the finer resolution of its two patches and
+     *           assigns vertex and triangle ranges, so the exact mesh size is known up front.
+     *        3. EmitPatch writes the vertices a patch owns and its triangles into those ranges. The patch
+     *           grid is zipped to the shared edge vertices, which leaves no T-junctions.
+     *        PlanPatch and EmitPatch of different patches may run concurrently with separate scratch.
+     *        The surface is referenced, not copied: it must outlive the tessellation and stay unchanged,
+     *        except for control point edits followed by Replan.
+     */
+    class SurfaceTessellation
+    {
+    public:
+        SurfaceTessellation(const Surface& surface, const Surface::TessellationOptions& options);
+
+        [[nodiscard]] int PatchCount() const
+        {
+            return m_PatchCountU * m_PatchCountV;
+        }
+
+        [[nodiscard]] int PatchCountU() const
+        {
+            return m_PatchCountU;
+        }
+
+        /**
+         * @brief Parameter rectangle [u0, u1] x [v0, v1] of a patch.
+         */
+        void PatchDomain(int patch, Numeric& u0, Numeric& u1, Numeric& v0, Numeric& v1) const
+        {
+            const int a = patch % m_PatchCountU;
+            const int b = patch / m_PatchCountU;
+            u0 = m_BreakpointsU[a];
+            u1 = m_BreakpointsU[a + 1];
+            v0 = m_BreakpointsV[b];
+            v1 = m_BreakpointsV[b + 1];
+        }
+
+        /**
+         * @brief Grid resolution PlanPatch picked for a patch in u, before Layout balances shared edges.
+         */
+        [[nodiscard]] int PlannedSegmentsU(int patch) const
+        {
+            return m_SegmentsU[patch];
+        }
+
+        [[nodiscard]] int PlannedSegmentsV(int patch) const
+        {
+            return m_SegmentsV[patch];
+        }
+
+        void PlanPatch(int patch, Surface::EvaluationScratch& scratch);
+
+        /**
+         * @brief Resolves edges and mesh ranges, call once all patches are planned.
+         */
+        void Layout();
+
+        [[nodiscard]] int VertexCount() const
+        {
+            return m_VertexCount;
+        }
+
+        [[nodiscard]] int TriangleCount() const
+        {
+            return m_TriangleCount;
+        }
+
+        /**
+         * @param mesh Already resized to VertexCount and TriangleCount.
+         * @param vertex_base Index of the first vertex of this surface in mesh, for meshes shared by surfaces.
+         */
+        void EmitPatch(int patch, TriangleMesh& mesh, Surface::EvaluationScratch& scratch,
+                       int vertex_base = 0) const;
+
+        /**
+         * @brief Tessellation of the same surface at a quarter of the chord tolerance per doubling, laid out.
+         *        Nothing is planned: every patch resolution is doubled (up to MaxSegments), which keeps
+         *        the chordal bound since it falls with the square of the resolution. The grids of this
+         *        tessellation stay nested in the refined one. Call after Layout.
+         */
+        [[nodiscard]] SurfaceTessellation Refined(int doublings = 1) const;
+
+        /**
+         * @brief Like EmitPatch, but vertices that coarse has at the very same parameters are copied
+         *        from coarse_mesh instead of evaluated.
+         * @param coarse Laid out tessellation this one was refined or replanned from, coarse_mesh holds
+         *               its vertices.
+         * @param stale Control points edited since coarse_mesh was emitted: vertices within their
+         *              support are evaluated again.
+         */
+        void EmitPatch(int patch, TriangleMesh& mesh, Surface::EvaluationScratch& scratch,
+                       const SurfaceTessellation& coarse, const TriangleMesh& coarse_mesh,
+                       const GridRegion& stale = {}) const;
+
+        /**
+         * @brief Recomputes the Bezier points and the plan of the patches depending on control points in
+         *        region, after these were edited. Degrees, knots and grid size must be unchanged.
+         *        Call Layout afterwards.
+         * @return The replanned patches.
+         */
+        std::vector<int> Replan(const GridRegion& region, Surface::EvaluationScratch& scratch);
+
+        /**
+         * @brief Homogeneous Bezier points of a patch, laid out as by DecomposeSurface.
+         */
+        [[nodiscard]] std::span<const Vec4> PatchPoints(int patch) const
+        {
+            const int size = (m_Surface->DegreeU + 1) * (m_Surface->DegreeV + 1);
+            return {m_PatchPoints.data() + patch * size, static_cast<size_t>(size)};
+        }
+
+        [[nodiscard]] const Surface::TessellationOptions& Options() const
+        {
+            return m_Options;
+        }
+
+        /**
+         * @brief Bytes held by the decomposition, plan and layout.
+         */
+        [[nodiscard]] size_t MemoryUsage() const;
+
+    private:
+        void EmitPatch(int patch, TriangleMesh& mesh, Surface::EvaluationScratch& scratch, int vertex_base,
+                       const SurfaceTessellation* coarse, const TriangleMesh* coarse_mesh,
+                       const GridRegion& stale) const;
+
+        [[nodiscard]] int InteriorVertexIndex(int patch, int i, int j) const;
+
+        // Grid resolution of a patch including the two forced interior lines of thin patches
+        [[nodiscard]] int InteriorSegmentsU(int patch) const;
+
+        [[nodiscard]] int InteriorSegmentsV(int patch) const;
+
+        [[nodiscard]] bool IsSingleQuad(int patch) const;
+
+        [[nodiscard]] int CornerIndex(int a, int b) const;
+
+        [[nodiscard]] int EdgeUIndex(int a, int b, int k) const;
+
+        [[nodiscard]] int EdgeVIndex(int a, int b, int k) const;
+
+        void EmitVertex(TriangleMesh& mesh, int index, int patch, Numeric u, Numeric v,
+                        Surface::EvaluationScratch& scratch) const;
+
+        const Surface* m_Surface;
+        Surface::TessellationOptions m_Options;
+        int m_PatchCountU{0};
+        int m_PatchCountV{0};
+        std::vector<Vec4> m_PatchPoints{};
+        std::vector<Numeric> m_BreakpointsU{};
+        std::vector<Numeric> m_BreakpointsV{};
+        std::vector<int> m_SpansU{};
+        std::vector<int> m_SpansV{};
+
+        // Planned resolution per patch
+        std::vector<int> m_SegmentsU{};
+        std::vector<int> m_SegmentsV{};
+
+        // Resolution of the edges along u, (m_PatchCountV + 1) rows of m_PatchCountU,
+        // and along v, (m_PatchCountU + 1) columns of m_PatchCountV; their vertex ranges
+        std::vector<int> m_EdgesU{};
+        std::vector<int> m_EdgesV{};
+        std::vector<int> m_EdgeUOffsets{};
+        std::vector<int> m_EdgeVOffsets{};
+        std::vector<int> m_PatchVertexOffsets{};
+        std::vector<int> m_PatchTriangleOffsets{};
+        int m_VertexCount{0};
+        int m_TriangleCount{0};
+    };
+}
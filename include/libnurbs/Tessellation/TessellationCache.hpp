@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include <libnurbs/Core/TriangleMesh.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Tessellation/SurfaceTessellation.hpp>
+
+namespace libnurbs
+{
+    /**
+     * @brief Level of detail cache of surface tessellations.
+     *        Requested tolerances snap to a ladder: level k has the chord tolerance of the coarsest
+     *        options divided by 4^k. A level missing from the cache is refined from the finest coarser
+     *        level cached for that surface (see SurfaceTessellation::Refined), reusing its vertices;
+     *        only without any coarser level the surface is planned from scratch.
+     *        Once the cached meshes and plans exceed the memory budget, the least recently used
+     *        levels are evicted. Surfaces are keyed by address: they must stay alive and unchanged
+     *        while cached, call Invalidate after editing one.
+     */
+    class TessellationCache
+    {
+    public:
+        static constexpr int MAX_LEVEL = 16;
+
+        /**
+         * @param coarsest Options of level 0.
+         * @param memory_budget Bytes the cache may hold, the most recent level is kept regardless.
+         */
+        TessellationCache(const Surface::TessellationOptions& coarsest, size_t memory_budget);
+
+        /**
+         * @brief Mesh of surface with a chord tolerance of at most tolerance (or the finest level).
+         *        The reference stays valid until the next call that changes the cache.
+         */
+        const TriangleMesh& Get(const Surface& surface, Numeric tolerance);
+
+        /**
+         * @brief Ladder level used for tolerance.
+         */
+        [[nodiscard]] int Level(Numeric tolerance) const;
+
+        void Invalidate(const Surface& surface);
+
+        void Clear();
+
+        [[nodiscard]] size_t MemoryUsage() const
+        {
+            return m_MemoryUsage;
+        }
+
+        [[nodiscard]] size_t EntryCount() const
+        {
+            return m_Entries.size();
+        }
+
+        [[nodiscard]] uint64_t HitCount() const
+        {
+            return m_HitCount;
+        }
+
+        [[nodiscard]] uint64_t MissCount() const
+        {
+            return m_MissCount;
+        }
+
+        /**
+         * @brief Misses served by refining a coarser cached level.
+         */
+        [[nodiscard]] uint64_t RefineCount() const
+        {
+            return m_RefineCount;
+        }
+
+    private:
+        using Key = std::pair<const Surface*, int>;
+
+        struct Entry
+        {
+            Key Id;
+            std::unique_ptr<SurfaceTessellation> Tessellation;
+            TriangleMesh Mesh;
+            size_t Bytes;
+        };
+
+        void Insert(Entry entry);
+
+        void Evict(std::map<Key, std::list<Entry>::iterator>::iterator it);
+
+        Surface::TessellationOptions m_Coarsest;
+        size_t m_MemoryBudget;
+        size_t m_MemoryUsage{0};
+        // Most recently used first
+        std::list<Entry> m_Entries{};
+        std::map<Key, std::list<Entry>::iterator> m_Index{};
+        Surface::EvaluationScratch m_Scratch{};
+        uint64_t m_HitCount{0};
+        uint64_t m_MissCount{0};
+        uint64_t m_RefineCount{0};
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <libnurbs/Core/Polyline.hpp>
+#include <libnurbs/Core/TriangleMesh.hpp>
+#include <libnurbs/Curve/Curve.hpp>
+#include <libnurbs/Surface/Surface.hpp>
+#include <libnurbs/Utils/ThreadPool.hpp>
+
+namespace libnurbs
+{
+    struct TessellationSettings
+    {
+        Surface::TessellationOptions SurfaceOptions{};
+        Numeric CurveChordTolerance{1e-3};
+        Numeric CurveAngleTolerance{0};
+        // Patches planned or emitted by one task; smaller balances better, larger schedules less
+        int PatchesPerTask{16};
+    };
+
+    /**
+     * @brief Tessellates whole models on a work-stealing thread pool.
+     *        Every surface is planned and emitted patch range by patch range (see SurfaceTessellation),
+     *        so a single large surface spreads over all workers as well as many small ones do.
+     *        Finished results are handed to the sinks strictly in input order, one call at a time,
+     *        and released right after; the output is identical for any thread count. Inputs are started
+     *        at most twice the thread count ahead of the next one due, which bounds the results held
+     *        back for ordering by that count rather than by the model size.
+     */
+    class TessellationEngine
+    {
+    public:
+        using SurfaceSink = std::function<void(int index, const TriangleMesh& mesh)>;
+        using CurveSink   = std::function<void(int index, const Polyline& polyline)>;
+
+        /**
+         * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+         */
+        explicit TessellationEngine(int thread_count = 0);
+
+        [[nodiscard]] int ThreadCount() const
+        {
+            return m_Pool.ThreadCount();
+        }
+
+        /**
+         * @brief Blocks until every surface and curve has been passed to its sink.
+         *        Sinks run on worker threads; the first exception thrown by a sink or by the
+         *        tessellation is rethrown here.
+         */
+        void Run(std::span<const Surface> surfaces,
+                 std::span<const Curve> curves,
+                 const TessellationSettings& settings,
+                 const SurfaceSink& surface_sink,
+                 const CurveSink& curve_sink = {});
+
+    private:
+        Utils::ThreadPool m_Pool;
+        std::vector<Surface::EvaluationScratch> m_Scratches;
+    };
+}
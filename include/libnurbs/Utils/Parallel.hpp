@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libnurbs::Utils
+{
+    /**
+     * @brief Resolves the number of workers used for count work items.
+     * @param thread_count Requested thread count, values <= 0 mean hardware concurrency.
+     * @param count Number of work items, there is no point in more workers than items.
+     */
+    inline int ResolveThreadCount(int thread_count, int count)
+    {
+        if (thread_count <= 0)
+        {
+            thread_count = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        return std::clamp(thread_count, 1, std::max(count, 1));
+    }
+
+    /**
+     * @brief Calls func(index, worker) for every index in [0, count) using thread_count workers.
+     *        Indices are claimed in chunks from a shared counter, so uneven work balances itself.
+     *        worker lies in [0, thread_count) and is meant to address per-thread scratch memory.
+     *        The calling thread acts as worker 0; the first exception thrown by func is rethrown.
+     */
+    template <typename Func>
+    void ParallelFor(int count, int thread_count, Func&& func, int chunk_size = 64)
+    {
+        if (count <= 0) return;
+        chunk_size = std::max(chunk_size, 1);
+        thread_count = std::clamp(thread_count, 1, (count + chunk_size - 1) / chunk_size);
+        if (thread_count == 1)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                func(i, 0);
+            }
+            return;
+        }
+
+        std::atomic<int> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto run = [&](int worker)
+        {
+            try
+            {
+                while (true)
+                {
+                    int begin = next.fetch_add(chunk_size, std::memory_order_relaxed);
+                    if (begin >= count) break;
+                    int end = std::min(begin + chunk_size, count);
+                    for (int i = begin; i < end; ++i)
+                    {
+                        func(i, worker);
+                    }
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next.store(count, std::memory_order_relaxed);
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(thread_count - 1);
+            for (int worker = 1; worker < thread_count; ++worker)
+            {
+                threads.emplace_back(run, worker);
+            }
+            run(0);
+        }
+
+        if (error) std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libnurbs::Utils
+{
+    /**
+     * @brief Fixed set of worker threads with one task deque each.
+     *        A worker runs its own tasks newest first and, once out of work, steals the oldest task
+     *        of another worker. Tasks submitted from a worker go to that worker's deque, so work that
+     *        spawns more work stays local; tasks from other threads are spread round-robin.
+     *        Tasks receive the index of the worker running them, to address per-thread scratch memory.
+     */
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void(int worker)>;
+
+        /**
+         * @param thread_count Number of workers, values <= 0 mean hardware concurrency.
+         */
+        explicit ThreadPool(int thread_count = 0);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] int ThreadCount() const
+        {
+            return static_cast<int>(m_Threads.size());
+        }
+
+        void Submit(Task task);
+
+        /**
+         * @brief Blocks until every submitted task, including tasks submitted by tasks, has finished.
+         *        Rethrows the first exception a task threw since the last Wait.
+         */
+        void Wait();
+
+    private:
+        struct Queue
+        {
+            std::mutex Mutex;
+            std::deque<Task> Tasks;
+        };
+
+        void Run(int worker);
+
+        bool TryPop(int worker, Task& task);
+
+        std::vector<std::unique_ptr<Queue>> m_Queues{};
+        std::vector<std::jthread> m_Threads{};
+        std::mutex m_Mutex{};
+        std::condition_variable m_WakeUp{};
+        std::condition_variable m_Idle{};
+        std::atomic<int> m_Queued{0};
+        int m_Pending{0};
+        int m_NextQueue{0};
+        bool m_Stop{false};
+        std::exception_ptr m_Error{};
+    };
+}
@@ -8,6 +8,12 @@
 /* Algotithm */
 #include "libnurbs/Algorithm/MathUtils.hpp"
 
+/* Analysis */
+#include "libnurbs/Analysis/Collocation.hpp"
+#include "libnurbs/Analysis/GaussQuadrature.hpp"
+#include "libnurbs/Analysis/MassProperties.hpp"
+#include "libnurbs/Analysis/SurfaceElements.hpp"
+
 /* Basis */
 #include "libnurbs/Basis/BSplineBasis.hpp"
 
@@ -15,15 +21,36 @@
 #include "libnurbs/Core/Typedefs.hpp"
 #include "libnurbs/Core/Grid.hpp"
 #include "libnurbs/Core/KnotVector.hpp"
+#include "libnurbs/Core/Polyline.hpp"
+#include "libnurbs/Core/TriangleMesh.hpp"
 
 /* Geometry */
 #include "libnurbs/Geometry/GeomRect.hpp"
 #include "libnurbs/Geometry/GeomSegment.hpp"
 
 /* Curve */
+#include "libnurbs/Curve/ArcLengthTable.hpp"
 #include "libnurbs/Curve/Curve.hpp"
+#include "libnurbs/Curve/CurveIntersection.hpp"
+#include "libnurbs/Curve/CurvePointInversion.hpp"
+#include "libnurbs/Curve/CurveProjector.hpp"
+#include "libnurbs/Curve/FeedrateInterpolator.hpp"
 
 /* Surface */
 #include "libnurbs/Surface/Surface.hpp"
+#include "libnurbs/Surface/SurfaceBvh.hpp"
+#include "libnurbs/Surface/SurfaceIntersection.hpp"
+#include "libnurbs/Surface/SurfaceProjector.hpp"
+
+/* Scene */
+#include "libnurbs/Scene/SceneBvh.hpp"
+
+/* Tessellation */
+#include "libnurbs/Tessellation/IncrementalTessellation.hpp"
+#include "libnurbs/Tessellation/MeshWriter.hpp"
+#include "libnurbs/Tessellation/PlaneSlicing.hpp"
+#include "libnurbs/Tessellation/SurfaceTessellation.hpp"
+#include "libnurbs/Tessellation/TessellationCache.hpp"
+#include "libnurbs/Tessellation/TessellationEngine.hpp"
 
 #endif //LIBNURBS_LIBNURBS_HPP
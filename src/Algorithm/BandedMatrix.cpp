@@ -0,0 +1,98 @@
+#include "libnurbs/Algorithm/BandedMatrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace libnurbs
+{
+    bool BandedMatrix::FactorizeLU()
+    {
+        auto& a = *this;
+        for (int k = 0; k < m_Size; ++k)
+        {
+            const Numeric pivot = a(k, k);
+            if (pivot == 0) return false;
+            const int last_row = std::min(m_Size - 1, k + m_Lower);
+            const int last_column = std::min(m_Size - 1, k + m_Upper);
+            for (int i = k + 1; i <= last_row; ++i)
+            {
+                const Numeric factor = a(i, k) / pivot;
+                a(i, k) = factor;
+                if (factor == 0) continue;
+                for (int j = k + 1; j <= last_column; ++j)
+                {
+                    a(i, j) -= factor * a(k, j);
+                }
+            }
+        }
+        return true;
+    }
+
+    void BandedMatrix::SolveLU(MatX& rhs) const
+    {
+        const auto& a = *this;
+        for (int i = 0; i < m_Size; ++i)
+        {
+            for (int j = std::max(0, i - m_Lower); j < i; ++j)
+            {
+                rhs.row(i) -= a(i, j) * rhs.row(j);
+            }
+        }
+        for (int i = m_Size - 1; i >= 0; --i)
+        {
+            for (int j = i + 1; j <= std::min(m_Size - 1, i + m_Upper); ++j)
+            {
+                rhs.row(i) -= a(i, j) * rhs.row(j);
+            }
+            rhs.row(i) /= a(i, i);
+        }
+    }
+
+    bool BandedMatrix::FactorizeCholesky()
+    {
+        auto& a = *this;
+        for (int j = 0; j < m_Size; ++j)
+        {
+            const int first = std::max(0, j - m_Lower);
+            Numeric diagonal = a(j, j);
+            for (int k = first; k < j; ++k)
+            {
+                diagonal -= a(j, k) * a(j, k);
+            }
+            if (!(diagonal > 0)) return false;
+            diagonal = std::sqrt(diagonal);
+            a(j, j) = diagonal;
+            for (int i = j + 1; i <= std::min(m_Size - 1, j + m_Lower); ++i)
+            {
+                Numeric value = a(i, j);
+                for (int k = std::max(first, i - m_Lower); k < j; ++k)
+                {
+                    value -= a(i, k) * a(j, k);
+                }
+                a(i, j) = value / diagonal;
+            }
+        }
+        return true;
+    }
+
+    void BandedMatrix::SolveCholesky(MatX& rhs) const
+    {
+        const auto& a = *this;
+        for (int i = 0; i < m_Size; ++i)
+        {
+            for (int j = std::max(0, i - m_Lower); j < i; ++j)
+            {
+                rhs.row(i) -= a(i, j) * rhs.row(j);
+            }
+            rhs.row(i) /= a(i, i);
+        }
+        for (int i = m_Size - 1; i >= 0; --i)
+        {
+            for (int j = i + 1; j <= std::min(m_Size - 1, i + m_Lower); ++j)
+            {
+                rhs.row(i) -= a(j, i) * rhs.row(j);
+            }
+            rhs.row(i) /= a(i, i);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#include "libnurbs/Algorithm/Bernstein.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+    using namespace libnurbs;
+
+    using Buffer = std::array<Numeric, MAX_BERNSTEIN_DEGREE + 1>;
+
+    // Beyond this depth intervals are far below any meaningful tolerance.
+    constexpr int MAX_DEPTH{64};
+
+    Numeric Binomial(int n, int k)
+    {
+        Numeric result = 1;
+        for (int i = 1; i <= k; i++)
+        {
+            result = result * (n - k + i) / i;
+        }
+        return result;
+    }
+
+    int SignVariation(const Numeric* c, int count)
+    {
+        int variation = 0;
+        Numeric last = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (c[i] == 0) continue;
+            if (last != 0 && (c[i] > 0) != (last > 0)) variation++;
+            last = c[i];
+        }
+        return variation;
+    }
+
+    // Splits c at t = 0.5, left and right receive the coefficients of both halves.
+    void Subdivide(const Numeric* c, int count, Numeric* left, Numeric* right)
+    {
+        Buffer temp;
+        std::copy(c, c + count, temp.begin());
+        for (int k = 0; k < count; k++)
+        {
+            left[k] = temp[0];
+            right[count - 1 - k] = temp[count - 1 - k];
+            for (int i = 0; i < count - 1 - k; i++)
+            {
+                temp[i] = 0.5 * (temp[i] + temp[i + 1]);
+            }
+        }
+    }
+
+    // Illinois variant of regula falsi for a single sign change on [0, 1].
+    // sign0 and sign1 are the signs next to the ends, ends that are roots themselves fall back to bisection.
+    Numeric SolveSingleRoot(std::span<const Numeric> c, Numeric sign0, Numeric sign1, Numeric tolerance)
+    {
+        bool bisect = c.front() == 0 || c.back() == 0;
+        Numeric a = 0, fa = bisect ? sign0 : c.front();
+        Numeric b = 1, fb = bisect ? sign1 : c.back();
+        int side = 0;
+        for (int i = 0; i < 100 && b - a > tolerance; i++)
+        {
+            Numeric t = bisect ? 0.5 * (a + b) : (a * fb - b * fa) / (fb - fa);
+            Numeric ft = BernsteinEvaluate(c, t);
+            if (ft == 0) return t;
+            if ((ft > 0) == (fb > 0))
+            {
+                b = t;
+                fb = ft;
+                if (side == -1 && !bisect) fa *= 0.5;
+                side = -1;
+            }
+            else
+            {
+                a = t;
+                fa = ft;
+                if (side == 1 && !bisect) fb *= 0.5;
+                side = 1;
+            }
+        }
+        return std::abs(fa) < std::abs(fb) ? a : b;
+    }
+
+    // push(t) receives the roots in ascending order.
+    template <typename Push>
+    void Isolate(const Numeric* c, int count, Numeric t0, Numeric t1, Numeric tolerance, int depth, Push& push)
+    {
+        // The right end is the left end of the next interval, only the left one is reported.
+        if (c[0] == 0) push(t0);
+
+        int variation = SignVariation(c, count);
+        if (variation == 0) return;
+
+        if (variation == 1)
+        {
+            // One sign change bounds the roots inside the interval to one, and there is one.
+            Numeric sign0 = *std::find_if(c, c + count, [](Numeric x) { return x != 0; }) > 0 ? 1 : -1;
+            Numeric s = SolveSingleRoot({c, static_cast<size_t>(count)}, sign0, -sign0, tolerance / (t1 - t0));
+            push(t0 + (t1 - t0) * s);
+            return;
+        }
+
+        Numeric mid = 0.5 * (t0 + t1);
+        if (t1 - t0 <= tolerance || depth >= MAX_DEPTH)
+        {
+            push(mid);
+            return;
+        }
+
+        Buffer left, right;
+        Subdivide(c, count, left.data(), right.data());
+        Isolate(left.data(), count, t0, mid, tolerance, depth + 1, push);
+        Isolate(right.data(), count, mid, t1, tolerance, depth + 1, push);
+    }
+
+    // Removes roots within tolerance of the previous one in place and returns how many remain.
+    // A root on a subdivision point is found from both sides.
+    size_t RemoveCloseRoots(Numeric* roots, size_t count, Numeric tolerance)
+    {
+        size_t last = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (last == 0 || roots[i] - roots[last - 1] > tolerance)
+            {
+                roots[last++] = roots[i];
+            }
+        }
+        return last;
+    }
+}
+
+namespace libnurbs
+{
+    void BernsteinMultiply(std::span<const Numeric> a, std::span<const Numeric> b, std::span<Numeric> result)
+    {
+        const int m = static_cast<int>(a.size()) - 1;
+        const int n = static_cast<int>(b.size()) - 1;
+        assert(static_cast<int>(result.size()) == m + n + 1);
+        for (int k = 0; k <= m + n; k++)
+        {
+            Numeric sum = 0;
+            for (int i = std::max(0, k - n); i <= std::min(m, k); i++)
+            {
+                sum += Binomial(m, i) * Binomial(n, k - i) * a[i] * b[k - i];
+            }
+            result[k] = sum / Binomial(m + n, k);
+        }
+    }
+
+    Numeric BernsteinEvaluate(std::span<const Numeric> coefficients, Numeric t)
+    {
+        const int count = static_cast<int>(coefficients.size());
+        assert(count > 0 && count <= MAX_BERNSTEIN_DEGREE + 1);
+        Buffer temp;
+        std::copy(coefficients.begin(), coefficients.end(), temp.begin());
+        for (int k = 1; k < count; k++)
+        {
+            for (int i = 0; i < count - k; i++)
+            {
+                temp[i] = (1.0 - t) * temp[i] + t * temp[i + 1];
+            }
+        }
+        return temp[0];
+    }
+
+    void FindBernsteinRoots(std::span<const Numeric> coefficients, Numeric tolerance, std::vector<Numeric>& roots)
+    {
+        const int count = static_cast<int>(coefficients.size());
+        assert(count > 0 && count <= MAX_BERNSTEIN_DEGREE + 1);
+        const size_t first = roots.size();
+        auto push = [&](Numeric t) { roots.push_back(t); };
+        Isolate(coefficients.data(), count, 0, 1, tolerance, 0, push);
+        if (coefficients.back() == 0) push(1);
+        roots.resize(first + RemoveCloseRoots(roots.data() + first, roots.size() - first, tolerance));
+    }
+
+    int FindBernsteinRoots(std::span<const Numeric> coefficients, Numeric tolerance, std::span<Numeric> roots)
+    {
+        const int count = static_cast<int>(coefficients.size());
+        assert(count > 0 && count <= MAX_BERNSTEIN_DEGREE + 1);
+        size_t size = 0;
+        auto push = [&](Numeric t)
+        {
+            if (size < roots.size()) roots[size++] = t;
+        };
+        Isolate(coefficients.data(), count, 0, 1, tolerance, 0, push);
+        if (coefficients.back() == 0) push(1);
+        return static_cast<int>(RemoveCloseRoots(roots.data(), size, tolerance));
+    }
+}
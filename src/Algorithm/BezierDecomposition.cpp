@@ -0,0 +1,194 @@
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "libnurbs/Core/Grid.hpp"
+#include "libnurbs/Core/KnotVector.hpp"
+
+namespace
+{
+    using namespace libnurbs;
+
+    constexpr int MAX_BLOSSOM_DEGREE = 31;
+
+    // Bezier points of span [U[span], U[span + 1]] from the degree + 1 points of that span:
+    // point k is the blossom f(U[span] (degree - k times), U[span + 1] (k times)), evaluated
+    // by de Boor's algorithm with one argument per level.
+    void BlossomSpan(int degree, const std::vector<Numeric>& U, int span, const Vec4* points,
+                     Vec4* bezier, int bezier_stride)
+    {
+        const int p = degree;
+        Vec4 d[MAX_BLOSSOM_DEGREE + 1];
+        for (int k = 0; k <= p; ++k)
+        {
+            for (int i = 0; i <= p; ++i) d[i] = points[i];
+            for (int r = 1; r <= p; ++r)
+            {
+                const Numeric t = r <= p - k ? U[span] : U[span + 1];
+                for (int i = p; i >= r; --i)
+                {
+                    const int g = span - p + i;
+                    const Numeric alpha = (t - U[g]) / (U[g + p + 1 - r] - U[g]);
+                    d[i] = (1.0 - alpha) * d[i - 1] + alpha * d[i];
+                }
+            }
+            bezier[k * bezier_stride] = d[p];
+        }
+    }
+}
+
+namespace libnurbs
+{
+    int DecomposeCurve(int degree,
+                       const KnotVector& knot_vector,
+                       std::span<const Vec4> points,
+                       std::vector<Vec4>& bezier_points,
+                       std::vector<Numeric>& breakpoints)
+    {
+        const auto& U = knot_vector.Values();
+        const int p = degree;
+        const int n = static_cast<int>(points.size()) - 1;
+        const int m = n + p + 1;
+        assert(knot_vector.Count() == m + 1);
+
+        bezier_points.clear();
+        breakpoints.clear();
+        bezier_points.reserve((m - 2 * p) * (p + 1));
+
+        std::vector<Numeric> alphas(std::max(p - 1, 1));
+
+        int a = p;
+        int b = p + 1;
+        int nb = 0;
+        bezier_points.insert(bezier_points.end(), points.begin(), points.begin() + p + 1);
+        breakpoints.push_back(U[a]);
+
+        while (b < m)
+        {
+            int i = b;
+            while (b < m && U[b + 1] == U[b]) b++;
+            int mult = b - i + 1;
+            bool has_next = b < m;
+            if (has_next) bezier_points.resize((nb + 2) * (p + 1));
+            Vec4* Q = bezier_points.data() + nb * (p + 1);
+            Vec4* next = Q + (p + 1);
+
+            if (mult < p)
+            {
+                Numeric numer = U[b] - U[a];
+                for (int j = p; j > mult; j--)
+                {
+                    alphas[j - mult - 1] = numer / (U[a + j] - U[a]);
+                }
+                // Insert the knot r times
+                int r = p - mult;
+                for (int j = 1; j <= r; j++)
+                {
+                    int save = r - j;
+                    int s = mult + j;
+                    for (int k = p; k >= s; k--)
+                    {
+                        Numeric alpha = alphas[k - s];
+                        Q[k] = alpha * Q[k] + (1.0 - alpha) * Q[k - 1];
+                    }
+                    // Control point of the next segment
+                    if (has_next) next[save] = Q[p];
+                }
+            }
+
+            breakpoints.push_back(U[b]);
+            nb++;
+            if (has_next)
+            {
+                // Knots of multiplicity above degree leave the segments disconnected.
+                for (int k = std::max(p - mult, 0); k <= p; k++)
+                {
+                    next[k] = points[b - p + k];
+                }
+                a = b;
+                b++;
+            }
+        }
+        return nb;
+    }
+
+    void DecomposeSurface(int degree_u,
+                          int degree_v,
+                          const KnotVector& knot_vector_u,
+                          const KnotVector& knot_vector_v,
+                          const Grid<Vec4>& points,
+                          std::vector<Vec4>& patch_points,
+                          std::vector<Numeric>& breakpoints_u,
+                          std::vector<Numeric>& breakpoints_v)
+    {
+        const int p = degree_u;
+        const int q = degree_v;
+
+        // Rows in u: rows[j] holds the Bezier points of row j, count_u * (p + 1) of them
+        std::vector<Vec4> row, bezier_row;
+        std::vector<Vec4> rows;
+        int count_u = 0;
+        for (int j = 0; j < points.VCount; ++j)
+        {
+            row.assign(points.Values.begin() + j * points.UCount, points.Values.begin() + (j + 1) * points.UCount);
+            count_u = DecomposeCurve(p, knot_vector_u, row, bezier_row, breakpoints_u);
+            rows.insert(rows.end(), bezier_row.begin(), bezier_row.end());
+        }
+        const int width = count_u * (p + 1);
+
+        // Columns in v
+        std::vector<Vec4> column(points.VCount), bezier_column;
+        int count_v = 0;
+        for (int c = 0; c < width; ++c)
+        {
+            for (int j = 0; j < points.VCount; ++j)
+            {
+                column[j] = rows[j * width + c];
+            }
+            count_v = DecomposeCurve(q, knot_vector_v, column, bezier_column, breakpoints_v);
+            if (c == 0)
+            {
+                patch_points.assign(count_u * count_v * (p + 1) * (q + 1), Vec4::Zero());
+            }
+
+            int a = c / (p + 1);
+            int i = c % (p + 1);
+            for (int b = 0; b < count_v; ++b)
+            {
+                Vec4* patch = patch_points.data() + (b * count_u + a) * (p + 1) * (q + 1);
+                for (int k = 0; k <= q; ++k)
+                {
+                    patch[k * (p + 1) + i] = bezier_column[b * (q + 1) + k];
+                }
+            }
+        }
+    }
+
+    void ExtractBezierPatch(int degree_u,
+                            int degree_v,
+                            const KnotVector& knot_vector_u,
+                            const KnotVector& knot_vector_v,
+                            int span_u,
+                            int span_v,
+                            const Grid<Vec4>& local_points,
+                            Vec4* patch)
+    {
+        const int p = degree_u;
+        const int q = degree_v;
+        assert(p <= MAX_BLOSSOM_DEGREE && q <= MAX_BLOSSOM_DEGREE);
+        assert(local_points.UCount == p + 1 && local_points.VCount == q + 1);
+
+        // Rows in u into the patch, then the patch columns in place in v
+        Vec4 column[MAX_BLOSSOM_DEGREE + 1];
+        for (int j = 0; j <= q; ++j)
+        {
+            BlossomSpan(p, knot_vector_u.Values(), span_u, &local_points.Get(0, j), patch + j * (p + 1), 1);
+        }
+        for (int i = 0; i <= p; ++i)
+        {
+            for (int j = 0; j <= q; ++j) column[j] = patch[j * (p + 1) + i];
+            BlossomSpan(q, knot_vector_v.Values(), span_v, column, patch + i, p + 1);
+        }
+    }
+}
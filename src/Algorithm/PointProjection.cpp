@@ -0,0 +1,298 @@
+#include "libnurbs/Algorithm/PointProjection.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    using namespace libnurbs;
+
+    // Non-empty spans of a knot vector, as (span index, lower knot, upper knot).
+    struct SpanInfo
+    {
+        int Index;
+        Numeric Low;
+        Numeric High;
+    };
+
+    std::vector<SpanInfo> NonEmptySpans(const KnotVector& knot_vector, int degree)
+    {
+        const auto& knots = knot_vector.Values();
+        std::vector<SpanInfo> spans;
+        for (int i = degree; i + 1 < knot_vector.Count() - degree; ++i)
+        {
+            if (knots[i] < knots[i + 1])
+            {
+                spans.push_back({i, knots[i], knots[i + 1]});
+            }
+        }
+        return spans;
+    }
+
+    Numeric Lerp(Numeric low, Numeric high, int k, int count)
+    {
+        return k == count - 1 ? high : low + (high - low) * k / (count - 1);
+    }
+}
+
+namespace libnurbs
+{
+    ProjectionSeeds BuildProjectionSeeds(const Curve& curve, int samples_per_span)
+    {
+        assert(samples_per_span >= 2);
+        const int p = curve.Degree;
+        auto spans = NonEmptySpans(curve.Knots, p);
+
+        ProjectionSeeds seeds;
+        seeds.SamplesPerSpan = samples_per_span;
+        seeds.SpanBoxes.reserve(spans.size());
+        seeds.Points.reserve(spans.size() * samples_per_span);
+        seeds.ParametersU.reserve(spans.size() * samples_per_span);
+
+        Curve::EvaluationScratch scratch;
+        for (const auto& span : spans)
+        {
+            const auto& first = curve.ControlPoints[span.Index - p];
+            BoundingBox box(first.head<3>(), first.head<3>());
+            for (int i = span.Index - p + 1; i <= span.Index; ++i)
+            {
+                box.ExpandToInclude(Vec3(curve.ControlPoints[i].head<3>()));
+            }
+            seeds.SpanBoxes.push_back(box);
+
+            for (int k = 0; k < samples_per_span; ++k)
+            {
+                Numeric u = Lerp(span.Low, span.High, k, samples_per_span);
+                seeds.ParametersU.push_back(u);
+                seeds.Points.push_back(curve.EvaluateAll(u, 0, scratch, span.Index)[0]);
+            }
+        }
+        return seeds;
+    }
+
+    ProjectionSeeds BuildProjectionSeeds(const Surface& surface, int samples_per_span)
+    {
+        assert(samples_per_span >= 2);
+        const int p = surface.DegreeU;
+        const int q = surface.DegreeV;
+        auto spans_u = NonEmptySpans(surface.KnotsU, p);
+        auto spans_v = NonEmptySpans(surface.KnotsV, q);
+        const int span_count = (int)(spans_u.size() * spans_v.size());
+        const int samples = samples_per_span * samples_per_span;
+
+        ProjectionSeeds seeds;
+        seeds.SamplesPerSpan = samples;
+        seeds.SpanBoxes.reserve(span_count);
+        seeds.Points.reserve(span_count * samples);
+        seeds.ParametersU.reserve(span_count * samples);
+        seeds.ParametersV.reserve(span_count * samples);
+
+        Surface::EvaluationScratch scratch;
+        for (const auto& span_v : spans_v)
+        {
+            for (const auto& span_u : spans_u)
+            {
+                const auto& first = surface.ControlPoints.Get(span_u.Index - p, span_v.Index - q);
+                BoundingBox box(first.head<3>(), first.head<3>());
+                for (int j = span_v.Index - q; j <= span_v.Index; ++j)
+                {
+                    for (int i = span_u.Index - p; i <= span_u.Index; ++i)
+                    {
+                        box.ExpandToInclude(Vec3(surface.ControlPoints.Get(i, j).head<3>()));
+                    }
+                }
+                seeds.SpanBoxes.push_back(box);
+
+                for (int l = 0; l < samples_per_span; ++l)
+                {
+                    Numeric v = Lerp(span_v.Low, span_v.High, l, samples_per_span);
+                    for (int k = 0; k < samples_per_span; ++k)
+                    {
+                        Numeric u = Lerp(span_u.Low, span_u.High, k, samples_per_span);
+                        seeds.ParametersU.push_back(u);
+                        seeds.ParametersV.push_back(v);
+                        const auto& ders = surface.EvaluateAll(u, v, 0, 0, scratch, span_u.Index, span_v.Index);
+                        seeds.Points.push_back(ders.Get(0, 0));
+                    }
+                }
+            }
+        }
+        return seeds;
+    }
+
+    int FindNearestSeed(const ProjectionSeeds& seeds, const Vec3& point)
+    {
+        const int span_count = (int)seeds.SpanBoxes.size();
+        const int samples = seeds.SamplesPerSpan;
+        assert(span_count > 0);
+
+        // Start from the span whose box is closest, its samples give a tight upper bound early.
+        int first_span = 0;
+        Numeric first_bound = std::numeric_limits<Numeric>::max();
+        for (int s = 0; s < span_count; ++s)
+        {
+            Numeric bound = seeds.SpanBoxes[s].SquaredDistance(point);
+            if (bound < first_bound)
+            {
+                first_bound = bound;
+                first_span = s;
+            }
+        }
+
+        int best = INVALID_INDEX;
+        Numeric best_distance = std::numeric_limits<Numeric>::max();
+        auto visit = [&](int s)
+        {
+            for (int k = s * samples; k < (s + 1) * samples; ++k)
+            {
+                Numeric distance = (seeds.Points[k] - point).squaredNorm();
+                if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best = k;
+                }
+            }
+        };
+
+        visit(first_span);
+        for (int s = 0; s < span_count; ++s)
+        {
+            if (s != first_span && seeds.SpanBoxes[s].SquaredDistance(point) < best_distance)
+            {
+                visit(s);
+            }
+        }
+        return best;
+    }
+
+    int FindNearestSeed(const ProjectionSeeds& seeds, const SurfaceBvh& bvh, const Vec3& point)
+    {
+        const int samples = seeds.SamplesPerSpan;
+        assert(bvh.PatchCount() == (int)seeds.SpanBoxes.size());
+
+        int best = INVALID_INDEX;
+        Numeric best_distance = std::numeric_limits<Numeric>::max();
+        bvh.TraverseNearest(point, [&](int s, Numeric)
+        {
+            for (int k = s * samples; k < (s + 1) * samples; ++k)
+            {
+                Numeric distance = (seeds.Points[k] - point).squaredNorm();
+                if (distance < best_distance)
+                {
+                    best_distance = distance;
+                    best = k;
+                }
+            }
+            return best_distance;
+        });
+        return best;
+    }
+
+    bool RefineProjection(const Curve& curve, const Vec3& point, Numeric& u, int& index_span, Vec3& closest,
+                          Curve::EvaluationScratch& scratch, Numeric epsilon, int max_iteration_count)
+    {
+        auto evaluate = [&](int order)
+        {
+            index_span = curve.Knots.FindSpanIndex(curve.Degree, u, index_span);
+            return curve.EvaluateAll(u, order, scratch, index_span);
+        };
+
+        for (int count = 0; count < max_iteration_count; ++count)
+        {
+            auto ders = evaluate(2);
+            closest = ders[0];
+            Vec3 diff = ders[0] - point;
+            Numeric distance = diff.norm();
+            // Point coincidence
+            if (distance <= epsilon) return true;
+
+            // Zero cosine
+            Numeric f = ders[1].dot(diff);
+            Numeric speed2 = ders[1].squaredNorm();
+            if (std::abs(f) <= epsilon * std::sqrt(speed2) * distance) return true;
+            if (speed2 == 0) return false;
+
+            // Away from a minimum the Newton step may head uphill, fall back to a gradient step there.
+            Numeric df = ders[2].dot(diff) + speed2;
+            Numeric step = df > 0 ? f / df : f / speed2;
+            Numeric u_new = std::clamp(u - step, Numeric(0), Numeric(1));
+
+            // Parameter no longer changes significantly, including steps clamped at the ends.
+            if (std::abs(u_new - u) * std::sqrt(speed2) <= epsilon)
+            {
+                u = u_new;
+                closest = evaluate(0)[0];
+                return true;
+            }
+            u = u_new;
+        }
+        closest = evaluate(0)[0];
+        return false;
+    }
+
+    bool RefineProjection(const Surface& surface, const Vec3& point, Numeric& u, Numeric& v,
+                          int& index_span_u, int& index_span_v, Vec3& closest,
+                          Surface::EvaluationScratch& scratch, Numeric epsilon, int max_iteration_count)
+    {
+        using Vec2 = Eigen::Vector2<Numeric>;
+        using Mat2x2 = Eigen::Matrix<Numeric, 2, 2>;
+
+        auto evaluate = [&](int order) -> const Grid<Vec3>&
+        {
+            index_span_u = surface.KnotsU.FindSpanIndex(surface.DegreeU, u, index_span_u);
+            index_span_v = surface.KnotsV.FindSpanIndex(surface.DegreeV, v, index_span_v);
+            return surface.EvaluateAll(u, v, order, order, scratch, index_span_u, index_span_v);
+        };
+
+        for (int count = 0; count < max_iteration_count; ++count)
+        {
+            const auto& ders = evaluate(2);
+            const Vec3& S = ders.Get(0, 0);
+            const Vec3& Su = ders.Get(1, 0);
+            const Vec3& Sv = ders.Get(0, 1);
+            closest = S;
+            Vec3 r = S - point;
+            Numeric distance = r.norm();
+            // Point coincidence
+            if (distance <= epsilon) return true;
+
+            // Zero cosine in both directions
+            Vec2 g{r.dot(Su), r.dot(Sv)};
+            if (std::abs(g.x()) <= epsilon * Su.norm() * distance &&
+                std::abs(g.y()) <= epsilon * Sv.norm() * distance)
+            {
+                return true;
+            }
+
+            Mat2x2 gauss_newton;
+            gauss_newton << Su.dot(Su), Su.dot(Sv),
+                            Su.dot(Sv), Sv.dot(Sv);
+            Mat2x2 J = gauss_newton;
+            J(0, 0) += r.dot(ders.Get(2, 0));
+            J(0, 1) += r.dot(ders.Get(1, 1));
+            J(1, 0) += r.dot(ders.Get(1, 1));
+            J(1, 1) += r.dot(ders.Get(0, 2));
+
+            // Away from a minimum the Hessian is indefinite, fall back to the Gauss-Newton matrix there.
+            if (J(0, 0) <= 0 || J.determinant() <= 0) J = gauss_newton;
+            if (J.determinant() <= 0) return false;
+            Vec2 delta = -J.inverse() * g;
+
+            Numeric u_new = std::clamp(u + delta.x(), Numeric(0), Numeric(1));
+            Numeric v_new = std::clamp(v + delta.y(), Numeric(0), Numeric(1));
+
+            // Parameters no longer change significantly, including steps clamped at the boundary.
+            if (((u_new - u) * Su + (v_new - v) * Sv).norm() <= epsilon)
+            {
+                u = u_new;
+                v = v_new;
+                closest = evaluate(0).Get(0, 0);
+                return true;
+            }
+            u = u_new;
+            v = v_new;
+        }
+        closest = evaluate(0).Get(0, 0);
+        return false;
+    }
+}
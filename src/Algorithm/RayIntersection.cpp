@@ -0,0 +1,289 @@
+#include "libnurbs/Algorithm/RayIntersection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "libnurbs/Algorithm/Bernstein.hpp"
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+
+namespace
+{
+    using namespace libnurbs;
+    using Vec2 = Eigen::Vector2<Numeric>;
+
+    // Clipping hands a piece to Newton once it is this small in both directions, in patch parameters.
+    constexpr Numeric CLIP_TOLERANCE = 1e-4;
+    // Halvings per patch; depth first, so the arena holds at most one pending piece per level.
+    constexpr int MAX_SPLIT_DEPTH = 32;
+    // Clips per piece, guards against rays grazing the patch where clipping converges slowly.
+    constexpr int MAX_CLIP_COUNT = 64;
+    constexpr int NEWTON_ITERATION_COUNT = 16;
+
+    struct Piece
+    {
+        Numeric U0, U1, V0, V1;
+        int Depth;
+    };
+
+    // Range of x where the convex hull of the points (i / degree, d), d in [lo_i, hi_i], meets d = 0.
+    bool HullInterval(const Numeric* lo, const Numeric* hi, int degree, Numeric& s0, Numeric& s1)
+    {
+        s0 = std::numeric_limits<Numeric>::max();
+        s1 = -std::numeric_limits<Numeric>::max();
+        auto include = [&](Numeric x)
+        {
+            s0 = std::min(s0, x);
+            s1 = std::max(s1, x);
+        };
+        auto cross = [&](Numeric xa, Numeric ya, Numeric xb, Numeric yb)
+        {
+            if ((ya < 0 && yb > 0) || (ya > 0 && yb < 0)) include(xa + (xb - xa) * ya / (ya - yb));
+        };
+        for (int i = 0; i <= degree; ++i)
+        {
+            Numeric xi = Numeric(i) / degree;
+            if (lo[i] <= 0 && hi[i] >= 0) include(xi);
+            for (int j = i + 1; j <= degree; ++j)
+            {
+                Numeric xj = Numeric(j) / degree;
+                cross(xi, lo[i], xj, lo[j]);
+                cross(xi, lo[i], xj, hi[j]);
+                cross(xi, hi[i], xj, lo[j]);
+                cross(xi, hi[i], xj, hi[j]);
+            }
+        }
+        s0 = std::max(s0, Numeric(0));
+        s1 = std::min(s1, Numeric(1));
+        return s0 <= s1;
+    }
+
+    /**
+     * Clips the piece in one direction against the line through the origin along which the control
+     * net runs in the other direction. Points are indexed j * (p + 1) + i, i in the clipped direction
+     * when along_u, else swapped.
+     */
+    bool Clip(Vec2* points, int p, int q, bool along_u, Numeric& s0, Numeric& s1)
+    {
+        const int degree = along_u ? p : q;
+        const int lines  = along_u ? q + 1 : p + 1;
+        const int step   = along_u ? 1 : p + 1;
+        const int pitch  = along_u ? p + 1 : 1;
+
+        Vec2 axis = Vec2::Zero();
+        for (int i = 0; i <= degree; ++i)
+        {
+            axis += points[(lines - 1) * pitch + i * step] - points[i * step];
+        }
+        // Any line through the origin is valid; along the other direction, distances vary with the clipped parameter.
+        // Once the other direction has collapsed, the line across the chord of the clipped direction does.
+        Vec2 normal{1, 0};
+        if (axis.squaredNorm() > 0)
+        {
+            normal = {-axis.y(), axis.x()};
+        }
+        else
+        {
+            Vec2 chord = Vec2::Zero();
+            for (int line = 0; line < lines; ++line)
+            {
+                chord += points[line * pitch + degree * step] - points[line * pitch];
+            }
+            if (chord.squaredNorm() > 0) normal = chord;
+        }
+
+        Numeric lo[MAX_BERNSTEIN_DEGREE + 1], hi[MAX_BERNSTEIN_DEGREE + 1];
+        for (int i = 0; i <= degree; ++i)
+        {
+            lo[i] = std::numeric_limits<Numeric>::max();
+            hi[i] = -std::numeric_limits<Numeric>::max();
+            for (int line = 0; line < lines; ++line)
+            {
+                Numeric d = normal.dot(points[line * pitch + i * step]);
+                lo[i] = std::min(lo[i], d);
+                hi[i] = std::max(hi[i], d);
+            }
+        }
+        if (!HullInterval(lo, hi, degree, s0, s1)) return false;
+        for (int line = 0; line < lines; ++line)
+        {
+            RestrictBezier(points + line * pitch, degree, step, s0, s1);
+        }
+        return true;
+    }
+
+    // Newton on S(u, v) - origin - t * direction = 0 inside the patch domain, until the residual is within tolerance.
+    bool RefineRayHit(const Surface& surface, const Vec3& origin, const Vec3& direction,
+                      Numeric u_low, Numeric u_high, Numeric v_low, Numeric v_high,
+                      Numeric& u, Numeric& v, Numeric& t, Vec3& point,
+                      Surface::EvaluationScratch& scratch, Numeric tolerance)
+    {
+        int index_span_u = INVALID_INDEX, index_span_v = INVALID_INDEX;
+        bool first = true;
+        for (int count = 0; count < NEWTON_ITERATION_COUNT; ++count)
+        {
+            index_span_u = surface.KnotsU.FindSpanIndex(surface.DegreeU, u, index_span_u);
+            index_span_v = surface.KnotsV.FindSpanIndex(surface.DegreeV, v, index_span_v);
+            const auto& ders = surface.EvaluateAll(u, v, 1, 1, scratch, index_span_u, index_span_v);
+            point = ders.Get(0, 0);
+            if (first)
+            {
+                t = direction.dot(point - origin) / direction.squaredNorm();
+                first = false;
+            }
+            Vec3 residual = point - origin - t * direction;
+            if (residual.norm() <= tolerance) return true;
+
+            Mat3x3 J;
+            J << ders.Get(1, 0), ders.Get(0, 1), -direction;
+            auto lu = J.partialPivLu();
+            if (!(std::abs(lu.determinant()) > 0)) return false;
+            Vec3 delta = lu.solve(-residual);
+            u = std::clamp(u + delta.x(), u_low, u_high);
+            v = std::clamp(v + delta.y(), v_low, v_high);
+            t += delta.z();
+        }
+        return false;
+    }
+}
+
+namespace libnurbs
+{
+    bool IntersectRayPatch(const Surface& surface, const SurfaceBvh& bvh, int patch,
+                           const Vec3& origin, const Vec3& direction, Numeric t_max,
+                           Surface::RayHit& hit, RayIntersectionScratch& scratch, Numeric epsilon)
+    {
+        const int p = surface.DegreeU;
+        const int q = surface.DegreeV;
+        const int size = (p + 1) * (q + 1);
+
+        // Two planes through the ray: their signed distances vanish together exactly on the ray.
+        // For homogeneous points the distances n·X - w (n·origin) are polynomial Bezier functions.
+        Vec3 unit = direction.normalized();
+        Vec3 n1 = unit.unitOrthogonal();
+        Vec3 n2 = unit.cross(n1);
+        const Numeric c1 = n1.dot(origin), c2 = n2.dot(origin);
+
+        scratch.Coefficients.resize((MAX_SPLIT_DEPTH + 1) * size);
+        Vec2* arena = scratch.Coefficients.data();
+        auto points = bvh.PatchPoints(patch);
+        for (int k = 0; k < size; ++k)
+        {
+            const Vec4& P = points[k];
+            arena[k] = Vec2{n1.dot(P.head<3>()) - P.w() * c1, n2.dot(P.head<3>()) - P.w() * c2};
+        }
+        Numeric u_low, u_high, v_low, v_high;
+        bvh.PatchDomain(patch, u_low, u_high, v_low, v_high);
+        // epsilon is relative to the patch, so the hit test holds at any model scale.
+        const BoundingBox& box = bvh.PatchBox(patch);
+        const Numeric diagonal = (box.Max - box.Min).norm();
+        const Numeric tolerance = diagonal > 0 ? epsilon * diagonal : epsilon;
+
+        bool updated = false;
+        Piece stack[MAX_SPLIT_DEPTH + 1];
+        int top = 0;
+        stack[top++] = {0, 1, 0, 1, 0};
+        while (top > 0)
+        {
+            Piece& piece = stack[top - 1];
+            Vec2* Q = arena + (top - 1) * size;
+            bool finished = false, split = false;
+            for (int clip = 0; clip < MAX_CLIP_COUNT && !finished && !split; ++clip)
+            {
+                // A direction already within tolerance is left alone: its polygon may have collapsed
+                // onto the root, and rounding would then clip the root away.
+                Numeric su0 = 0, su1 = 1, sv0 = 0, sv1 = 1;
+                if ((piece.U1 - piece.U0 > CLIP_TOLERANCE && !Clip(Q, p, q, true, su0, su1)) ||
+                    (piece.V1 - piece.V0 > CLIP_TOLERANCE && !Clip(Q, p, q, false, sv0, sv1)))
+                {
+                    top--;
+                    break;
+                }
+                Numeric width_u = piece.U1 - piece.U0, width_v = piece.V1 - piece.V0;
+                piece.U1 = piece.U0 + su1 * width_u;
+                piece.U0 = piece.U0 + su0 * width_u;
+                piece.V1 = piece.V0 + sv1 * width_v;
+                piece.V0 = piece.V0 + sv0 * width_v;
+
+                finished = (piece.U1 - piece.U0 <= CLIP_TOLERANCE && piece.V1 - piece.V0 <= CLIP_TOLERANCE) ||
+                           piece.Depth >= MAX_SPLIT_DEPTH || clip + 1 == MAX_CLIP_COUNT;
+                // Several roots, or a slow clip: halve the longer side, the upper half is clipped first.
+                split = !finished && su1 - su0 > 0.8 && sv1 - sv0 > 0.8;
+            }
+            if (finished)
+            {
+                Numeric u = u_low + (u_high - u_low) * (piece.U0 + piece.U1) / 2;
+                Numeric v = v_low + (v_high - v_low) * (piece.V0 + piece.V1) / 2;
+                Numeric t;
+                Vec3 point;
+                if (RefineRayHit(surface, origin, direction, u_low, u_high, v_low, v_high, u, v, t, point,
+                                 scratch.Evaluation, tolerance) &&
+                    t >= 0 && t <= t_max && (!hit.Hit || t < hit.T))
+                {
+                    hit = {u, v, t, point, true};
+                    updated = true;
+                }
+                top--;
+            }
+            else if (split)
+            {
+                Piece half = piece;
+                half.Depth = ++piece.Depth;
+                Vec2* R = Q + size;
+                std::copy(Q, Q + size, R);
+                const bool along_u = piece.U1 - piece.U0 >= piece.V1 - piece.V0;
+                const int degree = along_u ? p : q;
+                const int lines  = along_u ? q + 1 : p + 1;
+                const int step   = along_u ? 1 : p + 1;
+                const int pitch  = along_u ? p + 1 : 1;
+                for (int line = 0; line < lines; ++line)
+                {
+                    RestrictBezier(Q + line * pitch, degree, step, 0, 0.5);
+                    RestrictBezier(R + line * pitch, degree, step, 0.5, 1);
+                }
+                if (along_u)
+                {
+                    piece.U1 = half.U0 = (piece.U0 + piece.U1) / 2;
+                }
+                else
+                {
+                    piece.V1 = half.V0 = (piece.V0 + piece.V1) / 2;
+                }
+                stack[top++] = half;
+            }
+        }
+        return updated;
+    }
+
+    Surface::RayHit IntersectRay(const Surface& surface, const SurfaceBvh& bvh,
+                                 const Vec3& origin, const Vec3& direction, Numeric t_max,
+                                 RayIntersectionScratch& scratch, Numeric epsilon)
+    {
+        Surface::RayHit hit;
+        bvh.TraverseRay(origin, direction, t_max, [&](int patch, Numeric)
+        {
+            if (IntersectRayPatch(surface, bvh, patch, origin, direction, t_max, hit, scratch, epsilon))
+            {
+                t_max = hit.T;
+            }
+            return t_max;
+        });
+        return hit;
+    }
+
+    void IntersectRayPacket(const Surface& surface, const SurfaceBvh& bvh,
+                            std::span<const Vec3> origins, std::span<const Vec3> directions,
+                            std::span<Surface::RayHit> hits, RayIntersectionScratch& scratch, Numeric epsilon)
+    {
+        const int count = static_cast<int>(origins.size());
+        Numeric t_max[SurfaceBvh::MAX_PACKET_SIZE];
+        std::fill(t_max, t_max + count, std::numeric_limits<Numeric>::infinity());
+        std::fill(hits.begin(), hits.end(), Surface::RayHit{});
+        bvh.TraversePacket(count, origins.data(), directions.data(), t_max, [&](int ray, int patch, Numeric)
+        {
+            Surface::RayHit& hit = hits[ray];
+            IntersectRayPatch(surface, bvh, patch, origins[ray], directions[ray], t_max[ray], hit, scratch, epsilon);
+            return hit.Hit ? hit.T : t_max[ray];
+        });
+    }
+}
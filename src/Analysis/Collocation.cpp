@@ -0,0 +1,121 @@
+#include "libnurbs/Analysis/Collocation.hpp"
+
+#include <vector>
+
+#include "libnurbs/Basis/BSplineBasis.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    constexpr int CHUNK_SIZE = 1024;
+
+    // Rows of entry_count entries each, outer indices set, values and columns to fill
+    SparseMatrix AllocateRows(int row_count, int column_count, int entry_count)
+    {
+        SparseMatrix result(row_count, column_count);
+        result.resizeNonZeros(static_cast<Eigen::Index>(row_count) * entry_count);
+        int* outer = result.outerIndexPtr();
+        for (int k = 0; k <= row_count; ++k)
+        {
+            outer[k] = k * entry_count;
+        }
+        return result;
+    }
+
+    // Rational bases from the B-spline ones, in place
+    void Rationalize(Numeric* values, const int* columns, int count, const std::vector<Vec4>& control_points)
+    {
+        Numeric weight = 0;
+        for (int k = 0; k < count; ++k)
+        {
+            values[k] *= control_points[columns[k]].w();
+            weight += values[k];
+        }
+        for (int k = 0; k < count; ++k)
+        {
+            values[k] /= weight;
+        }
+    }
+
+    struct Worker
+    {
+        BSplineBasis::Scratch Scratch{};
+        std::vector<Numeric> BasisU{};
+        std::vector<Numeric> BasisV{};
+        int SpanU{INVALID_INDEX};
+        int SpanV{INVALID_INDEX};
+    };
+}
+
+namespace libnurbs
+{
+    SparseMatrix CollocationMatrix(const Curve& curve, std::span<const Numeric> parameters, int thread_count)
+    {
+        const int p = curve.Degree;
+        const int row_count = static_cast<int>(parameters.size());
+        const int entry_count = p + 1;
+        SparseMatrix result = AllocateRows(row_count, static_cast<int>(curve.ControlPoints.size()), entry_count);
+        const bool rational = curve.IsRational();
+        const auto& knots = curve.Knots.Values();
+        Numeric* values = result.valuePtr();
+        int* columns = result.innerIndexPtr();
+
+        const int workers = Utils::ResolveThreadCount(thread_count, (row_count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        std::vector<Worker> scratches(workers);
+        Utils::ParallelFor(row_count, workers, [&](int row, int worker)
+        {
+            Worker& scratch = scratches[worker];
+            const Numeric x = parameters[row];
+            scratch.SpanU = curve.Knots.FindSpanIndex(p, x, scratch.SpanU);
+            const size_t offset = static_cast<size_t>(row) * entry_count;
+            BSplineBasis::Evaluate(p, knots, scratch.SpanU, x, values + offset, scratch.Scratch);
+            for (int r = 0; r <= p; ++r)
+            {
+                columns[offset + r] = scratch.SpanU - p + r;
+            }
+            if (rational) Rationalize(values + offset, columns + offset, entry_count, curve.ControlPoints);
+        }, CHUNK_SIZE);
+        return result;
+    }
+
+    SparseMatrix CollocationMatrix(const Surface& surface, std::span<const Eigen::Vector2<Numeric>> parameters,
+                                   int thread_count)
+    {
+        const int p = surface.DegreeU, q = surface.DegreeV;
+        const int row_count = static_cast<int>(parameters.size());
+        const int entry_count = (p + 1) * (q + 1);
+        const int row_size = surface.ControlPoints.UCount;
+        SparseMatrix result = AllocateRows(row_count, static_cast<int>(surface.ControlPoints.Values.size()),
+                                           entry_count);
+        const bool rational = surface.IsRational();
+        Numeric* values = result.valuePtr();
+        int* columns = result.innerIndexPtr();
+
+        const int workers = Utils::ResolveThreadCount(thread_count, (row_count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        std::vector<Worker> scratches(workers, Worker{{}, std::vector<Numeric>(p + 1), std::vector<Numeric>(q + 1)});
+        Utils::ParallelFor(row_count, workers, [&](int row, int worker)
+        {
+            Worker& scratch = scratches[worker];
+            const Numeric u = parameters[row].x(), v = parameters[row].y();
+            scratch.SpanU = surface.KnotsU.FindSpanIndex(p, u, scratch.SpanU);
+            scratch.SpanV = surface.KnotsV.FindSpanIndex(q, v, scratch.SpanV);
+            BSplineBasis::Evaluate(p, surface.KnotsU.Values(), scratch.SpanU, u, scratch.BasisU.data(), scratch.Scratch);
+            BSplineBasis::Evaluate(q, surface.KnotsV.Values(), scratch.SpanV, v, scratch.BasisV.data(), scratch.Scratch);
+            // Rows of the control net are contiguous in Values, so the columns come out ascending
+            const size_t offset = static_cast<size_t>(row) * entry_count;
+            for (int s = 0, k = 0; s <= q; ++s)
+            {
+                const int first = (scratch.SpanV - q + s) * row_size + scratch.SpanU - p;
+                for (int r = 0; r <= p; ++r, ++k)
+                {
+                    values[offset + k] = scratch.BasisU[r] * scratch.BasisV[s];
+                    columns[offset + k] = first + r;
+                }
+            }
+            if (rational) Rationalize(values + offset, columns + offset, entry_count, surface.ControlPoints.Values);
+        }, CHUNK_SIZE);
+        return result;
+    }
+}
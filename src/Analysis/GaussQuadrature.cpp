@@ -0,0 +1,101 @@
+#include "libnurbs/Analysis/GaussQuadrature.hpp"
+#include "libnurbs/Basis/BSplineBasis.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+using namespace libnurbs;
+
+namespace
+{
+    constexpr int MAX_NEWTON_ITERATION_COUNT = 100;
+
+    // Roots of the Legendre polynomial P_n by Newton from the Tricomi estimates, pairs ±x
+    QuadratureRule MakeGaussLegendre(int n)
+    {
+        QuadratureRule rule;
+        rule.Nodes.resize(n);
+        rule.Weights.resize(n);
+        for (int i = 0; i < (n + 1) / 2; ++i)
+        {
+            Numeric x = std::cos(std::numbers::pi * (i + 0.75) / (n + 0.5));
+            Numeric derivative = 0;
+            for (int count = 0; count < MAX_NEWTON_ITERATION_COUNT; ++count)
+            {
+                Numeric p0 = 1, p1 = x;
+                for (int k = 2; k <= n; ++k)
+                {
+                    const Numeric p2 = ((2 * k - 1) * x * p1 - (k - 1) * p0) / k;
+                    p0 = p1;
+                    p1 = p2;
+                }
+                derivative = n * (x * p1 - p0) / (x * x - 1);
+                const Numeric step = p1 / derivative;
+                x -= step;
+                if (std::abs(step) <= 1e-15) break;
+            }
+            const Numeric weight = 2 / ((1 - x * x) * derivative * derivative);
+            rule.Nodes[i] = -x;
+            rule.Nodes[n - 1 - i] = x;
+            rule.Weights[i] = weight;
+            rule.Weights[n - 1 - i] = weight;
+        }
+        // The middle node of odd rules is exactly 0
+        if (n % 2 == 1) rule.Nodes[n / 2] = 0;
+        return rule;
+    }
+}
+
+namespace libnurbs
+{
+    const QuadratureRule& GaussLegendre(int point_count)
+    {
+        assert(point_count >= 1 && point_count <= MAX_QUADRATURE_POINT_COUNT);
+        static const auto rules = []
+        {
+            std::array<QuadratureRule, MAX_QUADRATURE_POINT_COUNT + 1> result;
+            for (int n = 1; n <= MAX_QUADRATURE_POINT_COUNT; ++n)
+            {
+                result[n] = MakeGaussLegendre(n);
+            }
+            return result;
+        }();
+        return rules[point_count];
+    }
+
+    SpanQuadrature::SpanQuadrature(const KnotVector& knots, int degree, int point_count, int order)
+        : Degree(degree),
+          Order(order),
+          PointCount(point_count)
+    {
+        const QuadratureRule& rule = GaussLegendre(point_count);
+        const int n = knots.Count() - degree - 1;
+        MatX basis;
+        BSplineBasis::Scratch scratch;
+        for (int i = degree; i < n; ++i)
+        {
+            const Numeric a = knots(i), b = knots(i + 1);
+            if (!(a < b)) continue;
+            Spans.push_back(i);
+            const Numeric middle = (a + b) / 2, half = (b - a) / 2;
+            for (int k = 0; k < point_count; ++k)
+            {
+                const Numeric x = middle + half * rule.Nodes[k];
+                Points.push_back(x);
+                Weights.push_back(half * rule.Weights[k]);
+                // Derivatives above the degree vanish
+                BSplineBasis::EvaluateAll(degree, knots.Values(), i, x, std::min(order, degree), basis, scratch);
+                for (int d = 0; d <= order; ++d)
+                {
+                    for (int r = 0; r <= degree; ++r)
+                    {
+                        BasisValues.push_back(d <= degree ? basis(d, r) : 0);
+                    }
+                }
+            }
+        }
+    }
+}
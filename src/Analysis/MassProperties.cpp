@@ -0,0 +1,165 @@
+#include "libnurbs/Analysis/MassProperties.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "libnurbs/Analysis/GaussQuadrature.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    // Moments of one span or element about the reference point
+    struct Moments
+    {
+        Numeric Measure{0};
+        Vec3 First = Vec3::Zero();
+        Mat3x3 Second = Mat3x3::Zero();
+
+        void Add(const Vec3& point, Numeric weight)
+        {
+            Measure += weight;
+            First += weight * point;
+            Second += weight * point * point.transpose();
+        }
+    };
+
+    int ResolvePointCount(const IntegrationOptions& options, int degree)
+    {
+        const int count = options.PointCount > 0 ? options.PointCount : 2 * degree;
+        return std::clamp(count, 1, MAX_QUADRATURE_POINT_COUNT);
+    }
+
+    // Centering on the control points keeps the second moments small against the shift to the centroid
+    Vec3 ReferencePoint(const std::vector<Vec4>& control_points)
+    {
+        Vec3 sum = Vec3::Zero();
+        for (const Vec4& point : control_points)
+        {
+            sum += point.head<3>();
+        }
+        return control_points.empty() ? sum : Vec3(sum / static_cast<Numeric>(control_points.size()));
+    }
+
+    // Deterministic sum in item order, then the shift from the reference point to the centroid
+    MassProperties Reduce(const std::vector<Moments>& items, const Vec3& reference)
+    {
+        Moments total;
+        for (const Moments& item : items)
+        {
+            total.Measure += item.Measure;
+            total.First += item.First;
+            total.Second += item.Second;
+        }
+
+        MassProperties result;
+        result.Measure = total.Measure;
+        result.Centroid = reference;
+        if (!(total.Measure > 0)) return result;
+
+        const Vec3 offset = total.First / total.Measure;
+        result.Centroid += offset;
+        const Mat3x3 second = total.Second - total.Measure * offset * offset.transpose();
+        result.Inertia = second.trace() * Mat3x3::Identity() - second;
+        return result;
+    }
+}
+
+namespace libnurbs
+{
+    MassProperties ComputeMassProperties(const Curve& curve, const IntegrationOptions& options)
+    {
+        const int p = curve.Degree;
+        const SpanQuadrature quadrature(curve.Knots, p, ResolvePointCount(options, p), 1);
+        const Vec3 reference = ReferencePoint(curve.ControlPoints);
+        std::vector<Vec4> homo(curve.ControlPoints.size());
+        std::ranges::transform(curve.ControlPoints, homo.begin(), ToHomo);
+
+        const int span_count = quadrature.SpanCount();
+        const int count = quadrature.PointCount;
+        std::vector<Moments> moments(span_count);
+        Utils::ParallelFor(span_count, Utils::ResolveThreadCount(options.ThreadCount, span_count), [&](int k, int)
+        {
+            const Vec4* points = homo.data() + quadrature.Spans[k] - p;
+            Moments& item = moments[k];
+            for (int q = k * count; q < (k + 1) * count; ++q)
+            {
+                const Numeric* basis = quadrature.Basis(q, 0);
+                const Numeric* derivative = quadrature.Basis(q, 1);
+                Vec4 value = Vec4::Zero(), tangent = Vec4::Zero();
+                for (int r = 0; r <= p; ++r)
+                {
+                    value += basis[r] * points[r];
+                    tangent += derivative[r] * points[r];
+                }
+                const Vec3 point = value.head<3>() / value.w();
+                const Vec3 velocity = (tangent.head<3>() - tangent.w() * point) / value.w();
+                item.Add(point - reference, quadrature.Weights[q] * velocity.norm());
+            }
+        }, 16);
+        return Reduce(moments, reference);
+    }
+
+    MassProperties ComputeMassProperties(const Surface& surface, const IntegrationOptions& options)
+    {
+        const int p = surface.DegreeU, q = surface.DegreeV;
+        const SpanQuadrature quadrature_u(surface.KnotsU, p, ResolvePointCount(options, p), 1);
+        const SpanQuadrature quadrature_v(surface.KnotsV, q, ResolvePointCount(options, q), 1);
+        const Vec3 reference = ReferencePoint(surface.ControlPoints.Values);
+        const int row_size = surface.ControlPoints.UCount;
+        std::vector<Vec4> homo(surface.ControlPoints.Values.size());
+        std::ranges::transform(surface.ControlPoints.Values, homo.begin(), ToHomo);
+
+        const int span_count_u = quadrature_u.SpanCount();
+        const int count_u = quadrature_u.PointCount, count_v = quadrature_v.PointCount;
+        const int element_count = span_count_u * quadrature_v.SpanCount();
+        const int workers = Utils::ResolveThreadCount(options.ThreadCount, element_count);
+        // Per worker: the control point rows of an element contracted with the v basis at one v point
+        std::vector<std::vector<Vec4>> partials(workers, std::vector<Vec4>(2 * (p + 1)));
+        std::vector<Moments> moments(element_count);
+        Utils::ParallelFor(element_count, workers, [&](int element, int worker)
+        {
+            const int ku = element % span_count_u, kv = element / span_count_u;
+            const int first_u = quadrature_u.Spans[ku] - p, first_v = quadrature_v.Spans[kv] - q;
+            Vec4* value_v = partials[worker].data();
+            Vec4* tangent_v = value_v + p + 1;
+            Moments& item = moments[element];
+            for (int b = kv * count_v; b < (kv + 1) * count_v; ++b)
+            {
+                // Sum factorization: contract in v once per v point, then in u per point
+                const Numeric* basis_v = quadrature_v.Basis(b, 0);
+                const Numeric* derivative_v = quadrature_v.Basis(b, 1);
+                for (int r = 0; r <= p; ++r)
+                {
+                    value_v[r].setZero();
+                    tangent_v[r].setZero();
+                    for (int s = 0; s <= q; ++s)
+                    {
+                        const Vec4& point = homo[(first_v + s) * row_size + first_u + r];
+                        value_v[r] += basis_v[s] * point;
+                        tangent_v[r] += derivative_v[s] * point;
+                    }
+                }
+                for (int a = ku * count_u; a < (ku + 1) * count_u; ++a)
+                {
+                    const Numeric* basis_u = quadrature_u.Basis(a, 0);
+                    const Numeric* derivative_u = quadrature_u.Basis(a, 1);
+                    Vec4 value = Vec4::Zero(), su = Vec4::Zero(), sv = Vec4::Zero();
+                    for (int r = 0; r <= p; ++r)
+                    {
+                        value += basis_u[r] * value_v[r];
+                        su += derivative_u[r] * value_v[r];
+                        sv += basis_u[r] * tangent_v[r];
+                    }
+                    const Vec3 point = value.head<3>() / value.w();
+                    const Vec3 du = (su.head<3>() - su.w() * point) / value.w();
+                    const Vec3 dv = (sv.head<3>() - sv.w() * point) / value.w();
+                    item.Add(point - reference,
+                             quadrature_u.Weights[a] * quadrature_v.Weights[b] * du.cross(dv).norm());
+                }
+            }
+        }, 4);
+        return Reduce(moments, reference);
+    }
+}
@@ -0,0 +1,137 @@
+#include "libnurbs/Analysis/SurfaceElements.hpp"
+
+#include <algorithm>
+
+using namespace libnurbs;
+
+namespace
+{
+    int ResolvePointCount(int point_count, int degree)
+    {
+        return std::clamp(point_count > 0 ? point_count : degree + 1, 1, MAX_QUADRATURE_POINT_COUNT);
+    }
+}
+
+SurfaceElements::SurfaceElements(const Surface& surface, int point_count, int thread_count)
+    : m_QuadratureU(surface.KnotsU, surface.DegreeU, ResolvePointCount(point_count, surface.DegreeU), 1),
+      m_QuadratureV(surface.KnotsV, surface.DegreeV, ResolvePointCount(point_count, surface.DegreeV), 1)
+{
+    const int span_count_u = m_QuadratureU.SpanCount();
+    const int row_size = surface.ControlPoints.UCount;
+    for (int span_v : m_QuadratureV.Spans)
+    {
+        for (int span_u : m_QuadratureU.Spans)
+        {
+            m_Spans.emplace_back(span_u, span_v);
+            for (int s = 0; s <= surface.DegreeV; ++s)
+            {
+                for (int r = 0; r <= surface.DegreeU; ++r)
+                {
+                    m_Functions.push_back((span_v - surface.DegreeV + s) * row_size + span_u - surface.DegreeU + r);
+                }
+            }
+        }
+    }
+
+    const size_t point_total = static_cast<size_t>(ElementCount()) * PointCount();
+    m_Parameters.resize(point_total);
+    m_Points.resize(point_total);
+    m_Jacobians.resize(point_total);
+    m_Measures.resize(point_total);
+    m_Values.resize(point_total * FunctionCount());
+    m_Gradients.resize(point_total * FunctionCount());
+    for (int element = 0; element < ElementCount(); ++element)
+    {
+        const int ku = element % span_count_u, kv = element / span_count_u;
+        for (int b = 0; b < m_QuadratureV.PointCount; ++b)
+        {
+            for (int a = 0; a < m_QuadratureU.PointCount; ++a)
+            {
+                m_Parameters[PointOffset(element) + b * m_QuadratureU.PointCount + a] = {
+                    m_QuadratureU.Points[ku * m_QuadratureU.PointCount + a],
+                    m_QuadratureV.Points[kv * m_QuadratureV.PointCount + b]};
+            }
+        }
+    }
+    Update(surface, thread_count);
+}
+
+void SurfaceElements::Update(const Surface& surface, int thread_count)
+{
+    ForEachElement([&](int element, int)
+    {
+        Evaluate(surface, element);
+    }, thread_count);
+}
+
+void SurfaceElements::Evaluate(const Surface& surface, int element)
+{
+    const int p = m_QuadratureU.Degree, q = m_QuadratureV.Degree;
+    const int count_u = m_QuadratureU.PointCount, count_v = m_QuadratureV.PointCount;
+    const int span_count_u = m_QuadratureU.SpanCount();
+    const int ku = element % span_count_u, kv = element / span_count_u;
+    const int function_count = FunctionCount();
+    const auto functions = Functions(element);
+    const auto& control_points = surface.ControlPoints.Values;
+
+    for (int b = 0; b < count_v; ++b)
+    {
+        const Numeric* basis_v = m_QuadratureV.Basis(kv * count_v + b, 0);
+        const Numeric* derivative_v = m_QuadratureV.Basis(kv * count_v + b, 1);
+        for (int a = 0; a < count_u; ++a)
+        {
+            const Numeric* basis_u = m_QuadratureU.Basis(ku * count_u + a, 0);
+            const Numeric* derivative_u = m_QuadratureU.Basis(ku * count_u + a, 1);
+            const int point = b * count_u + a;
+            Numeric* values = m_Values.data() + FunctionOffset(element, point);
+            Vec3* gradients = m_Gradients.data() + FunctionOffset(element, point);
+
+            // Weight function and its derivatives
+            Numeric w = 0, wu = 0, wv = 0;
+            for (int s = 0, f = 0; s <= q; ++s)
+            {
+                for (int r = 0; r <= p; ++r, ++f)
+                {
+                    const Numeric weight = control_points[functions[f]].w();
+                    w += basis_u[r] * basis_v[s] * weight;
+                    wu += derivative_u[r] * basis_v[s] * weight;
+                    wv += basis_u[r] * derivative_v[s] * weight;
+                }
+            }
+
+            // Rational bases, parameter derivatives kept in the gradients until the Jacobian is known
+            Vec3 position = Vec3::Zero();
+            Jacobian jacobian = Jacobian::Zero();
+            for (int s = 0, f = 0; s <= q; ++s)
+            {
+                for (int r = 0; r <= p; ++r, ++f)
+                {
+                    const Vec4& control_point = control_points[functions[f]];
+                    const Numeric value = basis_u[r] * basis_v[s] * control_point.w() / w;
+                    const Numeric value_u = (derivative_u[r] * basis_v[s] * control_point.w() - value * wu) / w;
+                    const Numeric value_v = (basis_u[r] * derivative_v[s] * control_point.w() - value * wv) / w;
+                    values[f] = value;
+                    gradients[f] = {value_u, value_v, 0};
+                    position += value * control_point.head<3>();
+                    jacobian.col(0) += value_u * control_point.head<3>();
+                    jacobian.col(1) += value_v * control_point.head<3>();
+                }
+            }
+
+            const size_t index = PointOffset(element) + point;
+            m_Points[index] = position;
+            m_Jacobians[index] = jacobian;
+            m_Measures[index] = m_QuadratureU.Weights[ku * count_u + a] * m_QuadratureV.Weights[kv * count_v + b] *
+                                jacobian.col(0).cross(jacobian.col(1)).norm();
+
+            // Degenerate points, e.g. collapsed edges, get zero gradients
+            const Eigen::Matrix<Numeric, 2, 2> metric = jacobian.transpose() * jacobian;
+            const Numeric determinant = metric.determinant();
+            const Jacobian dual = determinant > 0 ? Jacobian(jacobian * metric.inverse()) : Jacobian::Zero();
+            for (int f = 0; f < function_count; ++f)
+            {
+                gradients[f] = dual * gradients[f].head<2>();
+            }
+        }
+    }
+}
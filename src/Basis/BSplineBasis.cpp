@@ -26,6 +26,28 @@ namespace libnurbs
         return result;
     }
 
+    void BSplineBasis::Evaluate(int degree, const vector<Numeric>& knots, int index_span, Numeric x,
+                                Numeric* result, Scratch& scratch)
+    {
+        auto& left = scratch.Left;
+        auto& right = scratch.Right;
+        if (left.size() < degree + 1) left.resize(degree + 1);
+        if (right.size() < degree + 1) right.resize(degree + 1);
+        result[0] = 1.0;
+        for (int j = 1; j <= degree; j++)
+        {
+            left[j] = (x - knots[index_span + 1 - j]);
+            right[j] = knots[index_span + j] - x;
+            Numeric saved = 0.0;
+            for (int r = 0; r < j; r++)
+            {
+                const Numeric temp = result[r] / (right[r + 1] + left[j - r]);
+                result[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            result[j] = saved;
+        }
+    }
 
     VecX BSplineBasis::Evaluate(int degree, const KnotVector& knot_vec, Numeric x)
     {
@@ -49,12 +71,25 @@ namespace libnurbs
         return EvaluateAll(degree, knots, index_span, x, order).row(order);
     }
 
-    // modified from: https://github.com/pradeep-pyro/tinynurbs
     MatX BSplineBasis::EvaluateAll(int degree, const vector<Numeric>& knots, int index_span, Numeric x, int order)
     {
-        std::vector<Numeric> left(degree + 1, 0.0), right(degree + 1, 0.0);
+        MatX result;
+        Scratch scratch;
+        EvaluateAll(degree, knots, index_span, x, order, result, scratch);
+        return result;
+    }
+
+    // modified from: https://github.com/pradeep-pyro/tinynurbs
+    void BSplineBasis::EvaluateAll(int degree, const vector<Numeric>& knots, int index_span, Numeric x, int order,
+                                   MatX& result, Scratch& scratch)
+    {
+        auto& left = scratch.Left;
+        auto& right = scratch.Right;
+        left.setZero(degree + 1);
+        right.setZero(degree + 1);
 
-        MatX ndu = MatX::Zero(degree + 1, degree + 1);
+        auto& ndu = scratch.Ndu;
+        ndu.setZero(degree + 1, degree + 1);
         ndu(0, 0) = 1.0;
 
         for (int j = 1; j <= degree; j++)
@@ -74,10 +109,11 @@ namespace libnurbs
             ndu(j, j) = saved;
         }
 
-        MatX result = MatX::Zero(order + 1, degree + 1);
+        result.setZero(order + 1, degree + 1);
         result.row(0) = ndu.col(degree);
 
-        MatX a = MatX::Zero(2, degree + 1);
+        auto& a = scratch.A;
+        a.setZero(2, degree + 1);
         for (int r = 0; r <= degree; r++)
         {
             int s1 = 0, s2 = 1;
@@ -120,8 +156,6 @@ namespace libnurbs
             result.row(k) *= fac;
             fac *= (degree - k);
         }
-
-        return result;
     }
 
     MatX BSplineBasis::EvaluateAll(int degree, const KnotVector& knot_vec, Numeric x, int order)
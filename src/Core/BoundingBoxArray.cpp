@@ -0,0 +1,199 @@
+#include "libnurbs/Core/BoundingBoxArray.hpp"
+
+#include <type_traits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LIBNURBS_SSE2
+#endif
+
+using namespace libnurbs;
+
+namespace
+{
+    static_assert(std::is_same_v<Numeric, double>);
+    static_assert(BoundingBoxArray::PACK_SIZE == 4);
+
+    // Four double lanes. Min(a, b) is a < b ? a : b and Max(a, b) is a > b ? a : b in every lane,
+    // the semantics of the x86 instructions, so a NaN in a yields b.
+#if defined(__AVX__)
+    struct Lanes
+    {
+        __m256d Value;
+    };
+
+    Lanes Load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    Lanes Broadcast(double x) { return {_mm256_set1_pd(x)}; }
+    void Store(Lanes a, double* p) { _mm256_storeu_pd(p, a.Value); }
+    Lanes operator+(Lanes a, Lanes b) { return {_mm256_add_pd(a.Value, b.Value)}; }
+    Lanes operator-(Lanes a, Lanes b) { return {_mm256_sub_pd(a.Value, b.Value)}; }
+    Lanes operator*(Lanes a, Lanes b) { return {_mm256_mul_pd(a.Value, b.Value)}; }
+    Lanes Min(Lanes a, Lanes b) { return {_mm256_min_pd(a.Value, b.Value)}; }
+    Lanes Max(Lanes a, Lanes b) { return {_mm256_max_pd(a.Value, b.Value)}; }
+
+    // Comparisons yield all-ones lanes where true, Bits packs their sign bits
+    Lanes LessEqual(Lanes a, Lanes b) { return {_mm256_cmp_pd(a.Value, b.Value, _CMP_LE_OQ)}; }
+    Lanes operator&(Lanes a, Lanes b) { return {_mm256_and_pd(a.Value, b.Value)}; }
+    unsigned Bits(Lanes a) { return static_cast<unsigned>(_mm256_movemask_pd(a.Value)); }
+#elif defined(LIBNURBS_SSE2)
+    struct Lanes
+    {
+        __m128d Low;
+        __m128d High;
+    };
+
+    Lanes Load(const double* p) { return {_mm_loadu_pd(p), _mm_loadu_pd(p + 2)}; }
+    Lanes Broadcast(double x) { return {_mm_set1_pd(x), _mm_set1_pd(x)}; }
+
+    void Store(Lanes a, double* p)
+    {
+        _mm_storeu_pd(p, a.Low);
+        _mm_storeu_pd(p + 2, a.High);
+    }
+
+    Lanes operator+(Lanes a, Lanes b) { return {_mm_add_pd(a.Low, b.Low), _mm_add_pd(a.High, b.High)}; }
+    Lanes operator-(Lanes a, Lanes b) { return {_mm_sub_pd(a.Low, b.Low), _mm_sub_pd(a.High, b.High)}; }
+    Lanes operator*(Lanes a, Lanes b) { return {_mm_mul_pd(a.Low, b.Low), _mm_mul_pd(a.High, b.High)}; }
+    Lanes Min(Lanes a, Lanes b) { return {_mm_min_pd(a.Low, b.Low), _mm_min_pd(a.High, b.High)}; }
+    Lanes Max(Lanes a, Lanes b) { return {_mm_max_pd(a.Low, b.Low), _mm_max_pd(a.High, b.High)}; }
+
+    Lanes LessEqual(Lanes a, Lanes b) { return {_mm_cmple_pd(a.Low, b.Low), _mm_cmple_pd(a.High, b.High)}; }
+    Lanes operator&(Lanes a, Lanes b) { return {_mm_and_pd(a.Low, b.Low), _mm_and_pd(a.High, b.High)}; }
+
+    unsigned Bits(Lanes a)
+    {
+        return static_cast<unsigned>(_mm_movemask_pd(a.Low) | _mm_movemask_pd(a.High) << 2);
+    }
+#else
+    struct Lanes
+    {
+        double Value[4];
+    };
+
+    template <typename Operation>
+    Lanes Apply(Lanes a, Lanes b, Operation operation)
+    {
+        Lanes result;
+        for (int i = 0; i < 4; ++i) result.Value[i] = operation(a.Value[i], b.Value[i]);
+        return result;
+    }
+
+    Lanes Load(const double* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    Lanes Broadcast(double x) { return {{x, x, x, x}}; }
+    void Store(Lanes a, double* p) { for (int i = 0; i < 4; ++i) p[i] = a.Value[i]; }
+    Lanes operator+(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return x + y; }); }
+    Lanes operator-(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return x - y; }); }
+    Lanes operator*(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return x * y; }); }
+    Lanes Min(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return x < y ? x : y; }); }
+    Lanes Max(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return x > y ? x : y; }); }
+
+    // Comparisons yield 1 or 0 per lane here, Bits packs the nonzero lanes
+    Lanes LessEqual(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return double(x <= y); }); }
+    Lanes operator&(Lanes a, Lanes b) { return Apply(a, b, [](double x, double y) { return x * y; }); }
+
+    unsigned Bits(Lanes a)
+    {
+        unsigned bits = 0;
+        for (int i = 0; i < 4; ++i) bits |= static_cast<unsigned>(a.Value[i] != 0) << i;
+        return bits;
+    }
+#endif
+
+    uint64_t LowBits(int count)
+    {
+        return count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+    }
+
+    // Copies the lanes of a pack that belong to the first count results.
+    void StoreLanes(Lanes a, int k, int count, Numeric* output)
+    {
+        if (k + BoundingBoxArray::PACK_SIZE <= count)
+        {
+            Store(a, output + k);
+            return;
+        }
+        double lanes[BoundingBoxArray::PACK_SIZE];
+        Store(a, lanes);
+        for (int lane = 0; lane < BoundingBoxArray::PACK_SIZE && k + lane < count; ++lane)
+        {
+            output[k + lane] = lanes[lane];
+        }
+    }
+}
+
+uint64_t BoundingBoxArray::IntersectsMask(const BoundingBox& query, int start, int count) const
+{
+    const double* min_x = m_Min[0].data() + start;
+    const double* min_y = m_Min[1].data() + start;
+    const double* min_z = m_Min[2].data() + start;
+    const double* max_x = m_Max[0].data() + start;
+    const double* max_y = m_Max[1].data() + start;
+    const double* max_z = m_Max[2].data() + start;
+    const Lanes low_x = Broadcast(query.Min.x()), high_x = Broadcast(query.Max.x());
+    const Lanes low_y = Broadcast(query.Min.y()), high_y = Broadcast(query.Max.y());
+    const Lanes low_z = Broadcast(query.Min.z()), high_z = Broadcast(query.Max.z());
+
+    uint64_t mask = 0;
+    for (int k = 0; k < count; k += PACK_SIZE)
+    {
+        Lanes hit = LessEqual(Load(min_x + k), high_x) & LessEqual(low_x, Load(max_x + k)) &
+                    LessEqual(Load(min_y + k), high_y) & LessEqual(low_y, Load(max_y + k)) &
+                    LessEqual(Load(min_z + k), high_z) & LessEqual(low_z, Load(max_z + k));
+        mask |= uint64_t(Bits(hit)) << k;
+    }
+    return mask & LowBits(count);
+}
+
+uint64_t BoundingBoxArray::ContainsMask(const Vec3& point, int start, int count) const
+{
+    return IntersectsMask(BoundingBox(point, point), start, count);
+}
+
+uint64_t BoundingBoxArray::IntersectRayMask(const Vec3& origin, const Vec3& inverse_direction,
+                                            Numeric t_min, Numeric t_max,
+                                            int start, int count, Numeric* t_enter) const
+{
+    Lanes o[3], s[3];
+    for (int d = 0; d < 3; ++d)
+    {
+        o[d] = Broadcast(origin[d]);
+        s[d] = Broadcast(inverse_direction[d]);
+    }
+
+    uint64_t mask = 0;
+    for (int k = 0; k < count; k += PACK_SIZE)
+    {
+        Lanes enter = Broadcast(t_min);
+        Lanes exit  = Broadcast(t_max);
+        for (int d = 0; d < 3; ++d)
+        {
+            Lanes t0 = (Load(m_Min[d].data() + start + k) - o[d]) * s[d];
+            Lanes t1 = (Load(m_Max[d].data() + start + k) - o[d]) * s[d];
+            // Operand order reproduces the scalar test when a slab yields NaN: its bounds stay untouched.
+            enter = Max(Min(t1, t0), enter);
+            exit  = Min(Max(t0, t1), exit);
+        }
+        StoreLanes(enter, k, count, t_enter);
+        mask |= uint64_t(Bits(LessEqual(enter, exit))) << k;
+    }
+    return mask & LowBits(count);
+}
+
+void BoundingBoxArray::SquaredDistances(const Vec3& point, int start, int count, Numeric* distances) const
+{
+    for (int k = 0; k < count; k += PACK_SIZE)
+    {
+        Lanes sum = Broadcast(0);
+        for (int d = 0; d < 3; ++d)
+        {
+            Lanes p     = Broadcast(point[d]);
+            Lanes below = Load(m_Min[d].data() + start + k) - p;
+            Lanes above = p - Load(m_Max[d].data() + start + k);
+            Lanes gap   = Max(Max(below, above), Broadcast(0));
+            sum = sum + gap * gap;
+        }
+        StoreLanes(sum, k, count, distances);
+    }
+}
@@ -137,6 +137,18 @@ int KnotVector::FindSpanIndex(int degree, Numeric u) const
     return index_result - 1;
 }
 
+int KnotVector::FindSpanIndex(int degree, Numeric u, int hint) const
+{
+    assert(u >= 0.0 && u <= 1.0);
+    int index_first_span = degree;
+    int index_last_span = static_cast<int>(m_Values.size()) - degree - 2;
+    if (hint < index_first_span || hint > index_last_span) return FindSpanIndex(degree, u);
+    if (u == m_Values.back()) return index_last_span;
+    while (hint < index_last_span && u >= m_Values[hint + 1]) ++hint;
+    while (hint > index_first_span && u < m_Values[hint]) --hint;
+    return hint;
+}
+
 KnotVector::KnotSpan KnotVector::FindSpan(Numeric u) const
 {
     assert(u >= 0.0 && u <= 1.0);
@@ -0,0 +1,171 @@
+#include "libnurbs/Curve/ArcLengthTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "libnurbs/Analysis/GaussQuadrature.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    constexpr int GAUSS_POINT_COUNT = 8;
+    // Halvings per knot span
+    constexpr int MAX_SPLIT_DEPTH = 24;
+    constexpr int NEWTON_ITERATION_COUNT = 4;
+
+    Numeric Speed(const Curve& curve, Numeric x, int span, Curve::EvaluationScratch& scratch)
+    {
+        return curve.EvaluateAll(x, 1, scratch, span)[1].norm();
+    }
+
+    Numeric Integrate(const Curve& curve, Numeric a, Numeric b, int span, Curve::EvaluationScratch& scratch)
+    {
+        const QuadratureRule& rule = GaussLegendre(GAUSS_POINT_COUNT);
+        const Numeric middle = (a + b) / 2, half = (b - a) / 2;
+        Numeric sum = 0;
+        for (int i = 0; i < rule.Count(); ++i)
+        {
+            sum += rule.Weights[i] * Speed(curve, middle + half * rule.Nodes[i], span, scratch);
+        }
+        return sum * half;
+    }
+
+    // Pieces (start parameter, length) of one knot span, in order.
+    void IntegrateSpan(const Curve& curve, Numeric a, Numeric b, int span, Numeric tolerance,
+                       Curve::EvaluationScratch& scratch, std::vector<std::pair<Numeric, Numeric>>& pieces)
+    {
+        struct Entry
+        {
+            Numeric A, B, Length;
+            int Depth;
+        };
+        Entry stack[MAX_SPLIT_DEPTH + 1];
+        int top = 0;
+        stack[top++] = {a, b, Integrate(curve, a, b, span, scratch), 0};
+        while (top > 0)
+        {
+            const Entry entry = stack[--top];
+            const Numeric middle = (entry.A + entry.B) / 2;
+            const Numeric left = Integrate(curve, entry.A, middle, span, scratch);
+            const Numeric right = Integrate(curve, middle, entry.B, span, scratch);
+            if (std::abs(left + right - entry.Length) <= tolerance * (left + right) || entry.Depth >= MAX_SPLIT_DEPTH)
+            {
+                pieces.emplace_back(entry.A, left);
+                pieces.emplace_back(middle, right);
+                continue;
+            }
+            // Right half below, so the left one is finished first
+            stack[top++] = {middle, entry.B, right, entry.Depth + 1};
+            stack[top++] = {entry.A, middle, left, entry.Depth + 1};
+        }
+    }
+}
+
+ArcLengthTable::ArcLengthTable(const Curve& curve, Numeric tolerance, int thread_count)
+    : m_Curve(&curve),
+      m_Tolerance(tolerance)
+{
+    const int p = curve.Degree;
+    const int n = static_cast<int>(curve.ControlPoints.size());
+    std::vector<int> spans;
+    for (int i = p; i < n; ++i)
+    {
+        if (curve.Knots(i) < curve.Knots(i + 1)) spans.push_back(i);
+    }
+    const int span_count = static_cast<int>(spans.size());
+    const int workers = Utils::ResolveThreadCount(thread_count, span_count);
+    std::vector<Curve::EvaluationScratch> scratches(workers);
+    std::vector<std::vector<std::pair<Numeric, Numeric>>> pieces(span_count);
+    Utils::ParallelFor(span_count, workers, [&](int k, int worker)
+    {
+        const int span = spans[k];
+        IntegrateSpan(curve, curve.Knots(span), curve.Knots(span + 1), span, tolerance, scratches[worker], pieces[k]);
+    }, 1);
+
+    Numeric length = 0;
+    for (int k = 0; k < span_count; ++k)
+    {
+        for (const auto& [start, piece_length] : pieces[k])
+        {
+            m_Parameters.push_back(start);
+            m_Lengths.push_back(length);
+            m_Spans.push_back(spans[k]);
+            length += piece_length;
+        }
+    }
+    m_Parameters.push_back(curve.Knots(n));
+    m_Lengths.push_back(length);
+
+    // dx/ds = 1 / |C'|, limited to three times the secants on both sides (Fritsch and Carlson)
+    const int node_count = NodeCount();
+    m_Slopes.resize(node_count);
+    for (int j = 0; j < node_count; ++j)
+    {
+        const int span = m_Spans[std::min(j, node_count - 2)];
+        const Numeric speed = Speed(curve, m_Parameters[j], span, scratches.front());
+        Numeric slope = speed > 0 ? 1 / speed : std::numeric_limits<Numeric>::infinity();
+        for (int side : {j - 1, j})
+        {
+            if (side < 0 || side + 1 >= node_count) continue;
+            const Numeric ds = m_Lengths[side + 1] - m_Lengths[side];
+            if (ds > 0) slope = std::min(slope, 3 * (m_Parameters[side + 1] - m_Parameters[side]) / ds);
+        }
+        m_Slopes[j] = std::isfinite(slope) ? slope : 0;
+    }
+}
+
+Numeric ArcLengthTable::IntegrateFrom(int node, Numeric x, Curve::EvaluationScratch& scratch) const
+{
+    return x > m_Parameters[node] ? Integrate(*m_Curve, m_Parameters[node], x, m_Spans[node], scratch) : 0;
+}
+
+Numeric ArcLengthTable::LengthAt(Numeric x, Curve::EvaluationScratch& scratch) const
+{
+    x = std::clamp(x, m_Parameters.front(), m_Parameters.back());
+    const int node = std::clamp(static_cast<int>(std::upper_bound(m_Parameters.begin(), m_Parameters.end(), x) -
+                                                 m_Parameters.begin()) - 1, 0, NodeCount() - 2);
+    return m_Lengths[node] + IntegrateFrom(node, x, scratch);
+}
+
+Numeric ArcLengthTable::LengthAt(Numeric x) const
+{
+    Curve::EvaluationScratch scratch;
+    return LengthAt(x, scratch);
+}
+
+Numeric ArcLengthTable::ParameterAtLength(Numeric s, Curve::EvaluationScratch& scratch) const
+{
+    s = std::clamp(s, Numeric(0), Length());
+    // Zero length intervals are never chosen: upper_bound skips past them
+    const int node = std::clamp(static_cast<int>(std::upper_bound(m_Lengths.begin(), m_Lengths.end(), s) -
+                                                 m_Lengths.begin()) - 1, 0, NodeCount() - 2);
+    const Numeric x0 = m_Parameters[node], x1 = m_Parameters[node + 1];
+    const Numeric s0 = m_Lengths[node], h = m_Lengths[node + 1] - s0;
+    if (!(h > 0)) return x0;
+
+    const Numeric t = (s - s0) / h, t2 = t * t, t3 = t2 * t;
+    Numeric x = (2 * t3 - 3 * t2 + 1) * x0 + (t3 - 2 * t2 + t) * h * m_Slopes[node] +
+                (-2 * t3 + 3 * t2) * x1 + (t3 - t2) * h * m_Slopes[node + 1];
+    x = std::clamp(x, x0, x1);
+
+    const Numeric epsilon = m_Tolerance * Length();
+    for (int count = 0; count < NEWTON_ITERATION_COUNT; ++count)
+    {
+        const Numeric residual = s0 + IntegrateFrom(node, x, scratch) - s;
+        if (std::abs(residual) <= epsilon) break;
+        const Numeric speed = Speed(*m_Curve, x, m_Spans[node], scratch);
+        if (!(speed > 0)) break;
+        x = std::clamp(x - residual / speed, x0, x1);
+    }
+    return x;
+}
+
+Numeric ArcLengthTable::ParameterAtLength(Numeric s) const
+{
+    Curve::EvaluationScratch scratch;
+    return ParameterAtLength(s, scratch);
+}
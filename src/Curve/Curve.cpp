@@ -1,15 +1,22 @@
 #include "libnurbs/Curve/Curve.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
-#include <stack>
-#include <mdspan>
+#include <numbers>
 
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+#include "libnurbs/Algorithm/Bernstein.hpp"
 #include "libnurbs/Algorithm/DegreeAlgo.hpp"
 #include "libnurbs/Algorithm/KnotRemoval.hpp"
 #include "libnurbs/Algorithm/MathUtils.hpp"
+#include "libnurbs/Algorithm/PointProjection.hpp"
 #include "libnurbs/Basis/BSplineBasis.hpp"
+#include "libnurbs/Curve/CurvePointInversion.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
 #include "libnurbs/Utils/Serialization.hpp"
 
 
@@ -296,14 +303,14 @@ Vec3 Curve::Evaluate(Numeric x) const
 }
 
 
-vector<Vec4> Curve::HomogeneousDerivative(Numeric x, int order) const
+void Curve::HomogeneousDerivative(Numeric x, int index_span, int order, EvaluationScratch& scratch) const
 {
-    assert(x >= 0 && x <= 1);
-    int index_span = Knots.FindSpanIndex(Degree, x);
-    MatX basis     = BSplineBasis::EvaluateAll(Degree, Knots.Values(), index_span, x, order);
+    auto& basis = scratch.BasisDerivatives;
+    BSplineBasis::EvaluateAll(Degree, Knots.Values(), index_span, x, order, basis, scratch.Basis);
     assert(basis.rows() == order + 1);
     assert(basis.cols() == Degree + 1);
-    vector<Vec4> result(order + 1);
+    auto& result = scratch.HomogeneousDerivatives;
+    result.resize(order + 1);
     for (int k = 0; k <= order; ++k)
     {
         Vec4 tmp = Vec4::Zero();
@@ -314,7 +321,6 @@ vector<Vec4> Curve::HomogeneousDerivative(Numeric x, int order) const
         }
         result[k] = tmp;
     }
-    return result;
 }
 
 Vec3 Curve::EvaluateDerivative(Numeric x, int order) const
@@ -324,8 +330,22 @@ Vec3 Curve::EvaluateDerivative(Numeric x, int order) const
 
 vector<Vec3> Curve::EvaluateAll(Numeric x, int order) const
 {
-    auto homo_ders = HomogeneousDerivative(x, order);
-    vector<Vec3> result(order + 1, Vec3::Zero());
+    EvaluationScratch scratch;
+    auto result = EvaluateAll(x, order, scratch);
+    return {result.begin(), result.end()};
+}
+
+std::span<const Vec3> Curve::EvaluateAll(Numeric x, int order, EvaluationScratch& scratch, int index_span) const
+{
+    assert(x >= 0 && x <= 1);
+    if (index_span == INVALID_INDEX)
+    {
+        index_span = Knots.FindSpanIndex(Degree, x);
+    }
+    HomogeneousDerivative(x, index_span, order, scratch);
+    const auto& homo_ders = scratch.HomogeneousDerivatives;
+    auto& result          = scratch.Derivatives;
+    result.resize(order + 1);
 
     // Compute rational derivatives
     Numeric Wders0 = homo_ders[0].w();
@@ -468,6 +488,39 @@ Numeric Curve::BinarySearchParameter(const Vec3& point, Numeric epsilon, int max
     return (low + high) / 2.0;
 }
 
+vector<Curve::ProjectionResult> Curve::ProjectPoints(std::span<const Vec3> points,
+                                                    Numeric epsilon,
+                                                    int max_iteration_count,
+                                                    int thread_count) const
+{
+    const int count = static_cast<int>(points.size());
+    vector<ProjectionResult> results(count);
+    if (count == 0)
+        return results;
+
+    // Seeds are shared read-only, evaluation scratch is owned by one worker each.
+    auto seeds = BuildProjectionSeeds(*this, 2 * Degree + 1);
+    int workers = Utils::ResolveThreadCount(thread_count, count);
+    vector<EvaluationScratch> scratches(workers);
+
+    Utils::ParallelFor(count, workers, [&](int i, int worker)
+    {
+        const Vec3& point = points[i];
+        auto& result      = results[i];
+        int index_span    = INVALID_INDEX;
+        result.Parameter  = seeds.ParametersU[FindNearestSeed(seeds, point)];
+        result.Converged  = RefineProjection(*this, point, result.Parameter, index_span, result.Point,
+                                             scratches[worker], epsilon, max_iteration_count);
+        result.Distance   = (result.Point - point).norm();
+    });
+    return results;
+}
+
+Curve::ProjectionResult Curve::ClosestPoint(const Vec3& point) const
+{
+    return CurvePointInversion(*this).Project(point);
+}
+
 Curve Curve::InsertKnot(Numeric knot_value) const
 {
     Curve result{*this};
@@ -549,120 +602,348 @@ Curve Curve::Transform(const Mat3x3& R) const
 
 vector<Curve> Curve::ExtractBezier() const
 {
-    Curve bezier = *this;
-    auto pairs   = this->Knots.GetKnotPairs();
-    for (auto& item : pairs)
-    {
-        Numeric u = item.Value;
-        int mult  = item.Multiplicity;
-        if (u <= Numeric(0.0) || u >= Numeric(1.0))
-            continue;
-        if (mult >= Degree)
-            continue;
-        bezier = bezier.InsertKnot(u, Degree - mult);
-    }
-
-    vector<Curve> segments;
-    segments.reserve(pairs.size());
-    const auto& ctrl = bezier.ControlPoints;
-    int p            = bezier.Degree;
+    const int p = Degree;
+    vector<Vec4> homogeneous(ControlPoints.size());
+    std::transform(ControlPoints.begin(), ControlPoints.end(), homogeneous.begin(), ToHomo);
+    vector<Vec4> bezier_points;
+    vector<Numeric> breakpoints;
+    const int segment_count = DecomposeCurve(p, Knots, homogeneous, bezier_points, breakpoints);
 
-    for (int i = 0; i + p < ctrl.size(); i += p)
+    vector<Curve> segments(segment_count);
+    for (int s = 0; s < segment_count; ++s)
     {
-        Curve seg;
+        Curve& seg = segments[s];
         seg.Degree = p;
         seg.Knots  = KnotVector::Uniform(p, 2 * p + 2);
         seg.ControlPoints.resize(p + 1);
-        for (int k = 0; k <= p; ++k)
-        {
-            seg.ControlPoints[k] = ctrl[i + k];
-        }
-        segments.emplace_back(std::move(seg));
+        std::transform(bezier_points.begin() + s * (p + 1), bezier_points.begin() + (s + 1) * (p + 1),
+                       seg.ControlPoints.begin(), FromHomo);
     }
     return segments;
 }
 
-BoundingBox Curve::GetBoundingBox(Numeric epsilon) const
+BoundingBox Curve::GetBoundingBox(Numeric epsilon, int thread_count) const
 {
-    auto segments = this->ExtractBezier();
-    int p         = this->Degree;
+    // Halving a segment more often than this cannot tighten a double precision box.
+    constexpr int MAX_DEPTH = 32;
+    const int p = Degree;
+    vector<Vec4> homogeneous(ControlPoints.size());
+    std::transform(ControlPoints.begin(), ControlPoints.end(), homogeneous.begin(), ToHomo);
+    vector<Vec4> bezier_points;
+    vector<Numeric> breakpoints;
+    const int segment_count = DecomposeCurve(p, Knots, homogeneous, bezier_points, breakpoints);
+
+    // Depth first halving keeps at most one pending piece per level, so each worker gets a fixed
+    // arena of MAX_DEPTH + 1 pieces up front and the subdivision itself never allocates.
+    const int stride  = p + 1;
+    const int workers = Utils::ResolveThreadCount(thread_count, segment_count);
+    vector<Vec4> arenas(workers * (MAX_DEPTH + 1) * stride);
+    vector<BoundingBox> boxes(segment_count);
+
+    Utils::ParallelFor(segment_count, workers, [&](int s, int worker)
+    {
+        Vec4* arena = arenas.data() + worker * (MAX_DEPTH + 1) * stride;
+        int depths[MAX_DEPTH + 1];
+        std::copy(bezier_points.begin() + s * stride, bezier_points.begin() + (s + 1) * stride, arena);
+        depths[0] = 0;
+        int top   = 1;
+
+        Vec3 start = FromHomo(arena[0]).head<3>();
+        BoundingBox box(start, start);
+        while (top > 0)
+        {
+            Vec4* Q   = arena + (top - 1) * stride;
+            int depth = depths[top - 1];
+
+            // Box of the control polygon against the box of the end points
+            Vec3 A = FromHomo(Q[0]).head<3>();
+            Vec3 B = FromHomo(Q[p]).head<3>();
+            BoundingBox control(A, B);
+            for (int i = 1; i < p; ++i)
+            {
+                control.ExpandToInclude(Vec3(FromHomo(Q[i]).head<3>()));
+            }
+            BoundingBox ends(A, B);
+            bool small_enough = control.Length().norm() <= epsilon;
+            bool flat_enough  = Approx(control.Min, ends.Min, 1e-6) && Approx(control.Max, ends.Max, 1e-6);
+            if (small_enough || flat_enough || depth >= MAX_DEPTH)
+            {
+                box.ExpandToInclude(ends);
+                top--;
+                continue;
+            }
 
-    auto to3 = [&](const Vec4& v) -> Vec3
-    {
-        return v.head<3>();
-    };
+            // de Casteljau at the middle: Q becomes the right half, the left half goes on top.
+            Vec4* L = Q + stride;
+            L[0]    = Q[0];
+            for (int r = 1; r <= p; ++r)
+            {
+                for (int i = 0; i <= p - r; ++i)
+                {
+                    Q[i] = 0.5 * (Q[i] + Q[i + 1]);
+                }
+                L[r] = Q[0];
+            }
+            depths[top - 1] = depth + 1;
+            depths[top]     = depth + 1;
+            top++;
+        }
+        boxes[s] = box;
+    }, 8);
 
-    // if p <= 5, use static buffer
-    vector<Vec4> b((p + 1) * (p + 1));
-    using std_2dspan = mdspan<Vec4, extents<int, dynamic_extent, dynamic_extent>>;
+    BoundingBox result = boxes.front();
+    for (const auto& box : boxes)
+    {
+        result.ExpandToInclude(box);
+    }
+    return result;
+}
 
-    bool initialized = false;
-    BoundingBox globalBox;
-    for (auto& seg : segments)
+BoundingBox Curve::GetExactBoundingBox(int thread_count) const
+{
+    const int p = Degree;
+    if (2 * p - 1 > MAX_BERNSTEIN_DEGREE)
     {
-        stack<vector<Vec4>> stack;
-        stack.push(std::move(seg.ControlPoints));
-        while (!stack.empty())
+        throw std::runtime_error("Curve degree too high for exact bounding box.");
+    }
+    vector<Vec4> homogeneous(ControlPoints.size());
+    std::transform(ControlPoints.begin(), ControlPoints.end(), homogeneous.begin(), ToHomo);
+    vector<Vec4> bezier_points;
+    vector<Numeric> breakpoints;
+    const int segment_count = DecomposeCurve(p, Knots, homogeneous, bezier_points, breakpoints);
+
+    const int workers = Utils::ResolveThreadCount(thread_count, segment_count);
+    vector<vector<Numeric>> roots(workers);
+    vector<Vec4> arenas(workers * (p + 1));
+    vector<BoundingBox> boxes(segment_count);
+
+    Utils::ParallelFor(segment_count, workers, [&](int s, int worker)
+    {
+        const Vec4* Q  = bezier_points.data() + s * (p + 1);
+        Vec4* casteljau = arenas.data() + worker * (p + 1);
+        auto& ts        = roots[worker];
+        ts.clear();
+
+        // Extrema of x = X / W inside the segment are roots of X'W - XW', or of X' alone when W is
+        // constant. Coefficients are in Bernstein form, the constant factor p is dropped.
+        bool rational = false;
+        for (int i = 1; i <= p; ++i)
+        {
+            rational = rational || Q[i].w() != Q[0].w();
+        }
+        std::array<Numeric, MAX_BERNSTEIN_DEGREE + 1> X, W, dX, dW, XdW, hodograph;
+        for (int i = 0; i <= p; ++i)
+        {
+            W[i] = Q[i].w();
+            if (i < p) dW[i] = Q[i + 1].w() - Q[i].w();
+        }
+        for (int d = 0; d < 3; ++d)
         {
-            auto ctrlPts = std::move(stack.top());
-            stack.pop();
+            for (int i = 0; i <= p; ++i)
+            {
+                X[i] = Q[i][d];
+                if (i < p) dX[i] = Q[i + 1][d] - Q[i][d];
+            }
+            if (!rational)
+            {
+                FindBernsteinRoots({dX.data(), size_t(p)}, 1e-12, ts);
+                continue;
+            }
+            BernsteinMultiply({dX.data(), size_t(p)}, {W.data(), size_t(p + 1)}, {hodograph.data(), size_t(2 * p)});
+            BernsteinMultiply({X.data(), size_t(p + 1)}, {dW.data(), size_t(p)}, {XdW.data(), size_t(2 * p)});
+            for (int i = 0; i < 2 * p; ++i)
+            {
+                hodograph[i] -= XdW[i];
+            }
+            FindBernsteinRoots({hodograph.data(), size_t(2 * p)}, 1e-12, ts);
+        }
 
-            // Bounding-box of control points net
-            BoundingBox cpBox(to3(ctrlPts[0]), to3(ctrlPts[0]));
-            for (size_t m = 1; m < ctrlPts.size(); ++m)
+        Vec3 start = FromHomo(Q[0]).head<3>();
+        BoundingBox box(start, start);
+        box.ExpandToInclude(Vec3(FromHomo(Q[p]).head<3>()));
+        for (Numeric t : ts)
+        {
+            std::copy(Q, Q + p + 1, casteljau);
+            for (int r = 1; r <= p; ++r)
             {
-                Vec3 p3 = to3(ctrlPts[m]);
-                cpBox.ExpandToInclude(p3);
+                for (int i = 0; i <= p - r; ++i)
+                {
+                    casteljau[i] = (1 - t) * casteljau[i] + t * casteljau[i + 1];
+                }
             }
+            box.ExpandToInclude(Vec3(FromHomo(casteljau[0]).head<3>()));
+        }
+        boxes[s] = box;
+    }, 8);
 
-            // Bounding-box of end points
-            Vec3 A = to3(ctrlPts.front());
-            Vec3 B = to3(ctrlPts.back());
-            BoundingBox epBox(A, B);
+    BoundingBox result = boxes.front();
+    for (const auto& box : boxes)
+    {
+        result.ExpandToInclude(box);
+    }
+    return result;
+}
 
-            // is this condition working?
-            bool small_enough = cpBox.Length().norm() <= epsilon;
+void Curve::Tessellate(Numeric chord_tolerance, Numeric angle_tolerance, Polyline& output) const
+{
+    // Halving a segment more often than this cannot improve a double precision polyline.
+    constexpr int MAX_DEPTH = 32;
+    const int p             = Degree;
+    output.Clear();
+
+    vector<Vec4> homogeneous(ControlPoints.size());
+    std::transform(ControlPoints.begin(), ControlPoints.end(), homogeneous.begin(), ToHomo);
+    vector<Vec4> bezier_points;
+    vector<Numeric> breakpoints;
+    const int segment_count = DecomposeCurve(p, Knots, homogeneous, bezier_points, breakpoints);
+
+    const Numeric tolerance2 = chord_tolerance * chord_tolerance;
+    const Numeric cos_angle  = angle_tolerance > 0 ? std::cos(std::min(angle_tolerance, std::numbers::pi / 2))
+                                                   : -2;
+    vector<Vec3> cartesian(p + 1);
+    auto is_flat = [&](const Vec4* Q)
+    {
+        for (int i = 0; i <= p; ++i)
+        {
+            cartesian[i] = FromHomo(Q[i]).head<3>();
+        }
+        Vec3 chord      = cartesian[p] - cartesian[0];
+        Numeric length2 = chord.squaredNorm();
+        for (int i = 1; i < p; ++i)
+        {
+            Vec3 offset = cartesian[i] - cartesian[0];
+            Numeric t   = length2 > 0 ? std::clamp(offset.dot(chord) / length2, Numeric(0), Numeric(1)) : 0;
+            if ((offset - t * chord).squaredNorm() > tolerance2)
+                return false;
+        }
+        for (int i = 0; i < p; ++i)
+        {
+            Vec3 leg = cartesian[i + 1] - cartesian[i];
+            if (leg.dot(chord) < cos_angle * std::sqrt(leg.squaredNorm() * length2))
+                return false;
+        }
+        return true;
+    };
 
-            bool flat_enough = Approx(cpBox.Min, epBox.Min, 1e-6) &&
-                               Approx(cpBox.Max, epBox.Max, 1e-6);
+    // Pieces waiting for subdivision, the last one is processed first so parameters come out sorted.
+    struct Piece
+    {
+        Numeric Low;
+        Numeric High;
+        int Depth;
+    };
+    vector<Piece> pieces;
+    vector<Vec4> pool;
+    vector<Vec4> split(p + 1);
 
-            if (small_enough || flat_enough)
+    output.Parameters.push_back(breakpoints.front());
+    output.Points.push_back(FromHomo(bezier_points.front()).head<3>());
+    for (int s = 0; s < segment_count; ++s)
+    {
+        pieces.push_back({breakpoints[s], breakpoints[s + 1], 0});
+        pool.assign(bezier_points.begin() + s * (p + 1), bezier_points.begin() + (s + 1) * (p + 1));
+        while (!pieces.empty())
+        {
+            Piece piece = pieces.back();
+            Vec4* Q     = pool.data() + (pieces.size() - 1) * (p + 1);
+            if (piece.Depth >= MAX_DEPTH || is_flat(Q))
             {
-                if (!initialized)
-                {
-                    globalBox   = epBox;
-                    initialized = true;
-                }
-                else
+                output.Parameters.push_back(piece.High);
+                output.Points.push_back(FromHomo(Q[p]).head<3>());
+                pieces.pop_back();
+                pool.resize(pieces.size() * (p + 1));
+                continue;
+            }
+
+            // de Casteljau at the middle: Q becomes the right half, split the left half.
+            split[0] = Q[0];
+            for (int r = 1; r <= p; ++r)
+            {
+                for (int i = 0; i <= p - r; ++i)
                 {
-                    globalBox.ExpandToInclude(epBox);
+                    Q[i] = 0.5 * (Q[i] + Q[i + 1]);
                 }
-                continue;
+                split[r] = Q[0];
             }
+            Numeric middle = 0.5 * (piece.Low + piece.High);
+            pieces.back()  = {middle, piece.High, piece.Depth + 1};
+            pieces.push_back({piece.Low, middle, piece.Depth + 1});
+            pool.insert(pool.end(), split.begin(), split.end());
+        }
+    }
+}
 
-            std_2dspan b_view{b.data(), p + 1, p + 1};
-            // fill first row
-            for (int s = 0; s <= p; ++s)
+void Curve::SampleUniform(int n_per_span, Polyline& output) const
+{
+    assert(n_per_span >= 1);
+    const int p = Degree;
+    output.Clear();
+
+    vector<Vec4> homogeneous(ControlPoints.size());
+    std::transform(ControlPoints.begin(), ControlPoints.end(), homogeneous.begin(), ToHomo);
+    vector<Vec4> bezier_points;
+    vector<Numeric> breakpoints;
+    const int segment_count = DecomposeCurve(p, Knots, homogeneous, bezier_points, breakpoints);
+
+    output.Parameters.reserve(segment_count * n_per_span + 1);
+    output.Points.reserve(segment_count * n_per_span + 1);
+    output.Parameters.push_back(breakpoints.front());
+    output.Points.push_back(FromHomo(bezier_points.front()).head<3>());
+
+    // Forward differences of the monomials: delta[j][m] = j-th difference of k^m at k = 0,
+    // premultiplied by h^m so the table entry of order j comes out proportional to h^j.
+    const Numeric h = Numeric(1) / n_per_span;
+    MatX delta      = MatX::Zero(p + 1, p + 1);
+    for (int j = 0; j <= p; ++j)
+    {
+        for (int m = j; m <= p; ++m)
+        {
+            Numeric sum = 0;
+            for (int i = 0; i <= j; ++i)
             {
-                b_view[0, s] = ctrlPts[s];
+                sum += ((j - i) % 2 ? -1 : 1) * Binomial(j, i) * std::pow(Numeric(i), m);
             }
+            delta(j, m) = sum * std::pow(h, m);
+        }
+    }
 
-            for (int r = 1; r <= p; ++r)
+    vector<Vec4> table(p + 1), power(p + 1);
+    for (int s = 0; s < segment_count; ++s)
+    {
+        const Vec4* Q = bezier_points.data() + s * (p + 1);
+
+        // Power basis coefficients of the segment. Building the table from them instead of
+        // differencing sampled values avoids cancellation in the high order differences.
+        for (int m = 0; m <= p; ++m)
+        {
+            power[m] = Vec4::Zero();
+            for (int i = 0; i <= m; ++i)
             {
-                for (int s = 0; s <= p - r; ++s)
-                {
-                    b_view[r, s] = b_view[r - 1, s] * 0.5 + b_view[r - 1, s + 1] * 0.5;
-                }
+                power[m] += ((m - i) % 2 ? -1 : 1) * Binomial(m, i) * Q[i];
+            }
+            power[m] *= Binomial(p, m);
+        }
+        for (int j = 0; j <= p; ++j)
+        {
+            table[j] = Vec4::Zero();
+            for (int m = j; m <= p; ++m)
+            {
+                table[j] += delta(j, m) * power[m];
             }
-            vector<Vec4> L(p + 1), R(p + 1);
-            for (int r = 0; r <= p; ++r)
+        }
+
+        Numeric low  = breakpoints[s];
+        Numeric high = breakpoints[s + 1];
+        for (int k = 1; k < n_per_span; ++k)
+        {
+            for (int j = 0; j < p; ++j)
             {
-                L[r] = b_view[r, 0];
-                R[r] = b_view[p - r, r];
+                table[j] += table[j + 1];
             }
-            stack.push(std::move(R));
-            stack.push(std::move(L));
+            output.Parameters.push_back(low + (high - low) * k * h);
+            output.Points.push_back(FromHomo(table[0]).head<3>());
         }
+        output.Parameters.push_back(high);
+        output.Points.push_back(FromHomo(Q[p]).head<3>());
     }
-    return globalBox;
 }
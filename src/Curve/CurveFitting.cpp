@@ -0,0 +1,385 @@
+#include "libnurbs/Curve/Curve.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <stdexcept>
+
+#include "libnurbs/Algorithm/BandedMatrix.hpp"
+#include "libnurbs/Basis/BSplineBasis.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    // Increasing parameters in [0, 1], one per point
+    std::vector<Numeric> ComputeParameters(std::span<const Vec3> points, Curve::Parameterization parameterization)
+    {
+        const int count = static_cast<int>(points.size());
+        std::vector<Numeric> parameters(count, 0);
+        Numeric total = 0;
+        if (parameterization != Curve::Parameterization::Uniform)
+        {
+            for (int k = 1; k < count; ++k)
+            {
+                const Numeric chord = (points[k] - points[k - 1]).norm();
+                total += parameterization == Curve::Parameterization::Centripetal ? std::sqrt(chord) : chord;
+                parameters[k] = total;
+            }
+        }
+        if (!(total > 0))
+        {
+            for (int k = 1; k < count; ++k)
+            {
+                parameters[k] = static_cast<Numeric>(k) / (count - 1);
+            }
+            return parameters;
+        }
+        for (int k = 1; k < count - 1; ++k)
+        {
+            parameters[k] /= total;
+        }
+        parameters.back() = 1;
+        return parameters;
+    }
+
+    // Clamped knots, interior ones the running averages of degree consecutive parameters (The NURBS Book, 9.8)
+    KnotVector AverageKnots(const std::vector<Numeric>& parameters, int degree)
+    {
+        const int n = static_cast<int>(parameters.size()) - 1;
+        std::vector<Numeric> knots(n + degree + 2, 0);
+        std::fill(knots.end() - degree - 1, knots.end(), 1);
+        Numeric sum = 0;
+        for (int i = 1; i < degree; ++i)
+        {
+            sum += parameters[i];
+        }
+        for (int j = 1; j <= n - degree; ++j)
+        {
+            sum += parameters[j + degree - 1];
+            knots[j + degree] = sum / degree;
+            sum -= parameters[j];
+        }
+        return KnotVector(knots);
+    }
+
+    // Clamped knots of a fit with control_point_count control points, every span holding parameters (9.68, 9.69)
+    KnotVector ApproximationKnots(const std::vector<Numeric>& parameters, int degree, int control_point_count)
+    {
+        const int m = static_cast<int>(parameters.size()) - 1;
+        const int n = control_point_count - 1;
+        std::vector<Numeric> knots(n + degree + 2, 0);
+        std::fill(knots.end() - degree - 1, knots.end(), 1);
+        const Numeric d = static_cast<Numeric>(m + 1) / (n - degree + 1);
+        for (int j = 1; j <= n - degree; ++j)
+        {
+            const int i = static_cast<int>(j * d);
+            const Numeric alpha = j * d - i;
+            knots[degree + j] = (1 - alpha) * parameters[i - 1] + alpha * parameters[i];
+        }
+        return KnotVector(knots);
+    }
+
+    // Basis of every point evaluated once per fit, then reused by the normal equations and the error pass
+    class LeastSquaresFit
+    {
+    public:
+        LeastSquaresFit(std::span<const Vec3> points, std::span<const Numeric> weights,
+                        std::vector<Numeric> parameters, int degree)
+            : m_Points(points),
+              m_Weights(weights),
+              m_Parameters(std::move(parameters)),
+              m_Degree(degree),
+              m_Spans(m_Points.size()),
+              m_Basis(m_Points.size() * (degree + 1))
+        {
+        }
+
+        [[nodiscard]] const std::vector<Numeric>& Parameters() const
+        {
+            return m_Parameters;
+        }
+
+        [[nodiscard]] const std::vector<int>& Spans() const
+        {
+            return m_Spans;
+        }
+
+        [[nodiscard]] Numeric Weight(int k) const
+        {
+            return m_Weights.empty() ? 1 : m_Weights[k];
+        }
+
+        // Schoenberg-Whitney for the interior control points: each needs its own weighted interior point, of
+        // a parameter distinct from the others, strictly inside its support, else the normal equations are
+        // singular. Returns the first control point without one, or INVALID_INDEX.
+        [[nodiscard]] int FindUnsupportedControlPoint(const std::vector<Numeric>& knots) const
+        {
+            const int p = m_Degree;
+            const int n = static_cast<int>(knots.size()) - p - 2;
+            const int count = static_cast<int>(m_Parameters.size());
+            // Supports are ordered at both ends, so taking the first usable point for each is optimal
+            Numeric previous = -1;
+            for (int i = 1, k = 1; i < n; ++i)
+            {
+                while (k < count - 1 && (Weight(k) == 0 || !(m_Parameters[k] > std::max(knots[i], previous))))
+                {
+                    ++k;
+                }
+                if (k == count - 1 || !(m_Parameters[k] < knots[i + p + 1])) return i;
+                previous = m_Parameters[k++];
+            }
+            return INVALID_INDEX;
+        }
+
+        // Control points on the knots through the first and last point, least squares for the others
+        Curve Fit(KnotVector knots)
+        {
+            const int p = m_Degree;
+            const int count = static_cast<int>(m_Points.size());
+            Curve result;
+            result.Degree = p;
+            result.Knots = std::move(knots);
+            const int n = result.Knots.Count() - p - 2;
+
+            BSplineBasis::Scratch scratch;
+            for (int k = 0, span = INVALID_INDEX; k < count; ++k)
+            {
+                span = result.Knots.FindSpanIndex(p, m_Parameters[k], span);
+                m_Spans[k] = span;
+                BSplineBasis::Evaluate(p, result.Knots.Values(), span, m_Parameters[k], Basis(k), scratch);
+            }
+
+            // Unknowns are the interior control points 1..n-1, the end ones move to the right hand side
+            const Vec3& first = m_Points.front();
+            const Vec3& last = m_Points.back();
+            BandedMatrix normal(std::max(n - 1, 0), p, 0);
+            MatX rhs = MatX::Zero(std::max(n - 1, 0), 3);
+            for (int k = 1; k < count - 1; ++k)
+            {
+                const Numeric weight = Weight(k);
+                if (weight == 0) continue;
+                const Numeric* basis = Basis(k);
+                const int offset = m_Spans[k] - p;
+                Vec3 residual = m_Points[k];
+                if (offset == 0) residual -= basis[0] * first;
+                if (offset + p == n) residual -= basis[p] * last;
+                for (int a = 0; a <= p; ++a)
+                {
+                    const int i = offset + a;
+                    if (i < 1 || i > n - 1) continue;
+                    rhs.row(i - 1) += weight * basis[a] * residual.transpose();
+                    for (int b = 0; b <= a; ++b)
+                    {
+                        const int j = offset + b;
+                        if (j >= 1) normal(i - 1, j - 1) += weight * basis[a] * basis[b];
+                    }
+                }
+            }
+            if (!normal.FactorizeCholesky())
+            {
+                throw std::runtime_error("Approximation system is singular, too few weighted points per span?");
+            }
+            normal.SolveCholesky(rhs);
+
+            result.ControlPoints.resize(n + 1);
+            result.ControlPoints.front() << first, 1;
+            result.ControlPoints.back() << last, 1;
+            for (int i = 1; i < n; ++i)
+            {
+                result.ControlPoints[i] << rhs.row(i - 1).transpose(), 1;
+            }
+            return result;
+        }
+
+        // Distance between point k and the fitted curve at its parameter
+        [[nodiscard]] Numeric Distance(const Curve& curve, int k) const
+        {
+            const Numeric* basis = Basis(k);
+            Vec3 point = Vec3::Zero();
+            for (int a = 0; a <= m_Degree; ++a)
+            {
+                point += basis[a] * curve.ControlPoints[m_Spans[k] - m_Degree + a].head<3>();
+            }
+            return (point - m_Points[k]).norm();
+        }
+
+    private:
+        Numeric* Basis(int k)
+        {
+            return m_Basis.data() + static_cast<size_t>(k) * (m_Degree + 1);
+        }
+
+        [[nodiscard]] const Numeric* Basis(int k) const
+        {
+            return m_Basis.data() + static_cast<size_t>(k) * (m_Degree + 1);
+        }
+
+        std::span<const Vec3> m_Points;
+        std::span<const Numeric> m_Weights;
+        std::vector<Numeric> m_Parameters;
+        int m_Degree;
+        std::vector<int> m_Spans;
+        std::vector<Numeric> m_Basis;
+    };
+
+    // Knot strictly between two of the weighted points, as near to their median as distinct parameters allow,
+    // so both new spans keep a point. Returns -1 if all of them share one parameter.
+    Numeric SplitParameter(const std::vector<Numeric>& parameters, const std::vector<int>& points)
+    {
+        const int count = static_cast<int>(points.size());
+        const int middle = count / 2;
+        for (int offset = 0; offset < count; ++offset)
+        {
+            for (const int j : {middle - offset, middle + offset + 1})
+            {
+                if (j < 1 || j >= count) continue;
+                const Numeric before = parameters[points[j - 1]], after = parameters[points[j]];
+                const Numeric knot = (before + after) / 2;
+                if (before < knot && knot < after) return knot;
+            }
+        }
+        return -1;
+    }
+
+    void CheckApproximationInput(std::span<const Vec3> points, int degree, std::span<const Numeric> weights)
+    {
+        if (degree < 1 || static_cast<int>(points.size()) < degree + 1)
+        {
+            throw std::runtime_error("Approximation needs at least degree + 1 points.");
+        }
+        if (!weights.empty() && weights.size() != points.size())
+        {
+            throw std::runtime_error("Approximation needs one weight per point.");
+        }
+    }
+}
+
+Curve Curve::Interpolate(std::span<const Vec3> points, int degree, Parameterization parameterization)
+{
+    const int count = static_cast<int>(points.size());
+    if (degree < 1 || count < degree + 1)
+    {
+        throw std::runtime_error("Interpolation needs at least degree + 1 points.");
+    }
+
+    const std::vector<Numeric> parameters = ComputeParameters(points, parameterization);
+    Curve result;
+    result.Degree = degree;
+    result.Knots = AverageKnots(parameters, degree);
+
+    // The span of each row fixes its columns [span - degree, span], and so the band
+    std::vector<int> spans(count);
+    int lower = 0, upper = 0;
+    for (int k = 0, span = INVALID_INDEX; k < count; ++k)
+    {
+        span = result.Knots.FindSpanIndex(degree, parameters[k], span);
+        spans[k] = span;
+        lower = std::max(lower, k - (span - degree));
+        upper = std::max(upper, span - k);
+    }
+
+    BandedMatrix matrix(count, lower, upper);
+    BSplineBasis::Scratch scratch;
+    std::vector<Numeric> basis(degree + 1);
+    for (int k = 0; k < count; ++k)
+    {
+        BSplineBasis::Evaluate(degree, result.Knots.Values(), spans[k], parameters[k], basis.data(), scratch);
+        for (int r = 0; r <= degree; ++r)
+        {
+            matrix(k, spans[k] - degree + r) = basis[r];
+        }
+    }
+    if (!matrix.FactorizeLU())
+    {
+        throw std::runtime_error("Interpolation system is singular, are neighbouring points coincident?");
+    }
+
+    MatX rhs(count, 3);
+    for (int k = 0; k < count; ++k)
+    {
+        rhs.row(k) = points[k].transpose();
+    }
+    matrix.SolveLU(rhs);
+    result.ControlPoints.resize(count);
+    for (int k = 0; k < count; ++k)
+    {
+        result.ControlPoints[k] << rhs.row(k).transpose(), 1;
+    }
+    return result;
+}
+
+Curve Curve::Approximate(std::span<const Vec3> points, int degree, int control_point_count,
+                         std::span<const Numeric> weights, Parameterization parameterization)
+{
+    CheckApproximationInput(points, degree, weights);
+    if (control_point_count < degree + 1 || control_point_count > static_cast<int>(points.size()))
+    {
+        throw std::runtime_error("Approximation needs degree + 1 to point count control points.");
+    }
+    LeastSquaresFit fit(points, weights, ComputeParameters(points, parameterization), degree);
+    return fit.Fit(ApproximationKnots(fit.Parameters(), degree, control_point_count));
+}
+
+Curve Curve::ApproximateToTolerance(std::span<const Vec3> points, int degree, Numeric tolerance,
+                                    std::span<const Numeric> weights, Parameterization parameterization)
+{
+    CheckApproximationInput(points, degree, weights);
+    const int count = static_cast<int>(points.size());
+    LeastSquaresFit fit(points, weights, ComputeParameters(points, parameterization), degree);
+    const std::vector<Numeric>& parameters = fit.Parameters();
+
+    Curve result = fit.Fit(ApproximationKnots(parameters, degree, degree + 1));
+    std::vector<int> spans = fit.Spans();
+    std::vector<int> weighted;
+    while (true)
+    {
+        // Points are sorted by parameter, so each span holds a run of them
+        std::vector<Numeric> knots = result.Knots.Values();
+        const size_t knot_count = knots.size();
+        for (int begin = 0; begin < count;)
+        {
+            int end = begin;
+            Numeric error = 0;
+            weighted.clear();
+            for (; end < count && spans[end] == spans[begin]; ++end)
+            {
+                if (fit.Weight(end) == 0) continue;
+                weighted.push_back(end);
+                error = std::max(error, fit.Distance(result, end));
+            }
+            if (error > tolerance && weighted.size() >= 2)
+            {
+                const Numeric knot = SplitParameter(parameters, weighted);
+                if (result.Knots(spans[begin]) < knot && knot < result.Knots(spans[begin] + 1)) knots.push_back(knot);
+            }
+            begin = end;
+        }
+        if (knots.size() == knot_count) break;
+        const std::vector<Numeric> added(knots.begin() + static_cast<std::ptrdiff_t>(knot_count), knots.end());
+        std::inplace_merge(knots.begin(), knots.begin() + static_cast<std::ptrdiff_t>(knot_count), knots.end());
+
+        // The current knots satisfy Schoenberg-Whitney, so a failure is caused by an added knot up to the end
+        // of the support found, drop the last such one until none fails
+        int i;
+        while ((i = fit.FindUnsupportedControlPoint(knots)) != INVALID_INDEX)
+        {
+            int last = i + degree + 1;
+            while (!std::binary_search(added.begin(), added.end(), knots[last])) --last;
+            knots.erase(knots.begin() + last);
+        }
+        if (knots.size() == knot_count) break;
+
+        // Rounding may still leave the system numerically singular, the last fit is then the best one
+        try
+        {
+            result = fit.Fit(KnotVector(knots));
+        }
+        catch (const std::runtime_error&)
+        {
+            break;
+        }
+        spans = fit.Spans();
+    }
+    return result;
+}
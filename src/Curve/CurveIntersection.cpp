@@ -0,0 +1,564 @@
+#include "libnurbs/Curve/CurveIntersection.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "libnurbs/Algorithm/Bernstein.hpp"
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+#include "libnurbs/Core/BoundingBoxArray.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    // Pieces this narrow in both segment parameters are handed to Newton.
+    constexpr Numeric CLIP_TOLERANCE = 1e-7;
+    // Halvings per segment pair; depth first, so the arenas hold at most one pending piece per level.
+    constexpr int MAX_SPLIT_DEPTH = 40;
+    constexpr int MAX_CLIP_COUNT = 64;
+    constexpr int NEWTON_ITERATION_COUNT = 32;
+    // Results closer than this in both parameters, relative to the curve domains, are one intersection.
+    constexpr Numeric MERGE_TOLERANCE = 1e-6;
+
+    struct Segments
+    {
+        int Degree;
+        std::vector<Vec4> Points{};
+        std::vector<Numeric> Breakpoints{};
+        std::vector<BoundingBox> Boxes{};
+
+        explicit Segments(const Curve& curve)
+            : Degree(curve.Degree)
+        {
+            if (Degree > MAX_BERNSTEIN_DEGREE)
+            {
+                throw std::runtime_error("Curve degree is too high for intersection.");
+            }
+            std::vector<Vec4> homogeneous(curve.ControlPoints.size());
+            std::transform(curve.ControlPoints.begin(), curve.ControlPoints.end(), homogeneous.begin(), ToHomo);
+            const int count = DecomposeCurve(Degree, curve.Knots, homogeneous, Points, Breakpoints);
+            Boxes.reserve(count);
+            for (int s = 0; s < count; ++s)
+            {
+                Boxes.push_back(PieceBox(Points.data() + s * (Degree + 1), Degree));
+            }
+        }
+
+        [[nodiscard]] int Count() const
+        {
+            return static_cast<int>(Boxes.size());
+        }
+
+        static BoundingBox PieceBox(const Vec4* points, int degree)
+        {
+            Vec3 first = FromHomo(points[0]).head<3>();
+            BoundingBox box(first, first);
+            for (int i = 1; i <= degree; ++i)
+            {
+                box.ExpandToInclude(Vec3(FromHomo(points[i]).head<3>()));
+            }
+            return box;
+        }
+    };
+
+    struct Piece
+    {
+        Numeric A0, A1, B0, B1;
+        int Depth;
+    };
+
+    Vec3 Cartesian(const Vec4& point)
+    {
+        return point.head<3>() / point.w();
+    }
+
+    /**
+     * Two slabs around the chord of a piece that contain its control points, widened by the tolerance.
+     * The first slab is normal to the farthest bend of the polygon off the chord, so the second one is
+     * thin for planar pieces.
+     */
+    struct FatRegion
+    {
+        Vec3 Normals[2];
+        Numeric Low[2];
+        Numeric High[2];
+
+        FatRegion(const Vec4* points, int degree, Numeric tolerance)
+        {
+            const Vec3 start = Cartesian(points[0]);
+            Vec3 axis = Cartesian(points[degree]) - start;
+            for (int i = 1; i < degree && axis.squaredNorm() == 0; ++i)
+            {
+                axis = Cartesian(points[i]) - start;
+            }
+            axis = axis.squaredNorm() > 0 ? axis.normalized() : Vec3::UnitX();
+
+            Vec3 bend = Vec3::Zero();
+            for (int i = 1; i < degree; ++i)
+            {
+                Vec3 offset = Cartesian(points[i]) - start;
+                offset -= offset.dot(axis) * axis;
+                if (offset.squaredNorm() > bend.squaredNorm()) bend = offset;
+            }
+            Normals[0] = bend.squaredNorm() > 0 ? bend.normalized() : axis.unitOrthogonal();
+            Normals[1] = axis.cross(Normals[0]);
+
+            for (int k = 0; k < 2; ++k)
+            {
+                Low[k]  = std::numeric_limits<Numeric>::max();
+                High[k] = -std::numeric_limits<Numeric>::max();
+                for (int i = 0; i <= degree; ++i)
+                {
+                    const Numeric d = Normals[k].dot(Cartesian(points[i]));
+                    Low[k]  = std::min(Low[k], d);
+                    High[k] = std::max(High[k], d);
+                }
+                Low[k] -= tolerance;
+                High[k] += tolerance;
+            }
+        }
+    };
+
+    // Range of x where the convex hull of the points (i / degree, y_i) reaches y <= 0.
+    void RangeBelow(const Numeric* y, int degree, Numeric& s0, Numeric& s1)
+    {
+        s0 = std::numeric_limits<Numeric>::max();
+        s1 = -std::numeric_limits<Numeric>::max();
+        for (int i = 0; i <= degree; ++i)
+        {
+            const Numeric xi = Numeric(i) / degree;
+            if (y[i] <= 0)
+            {
+                s0 = std::min(s0, xi);
+                s1 = std::max(s1, xi);
+            }
+            for (int j = i + 1; j <= degree; ++j)
+            {
+                if ((y[i] < 0 && y[j] > 0) || (y[i] > 0 && y[j] < 0))
+                {
+                    const Numeric x = xi + (Numeric(j) / degree - xi) * y[i] / (y[i] - y[j]);
+                    s0 = std::min(s0, x);
+                    s1 = std::max(s1, x);
+                }
+            }
+        }
+    }
+
+    /**
+     * Clips a piece to the part that may lie in the fat region of the other piece and restricts its points
+     * to it. With homogeneous points, n·X - c w is a polynomial Bezier function whose sign tells the side
+     * of the plane n·x = c, so each slab bound clips by the convex hull of those coefficients.
+     */
+    bool Clip(Vec4* points, int degree, const FatRegion& region, Numeric& s0, Numeric& s1)
+    {
+        s0 = 0;
+        s1 = 1;
+        Numeric below[MAX_BERNSTEIN_DEGREE + 1], above[MAX_BERNSTEIN_DEGREE + 1];
+        for (int k = 0; k < 2; ++k)
+        {
+            for (int i = 0; i <= degree; ++i)
+            {
+                const Numeric d = region.Normals[k].dot(points[i].head<3>());
+                below[i] = region.Low[k] * points[i].w() - d;
+                above[i] = d - region.High[k] * points[i].w();
+            }
+            Numeric r0, r1;
+            RangeBelow(below, degree, r0, r1);
+            s0 = std::max(s0, r0);
+            s1 = std::min(s1, r1);
+            RangeBelow(above, degree, r0, r1);
+            s0 = std::max(s0, r0);
+            s1 = std::min(s1, r1);
+            if (s0 > s1) return false;
+        }
+        RestrictBezier(points, degree, 1, s0, s1);
+        return true;
+    }
+
+    // Whether the piece lies within tolerance of its chord start .. end.
+    bool IsStraight(const Vec4* points, int degree, Numeric tolerance, Vec3& start, Vec3& end)
+    {
+        start = Cartesian(points[0]);
+        end   = Cartesian(points[degree]);
+        const Vec3 axis = end - start;
+        const Numeric length = axis.squaredNorm();
+        for (int i = 1; i < degree; ++i)
+        {
+            const Vec3 offset = Cartesian(points[i]) - start;
+            const Numeric along = length > 0 ? std::clamp(offset.dot(axis) / length, Numeric(0), Numeric(1)) : 0;
+            if ((offset - along * axis).norm() > tolerance) return false;
+        }
+        return true;
+    }
+
+    // Fraction of the chord start .. end closest to point, and whether point lies within tolerance of it.
+    bool NearChord(const Vec3& point, const Vec3& start, const Vec3& end, Numeric tolerance, Numeric& fraction)
+    {
+        const Vec3 axis = end - start;
+        const Numeric length = axis.squaredNorm();
+        fraction = length > 0 ? std::clamp((point - start).dot(axis) / length, Numeric(0), Numeric(1)) : 0;
+        return (start + fraction * axis - point).norm() <= tolerance;
+    }
+
+    class Solver
+    {
+    public:
+        enum class Fixed
+        {
+            None,
+            A,
+            B
+        };
+
+        Solver(const Curve& a, const Curve& b, Numeric tolerance)
+            : m_A(a), m_B(b), m_SegmentsA(a), m_SegmentsB(b), m_Tolerance(tolerance)
+        {
+            m_ArenaA.resize((MAX_SPLIT_DEPTH + 1) * (m_SegmentsA.Degree + 1));
+            m_ArenaB.resize((MAX_SPLIT_DEPTH + 1) * (m_SegmentsB.Degree + 1));
+        }
+
+        std::vector<CurveIntersection> Run()
+        {
+            // Boxes of B widened by the tolerance, tested 64 at a time against each segment of A
+            BoundingBoxArray boxes_b(m_SegmentsB.Boxes);
+            for (int j = 0; j < m_SegmentsB.Count(); ++j)
+            {
+                BoundingBox box = m_SegmentsB.Boxes[j];
+                boxes_b.Set(j, {box.Min - Vec3::Constant(m_Tolerance), box.Max + Vec3::Constant(m_Tolerance)});
+            }
+            for (int i = 0; i < m_SegmentsA.Count(); ++i)
+            {
+                for (int start = 0; start < m_SegmentsB.Count(); start += 64)
+                {
+                    const int count = std::min(64, m_SegmentsB.Count() - start);
+                    for (uint64_t hits = boxes_b.IntersectsMask(m_SegmentsA.Boxes[i], start, count); hits != 0;
+                         hits &= hits - 1)
+                    {
+                        IntersectSegments(i, start + std::countr_zero(hits));
+                    }
+                }
+            }
+            return Merge();
+        }
+
+    private:
+        void IntersectSegments(int segment_a, int segment_b)
+        {
+            const int p = m_SegmentsA.Degree, q = m_SegmentsB.Degree;
+            const int size_a = p + 1, size_b = q + 1;
+            std::copy_n(m_SegmentsA.Points.data() + segment_a * size_a, size_a, m_ArenaA.data());
+            std::copy_n(m_SegmentsB.Points.data() + segment_b * size_b, size_b, m_ArenaB.data());
+
+            Piece stack[MAX_SPLIT_DEPTH + 1];
+            int top = 0;
+            stack[top++] = {0, 1, 0, 1, 0};
+            while (top > 0)
+            {
+                Piece& piece = stack[top - 1];
+                Vec4* A = m_ArenaA.data() + (top - 1) * size_a;
+                Vec4* B = m_ArenaB.data() + (top - 1) * size_b;
+                bool dropped = false, finished = false, split = false;
+                for (int clip = 0; clip < MAX_CLIP_COUNT && !dropped && !finished && !split; ++clip)
+                {
+                    const Numeric width_a = piece.A1 - piece.A0, width_b = piece.B1 - piece.B0;
+                    if (width_a <= CLIP_TOLERANCE && width_b <= CLIP_TOLERANCE)
+                    {
+                        finished = true;
+                        break;
+                    }
+                    Numeric sa0 = 0, sa1 = 1, sb0 = 0, sb1 = 1;
+                    // A direction already within tolerance is left alone, its polygon may have collapsed.
+                    if (width_a > CLIP_TOLERANCE && !Clip(A, p, FatRegion(B, q, m_Tolerance), sa0, sa1))
+                    {
+                        dropped = true;
+                        break;
+                    }
+                    if (width_b > CLIP_TOLERANCE && !Clip(B, q, FatRegion(A, p, m_Tolerance), sb0, sb1))
+                    {
+                        dropped = true;
+                        break;
+                    }
+                    piece.A1 = piece.A0 + sa1 * width_a;
+                    piece.A0 = piece.A0 + sa0 * width_a;
+                    piece.B1 = piece.B0 + sb1 * width_b;
+                    piece.B0 = piece.B0 + sb0 * width_b;
+
+                    // Several intersections, a tangency or a coincident stretch: halve, or report the stretch.
+                    if (sa1 - sa0 > 0.8 && sb1 - sb0 > 0.8)
+                    {
+                        if (AddOverlap(A, p, B, q, piece, segment_a, segment_b))
+                        {
+                            dropped = true;
+                        }
+                        else if (piece.Depth >= MAX_SPLIT_DEPTH)
+                        {
+                            finished = true;
+                        }
+                        else
+                        {
+                            split = true;
+                        }
+                    }
+                    else if (clip + 1 == MAX_CLIP_COUNT)
+                    {
+                        finished = true;
+                    }
+                }
+                if (finished)
+                {
+                    AddIntersection(segment_a, (piece.A0 + piece.A1) / 2, segment_b, (piece.B0 + piece.B1) / 2);
+                    top--;
+                }
+                else if (split)
+                {
+                    // The piece with the larger box is halved; the upper half goes on top and is clipped first.
+                    const BoundingBox box_a = Segments::PieceBox(A, p), box_b = Segments::PieceBox(B, q);
+                    const bool split_a = (box_a.Max - box_a.Min).squaredNorm() >= (box_b.Max - box_b.Min).squaredNorm();
+                    Piece half = piece;
+                    half.Depth = ++piece.Depth;
+                    std::copy_n(A, size_a, A + size_a);
+                    std::copy_n(B, size_b, B + size_b);
+                    if (split_a)
+                    {
+                        RestrictBezier(A, p, 1, 0, 0.5);
+                        RestrictBezier(A + size_a, p, 1, 0.5, 1);
+                        piece.A1 = half.A0 = (piece.A0 + piece.A1) / 2;
+                    }
+                    else
+                    {
+                        RestrictBezier(B, q, 1, 0, 0.5);
+                        RestrictBezier(B + size_b, q, 1, 0.5, 1);
+                        piece.B1 = half.B0 = (piece.B0 + piece.B1) / 2;
+                    }
+                    stack[top++] = half;
+                }
+                else
+                {
+                    top--;
+                }
+            }
+        }
+
+        /**
+         * Coincident straight pieces: every end of one piece that lies on the other becomes an
+         * intersection, which reports the overlap by its two ends.
+         * @return Whether a stretch was reported; otherwise the piece is split further.
+         */
+        bool AddOverlap(const Vec4* A, int p, const Vec4* B, int q, const Piece& piece, int segment_a, int segment_b)
+        {
+            Vec3 a0, a1, b0, b1;
+            if (!IsStraight(A, p, m_Tolerance, a0, a1) || !IsStraight(B, q, m_Tolerance, b0, b1)) return false;
+            if (!IsOnLine(b0, a0, a1) || !IsOnLine(b1, a0, a1) || !IsOnLine(a0, b0, b1) || !IsOnLine(a1, b0, b1))
+            {
+                return false;
+            }
+            // Pieces clipped around a crossing are collinear within tolerance as well, but not parallel:
+            // their directions part by more than the tolerance over their length.
+            const Vec3 axis_a = a1 - a0, axis_b = b1 - b0;
+            if (axis_a.cross(axis_b).norm() > m_Tolerance * std::max(axis_a.norm(), axis_b.norm())) return false;
+            const Numeric width_a = piece.A1 - piece.A0, width_b = piece.B1 - piece.B0;
+            Numeric fraction;
+            CurveIntersection ends[4];
+            int count = 0;
+            auto add_end = [&](Numeric ta, Numeric tb, Fixed fixed)
+            {
+                if (Refine(ToCurve(m_SegmentsA, segment_a, ta), ToCurve(m_SegmentsB, segment_b, tb), fixed, ends[count]))
+                {
+                    count++;
+                }
+            };
+            if (NearChord(a0, b0, b1, m_Tolerance, fraction)) add_end(piece.A0, piece.B0 + fraction * width_b, Fixed::A);
+            if (NearChord(a1, b0, b1, m_Tolerance, fraction)) add_end(piece.A1, piece.B0 + fraction * width_b, Fixed::A);
+            if (NearChord(b0, a0, a1, m_Tolerance, fraction)) add_end(piece.A0 + fraction * width_a, piece.B0, Fixed::B);
+            if (NearChord(b1, a0, a1, m_Tolerance, fraction)) add_end(piece.A0 + fraction * width_a, piece.B1, Fixed::B);
+            if (count == 0) return false;
+            auto [first, last] = std::minmax_element(ends, ends + count, [](const auto& x, const auto& y)
+            {
+                return x.ParameterA < y.ParameterA;
+            });
+            m_Stretches.push_back({*first, *last});
+            return true;
+        }
+
+        // Whether point lies within tolerance of the line through start and end, a point if they coincide.
+        [[nodiscard]] bool IsOnLine(const Vec3& point, const Vec3& start, const Vec3& end) const
+        {
+            const Vec3 axis = end - start;
+            const Vec3 offset = point - start;
+            const Numeric length = axis.squaredNorm();
+            return (length > 0 ? offset - offset.dot(axis) / length * axis : offset).norm() <= m_Tolerance;
+        }
+
+        Numeric ToCurve(const Segments& segments, int segment, Numeric t) const
+        {
+            const Numeric low = segments.Breakpoints[segment], high = segments.Breakpoints[segment + 1];
+            return low + (high - low) * t;
+        }
+
+        void AddIntersection(int segment_a, Numeric ta, int segment_b, Numeric tb)
+        {
+            CurveIntersection result;
+            if (Refine(ToCurve(m_SegmentsA, segment_a, ta), ToCurve(m_SegmentsB, segment_b, tb), Fixed::None, result))
+            {
+                m_Results.push_back(result);
+            }
+        }
+
+        /**
+         * Newton on the squared distance |A(s) - B(t)|^2 / 2 from curve parameters s and t. Unlike
+         * Gauss-Newton on A(s) - B(t), its curvature terms still pull towards the contact at tangencies.
+         * A fixed parameter stays put while the other one projects its point, as for the ends of an overlap.
+         * @return Whether the curves come within tolerance.
+         */
+        bool Refine(Numeric s, Numeric t, Fixed fixed, CurveIntersection& result)
+        {
+            const Numeric a_low = m_SegmentsA.Breakpoints.front(), a_high = m_SegmentsA.Breakpoints.back();
+            const Numeric b_low = m_SegmentsB.Breakpoints.front(), b_high = m_SegmentsB.Breakpoints.back();
+            int span_a = INVALID_INDEX, span_b = INVALID_INDEX;
+            for (int count = 0; count < NEWTON_ITERATION_COUNT; ++count)
+            {
+                span_a = m_A.Knots.FindSpanIndex(m_A.Degree, s, span_a);
+                span_b = m_B.Knots.FindSpanIndex(m_B.Degree, t, span_b);
+                auto da = m_A.EvaluateAll(s, 2, m_ScratchA, span_a);
+                auto db = m_B.EvaluateAll(t, 2, m_ScratchB, span_b);
+                const Vec3 residual = da[0] - db[0];
+                result = {s, t, da[0], residual.norm()};
+                if (result.Distance == 0) break;
+
+                // Gradient and Hessian of the squared distance, Gauss-Newton where the Hessian is indefinite
+                const Numeric gs = residual.dot(da[1]), gt = -residual.dot(db[1]);
+                Numeric hss = da[1].squaredNorm() + residual.dot(da[2]);
+                Numeric htt = db[1].squaredNorm() - residual.dot(db[2]);
+                Numeric hst = -da[1].dot(db[1]);
+                Numeric ds = 0, dt = 0;
+                if (fixed == Fixed::A)
+                {
+                    dt = -gt / (htt > 0 ? htt : db[1].squaredNorm());
+                }
+                else if (fixed == Fixed::B)
+                {
+                    ds = -gs / (hss > 0 ? hss : da[1].squaredNorm());
+                }
+                else
+                {
+                    if (!(hss > 0 && hss * htt - hst * hst > 0))
+                    {
+                        hss = da[1].squaredNorm();
+                        htt = db[1].squaredNorm();
+                    }
+                    const Numeric det = hss * htt - hst * hst;
+                    if (!(det > 0)) break;
+                    ds = -(htt * gs - hst * gt) / det;
+                    dt = -(hss * gt - hst * gs) / det;
+                }
+                if (!std::isfinite(ds) || !std::isfinite(dt)) break;
+                const Numeric next_s = std::clamp(s + ds, a_low, a_high);
+                const Numeric next_t = std::clamp(t + dt, b_low, b_high);
+                if (next_s == s && next_t == t) break;
+                s = next_s;
+                t = next_t;
+            }
+            return result.Distance <= m_Tolerance;
+        }
+
+        /**
+         * Joins stretches that continue across segment boundaries and reports each by its ends, drops
+         * points inside them, then merges points found from several pieces or segment pairs.
+         */
+        std::vector<CurveIntersection> Merge()
+        {
+            const Numeric merge_a = MERGE_TOLERANCE * (m_SegmentsA.Breakpoints.back() - m_SegmentsA.Breakpoints.front());
+            const Numeric merge_b = MERGE_TOLERANCE * (m_SegmentsB.Breakpoints.back() - m_SegmentsB.Breakpoints.front());
+            auto by_parameters = [](const auto& x, const auto& y)
+            {
+                return x.ParameterA < y.ParameterA || (x.ParameterA == y.ParameterA && x.ParameterB < y.ParameterB);
+            };
+
+            std::sort(m_Stretches.begin(), m_Stretches.end(), [&](const auto& x, const auto& y)
+            {
+                return by_parameters(x.first, y.first);
+            });
+            std::vector<std::pair<CurveIntersection, CurveIntersection>> joined;
+            for (const auto& stretch : m_Stretches)
+            {
+                if (!joined.empty() && stretch.first.ParameterA <= joined.back().second.ParameterA + merge_a)
+                {
+                    if (stretch.second.ParameterA > joined.back().second.ParameterA) joined.back().second = stretch.second;
+                    continue;
+                }
+                joined.push_back(stretch);
+            }
+            std::erase_if(m_Results, [&](const CurveIntersection& result)
+            {
+                return std::any_of(joined.begin(), joined.end(), [&](const auto& stretch)
+                {
+                    auto [b0, b1] = std::minmax(stretch.first.ParameterB, stretch.second.ParameterB);
+                    return result.ParameterA > stretch.first.ParameterA + merge_a &&
+                           result.ParameterA < stretch.second.ParameterA - merge_a &&
+                           result.ParameterB > b0 + merge_b && result.ParameterB < b1 - merge_b;
+                });
+            });
+            for (const auto& [first, last] : joined)
+            {
+                // Where one curve ends or turns away the other passes through the end. Where the curves
+                // part gradually, the end only marks the edge of the tolerance band, and a stretch bounded
+                // by two such edges is a tangential contact.
+                const bool ends[2] = {first.Distance <= m_Tolerance / 2, last.Distance <= m_Tolerance / 2};
+                if (ends[0]) m_Results.push_back(first);
+                if (ends[1]) m_Results.push_back(last);
+                CurveIntersection contact;
+                if (!ends[0] && !ends[1] &&
+                    Refine((first.ParameterA + last.ParameterA) / 2, (first.ParameterB + last.ParameterB) / 2,
+                           Fixed::None, contact))
+                {
+                    m_Results.push_back(contact);
+                }
+            }
+
+            std::sort(m_Results.begin(), m_Results.end(), by_parameters);
+            std::vector<CurveIntersection> merged;
+            for (const auto& result : m_Results)
+            {
+                auto same = std::find_if(merged.rbegin(), merged.rend(), [&](const auto& kept)
+                {
+                    return std::abs(kept.ParameterA - result.ParameterA) <= merge_a &&
+                           std::abs(kept.ParameterB - result.ParameterB) <= merge_b;
+                });
+                if (same == merged.rend())
+                {
+                    merged.push_back(result);
+                }
+                else if (result.Distance < same->Distance)
+                {
+                    *same = result;
+                }
+            }
+            return merged;
+        }
+
+        const Curve& m_A;
+        const Curve& m_B;
+        Segments m_SegmentsA;
+        Segments m_SegmentsB;
+        Numeric m_Tolerance;
+        std::vector<Vec4> m_ArenaA{};
+        std::vector<Vec4> m_ArenaB{};
+        Curve::EvaluationScratch m_ScratchA{};
+        Curve::EvaluationScratch m_ScratchB{};
+        std::vector<CurveIntersection> m_Results{};
+        // Coincident stretches by their ends, first before last in A
+        std::vector<std::pair<CurveIntersection, CurveIntersection>> m_Stretches{};
+    };
+}
+
+namespace libnurbs
+{
+    std::vector<CurveIntersection> Intersect(const Curve& a, const Curve& b, Numeric tolerance)
+    {
+        return Solver(a, b, tolerance).Run();
+    }
+}
@@ -0,0 +1,172 @@
+#include "libnurbs/Curve/CurvePointInversion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+#include "libnurbs/Algorithm/Bernstein.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    // Coefficients this small relative to their terms are rounding noise: the segment is equidistant.
+    constexpr Numeric DEGENERATE_RATIO = 1e-12;
+}
+
+CurvePointInversion::CurvePointInversion(const Curve& curve, Numeric tolerance)
+    : m_Degree(curve.Degree),
+      m_Tolerance(tolerance)
+{
+    const int p         = m_Degree;
+    const bool rational = curve.IsRational();
+    assert(p >= 1);
+    m_PolynomialDegree = rational ? 3 * p - 1 : 2 * p - 1;
+    if (m_PolynomialDegree > MAX_BERNSTEIN_DEGREE)
+    {
+        throw std::runtime_error("Curve degree is too high for point inversion.");
+    }
+
+    std::vector<Vec4> homogeneous(curve.ControlPoints.size());
+    std::transform(curve.ControlPoints.begin(), curve.ControlPoints.end(), homogeneous.begin(), ToHomo);
+    const int segment_count = DecomposeCurve(p, curve.Knots, homogeneous, m_Points, m_Breakpoints);
+
+    const int count = m_PolynomialDegree + 1;
+    m_Boxes.reserve(segment_count);
+    m_S.assign(segment_count * count, 0);
+    m_V.assign(segment_count * count, Vec3::Zero());
+
+    // Per coordinate Bernstein coefficients of the segment and of its derivative
+    std::vector<Numeric> A(p + 1), dA(p), w(p + 1), dw(p), G(2 * p), product(count), ones(p + 1, 1.0);
+    for (int s = 0; s < segment_count; ++s)
+    {
+        const Vec4* Q = m_Points.data() + s * (p + 1);
+        Vec3 first = FromHomo(Q[0]).head<3>();
+        BoundingBox box(first, first);
+        for (int i = 1; i <= p; ++i)
+        {
+            box.ExpandToInclude(Vec3(FromHomo(Q[i]).head<3>()));
+        }
+        m_Boxes.push_back(box);
+
+        for (int i = 0; i <= p; ++i) w[i] = Q[i].w();
+        for (int i = 0; i < p; ++i) dw[i] = p * (w[i + 1] - w[i]);
+
+        Numeric* S = m_S.data() + s * count;
+        Vec3* V    = m_V.data() + s * count;
+        for (int d = 0; d < 3; ++d)
+        {
+            if (rational)
+            {
+                // G = A'w - Aw', f = (A - Pw)·G = A·G - P·(wG)
+                for (int i = 0; i <= p; ++i) A[i] = Q[i][d];
+                for (int i = 0; i < p; ++i) dA[i] = p * (A[i + 1] - A[i]);
+                BernsteinMultiply(dA, w, G);
+                BernsteinMultiply(A, dw, std::span(product).first(2 * p));
+                for (int i = 0; i < 2 * p; ++i) G[i] -= product[i];
+                BernsteinMultiply(w, G, product);
+                for (int k = 0; k < count; ++k) V[k][d] = product[k];
+            }
+            else
+            {
+                // Constant weight: G = C', f = (C - P)·C' = C·C' - P·C'
+                for (int i = 0; i <= p; ++i) A[i] = Q[i][d] / Q[i].w();
+                for (int i = 0; i < p; ++i) dA[i] = p * (A[i + 1] - A[i]);
+                std::copy(dA.begin(), dA.end(), G.begin());
+                BernsteinMultiply(ones, std::span(G).first(p), product);
+                for (int k = 0; k < count; ++k) V[k][d] = product[k];
+            }
+            BernsteinMultiply(A, std::span(G).first(count - p), product);
+            for (int k = 0; k < count; ++k) S[k] += product[k];
+        }
+    }
+}
+
+Curve::ProjectionResult CurvePointInversion::Project(const Vec3& point) const
+{
+    const int p             = m_Degree;
+    const int count         = m_PolynomialDegree + 1;
+    const int segment_count = SegmentCount();
+
+    int best_segment      = 0;
+    Numeric best_t        = 0;
+    Vec3 best_point       = Vec3::Zero();
+    Numeric best_distance = std::numeric_limits<Numeric>::max();
+    auto consider = [&](int segment, Numeric t, const Vec3& candidate)
+    {
+        Numeric distance = (candidate - point).squaredNorm();
+        if (distance < best_distance)
+        {
+            best_distance = distance;
+            best_segment  = segment;
+            best_t        = t;
+            best_point    = candidate;
+        }
+    };
+
+    // Segment end points lie on the curve, they give the first upper bound.
+    // The visiting order is per thread scratch, so repeated queries do not allocate.
+    thread_local std::vector<std::pair<Numeric, int>> order;
+    order.resize(segment_count);
+    for (int s = 0; s < segment_count; ++s)
+    {
+        const Vec4* Q = m_Points.data() + s * (p + 1);
+        consider(s, 0, FromHomo(Q[0]).head<3>());
+        consider(s, 1, FromHomo(Q[p]).head<3>());
+        order[s] = {m_Boxes[s].SquaredDistance(point), s};
+    }
+    std::sort(order.begin(), order.end());
+
+    std::array<Numeric, MAX_BERNSTEIN_DEGREE + 1> f;
+    std::array<Numeric, MAX_BERNSTEIN_DEGREE + 1> roots;
+    for (const auto& [bound, s] : order)
+    {
+        if (bound >= best_distance) break;
+
+        const Numeric* S = m_S.data() + s * count;
+        const Vec3* V    = m_V.data() + s * count;
+        Numeric magnitude = 0, scale = 0;
+        for (int k = 0; k < count; ++k)
+        {
+            f[k]      = S[k] - point.dot(V[k]);
+            magnitude = std::max(magnitude, std::abs(f[k]));
+            scale     = std::max(scale, std::abs(S[k]) + std::abs(point.dot(V[k])));
+        }
+        if (magnitude <= DEGENERATE_RATIO * scale) continue;
+
+        const int root_count = FindBernsteinRoots(std::span(f).first(count), m_Tolerance, roots);
+        for (int k = 0; k < root_count; ++k)
+        {
+            consider(s, roots[k], EvaluateSegment(s, roots[k]));
+        }
+    }
+
+    Curve::ProjectionResult result;
+    Numeric low      = m_Breakpoints[best_segment];
+    Numeric high     = m_Breakpoints[best_segment + 1];
+    result.Parameter = best_t == 1 ? high : low + (high - low) * best_t;
+    result.Point     = best_point;
+    result.Distance  = std::sqrt(best_distance);
+    result.Converged = true;
+    return result;
+}
+
+Vec3 CurvePointInversion::EvaluateSegment(int segment, Numeric t) const
+{
+    const int p   = m_Degree;
+    const Vec4* Q = m_Points.data() + segment * (p + 1);
+    std::array<Vec4, MAX_BERNSTEIN_DEGREE + 1> temp;
+    std::copy(Q, Q + p + 1, temp.begin());
+    for (int k = 1; k <= p; ++k)
+    {
+        for (int i = 0; i <= p - k; ++i)
+        {
+            temp[i] = (1.0 - t) * temp[i] + t * temp[i + 1];
+        }
+    }
+    return FromHomo(temp[0]).head<3>();
+}
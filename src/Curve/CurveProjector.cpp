@@ -0,0 +1,63 @@
+#include "libnurbs/Curve/CurveProjector.hpp"
+
+#include <algorithm>
+
+using namespace libnurbs;
+
+CurveProjector::CurveProjector(const Curve& curve, Numeric epsilon, int max_iteration_count)
+    : m_Curve(&curve),
+      m_Epsilon(epsilon),
+      m_MaxIterationCount(max_iteration_count)
+{
+}
+
+Curve::ProjectionResult CurveProjector::Project(const Vec3& point)
+{
+    Curve::ProjectionResult result;
+    bool accepted = false;
+
+    if (m_HasLast)
+    {
+        result.Parameter = std::clamp(m_Parameter + m_Increment, Numeric(0), Numeric(1));
+        int span         = m_SpanCursor;
+        result.Converged = RefineProjection(*m_Curve, point, result.Parameter, span, result.Point,
+                                            m_Scratch, m_Epsilon, std::min(LOCAL_ITERATION_COUNT, m_MaxIterationCount));
+        result.Distance  = (result.Point - point).norm();
+
+        // The global distance cannot exceed |P - P_last| + d_last, a larger one means another branch was hit.
+        Numeric bound = (point - m_LastPoint).norm() + m_LastDistance + m_Epsilon;
+        accepted      = result.Converged && result.Distance <= bound;
+        if (accepted)
+        {
+            m_SpanCursor = span;
+        }
+    }
+
+    if (!accepted)
+    {
+        if (m_Seeds.SpanBoxes.empty())
+        {
+            m_Seeds = BuildProjectionSeeds(*m_Curve, 2 * m_Curve->Degree + 1);
+        }
+        ++m_GlobalSeedCount;
+        m_SpanCursor     = INVALID_INDEX;
+        result.Parameter = m_Seeds.ParametersU[FindNearestSeed(m_Seeds, point)];
+        result.Converged = RefineProjection(*m_Curve, point, result.Parameter, m_SpanCursor, result.Point,
+                                            m_Scratch, m_Epsilon, m_MaxIterationCount);
+        result.Distance  = (result.Point - point).norm();
+    }
+
+    m_Increment    = accepted ? result.Parameter - m_Parameter : 0;
+    m_Parameter    = result.Parameter;
+    m_LastPoint    = point;
+    m_LastDistance = result.Distance;
+    m_HasLast      = true;
+    return result;
+}
+
+void CurveProjector::Reset()
+{
+    m_HasLast    = false;
+    m_Increment  = 0;
+    m_SpanCursor = INVALID_INDEX;
+}
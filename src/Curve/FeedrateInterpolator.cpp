@@ -0,0 +1,71 @@
+#include "libnurbs/Curve/FeedrateInterpolator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace libnurbs;
+
+FeedrateInterpolator::FeedrateInterpolator(const Curve& curve, Numeric start)
+    : m_Curve(&curve)
+{
+    // The first evaluations size the scratches, later ones reuse them
+    m_Curve->EvaluateAll(0, m_Curve->Degree, m_StationaryScratch);
+    Reset(start);
+}
+
+void FeedrateInterpolator::Reset(Numeric start)
+{
+    m_Parameter = std::clamp(start, Numeric(0), Numeric(1));
+    m_Span = INVALID_INDEX;
+    Evaluate();
+}
+
+void FeedrateInterpolator::Evaluate()
+{
+    m_Span = m_Curve->Knots.FindSpanIndex(m_Curve->Degree, m_Parameter, m_Span);
+    const auto ders = m_Curve->EvaluateAll(m_Parameter, 2, m_Scratch, m_Span);
+    std::copy(ders.begin(), ders.end(), m_Derivatives);
+}
+
+Numeric FeedrateInterpolator::StationaryStep(Numeric length)
+{
+    // Near the stop C(u + du) - C(u) = C^(k) du^k / k! for the first non-zero derivative k
+    const Numeric acceleration = m_Derivatives[2].norm();
+    if (acceleration > 0) return std::sqrt(2 * length / acceleration);
+    const auto ders = m_Curve->EvaluateAll(m_Parameter, m_Curve->Degree, m_StationaryScratch, m_Span);
+    Numeric factorial = 2;
+    for (int k = 3; k < static_cast<int>(ders.size()); ++k)
+    {
+        factorial *= k;
+        const Numeric norm = ders[k].norm();
+        if (norm > 0) return std::pow(factorial * length / norm, Numeric(1) / k);
+    }
+    // The curve stands still on the whole span, continue at its end
+    return m_Curve->Knots(m_Span + 1) - m_Parameter;
+}
+
+const Vec3& FeedrateInterpolator::Step(Numeric length)
+{
+    if (Finished() || !(length > 0)) return Point();
+
+    const Vec3& d1 = m_Derivatives[1];
+    const Vec3& d2 = m_Derivatives[2];
+    const Numeric speed2 = d1.squaredNorm();
+    Numeric delta;
+    if (speed2 > 0)
+    {
+        const Numeric speed = std::sqrt(speed2);
+        const Numeric first = length / speed;
+        delta = first - length * length * d1.dot(d2) / (2 * speed2 * speed2);
+        // Far beyond the range of the expansion the correction may overshoot, keep the first order step then
+        if (!(delta > 0.5 * first && delta < 2 * first)) delta = first;
+    }
+    else
+    {
+        delta = StationaryStep(length);
+    }
+
+    m_Parameter = std::min(m_Parameter + delta, Numeric(1));
+    Evaluate();
+    return Point();
+}
@@ -0,0 +1,393 @@
+#include "libnurbs/Scene/SceneBvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+
+using namespace libnurbs;
+
+namespace
+{
+    // Positive weights keep the geometry in the convex hull of its control points
+    template <typename Range>
+    BoundingBox ControlPointBox(const Range& points)
+    {
+        Vec3 first = points.front().template head<3>();
+        BoundingBox box(first, first);
+        for (const auto& point : points)
+        {
+            box.ExpandToInclude(Vec3(point.template head<3>()));
+        }
+        return box;
+    }
+}
+
+int SceneBvh::AddCurve(const Curve& curve)
+{
+    m_Objects.emplace_back(&curve);
+    return ObjectCount() - 1;
+}
+
+int SceneBvh::AddSurface(const Surface& surface)
+{
+    m_Objects.emplace_back(&surface);
+    return ObjectCount() - 1;
+}
+
+void SceneBvh::UpdateObject(int object)
+{
+    if (const Curve* curve = GetCurve(object))
+    {
+        m_ObjectBoxes[object] = ControlPointBox(curve->ControlPoints);
+    }
+    else
+    {
+        m_ObjectBoxes[object] = ControlPointBox(GetSurface(object)->ControlPoints.Values);
+    }
+    m_Centers[object] = m_ObjectBoxes[object].Center();
+    // A once_flag cannot be reset, so a built precomputation is replaced by a fresh entry
+    if (!m_Projections[object] || m_Projections[object]->Ready) m_Projections[object] = std::make_unique<Projection>();
+}
+
+auto SceneBvh::GetProjection(int object) const -> const Projection&
+{
+    Projection& projection = *m_Projections[object];
+    std::call_once(projection.Built, [&]
+    {
+        if (const Curve* curve = GetCurve(object))
+        {
+            projection.Value.emplace<CurvePointInversion>(*curve);
+        }
+        else
+        {
+            const Surface& surface = *GetSurface(object);
+            projection.Value.emplace<SurfaceProjection>(
+                BuildProjectionSeeds(surface, std::max(surface.DegreeU, surface.DegreeV) + 2), SurfaceBvh(surface));
+        }
+        projection.Ready = true;
+    });
+    return projection;
+}
+
+void SceneBvh::Build()
+{
+    const int count = ObjectCount();
+    m_ObjectBoxes.resize(count);
+    m_Centers.resize(count);
+    m_Projections.resize(count);
+    for (int object = 0; object < count; ++object)
+    {
+        UpdateObject(object);
+    }
+    m_ObjectOrder.resize(count);
+    for (int object = 0; object < count; ++object) m_ObjectOrder[object] = object;
+    m_Nodes.clear();
+    m_LeafBoxes.Resize(0);
+    if (count == 0) return;
+    m_Nodes.reserve(2 * count);
+    BuildNode(0, count, 0);
+    m_LeafBoxes.Resize(count);
+    for (int k = 0; k < count; ++k)
+    {
+        m_LeafBoxes.Set(k, m_ObjectBoxes[m_ObjectOrder[k]]);
+    }
+}
+
+int SceneBvh::BuildNode(int start, int count, int depth)
+{
+    const int index = static_cast<int>(m_Nodes.size());
+    m_Nodes.emplace_back();
+
+    BoundingBox box = m_ObjectBoxes[m_ObjectOrder[start]];
+    BoundingBox centers(m_Centers[m_ObjectOrder[start]], m_Centers[m_ObjectOrder[start]]);
+    for (int k = start; k < start + count; ++k)
+    {
+        box.ExpandToInclude(m_ObjectBoxes[m_ObjectOrder[k]]);
+        centers.ExpandToInclude(m_Centers[m_ObjectOrder[k]]);
+    }
+    m_Nodes[index].Box = box;
+
+    auto make_leaf = [&]
+    {
+        m_Nodes[index].Start = start;
+        m_Nodes[index].Count = count;
+        return index;
+    };
+    if (count <= MAX_LEAF_SIZE || depth >= MAX_DEPTH) return make_leaf();
+
+    // Binned SAH: cost of a split is area(left) * count(left) + area(right) * count(right),
+    // evaluated at the BIN_COUNT - 1 bin borders of every axis.
+    struct Bin
+    {
+        BoundingBox Box{};
+        int Count{0};
+    };
+    int best_axis = INVALID_INDEX;
+    int best_border = 0;
+    Numeric best_cost = std::numeric_limits<Numeric>::max();
+    const Vec3 extent = centers.Length();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (extent[axis] <= 0) continue;
+        const Numeric scale = BIN_COUNT / extent[axis];
+        auto bin_of = [&](int object)
+        {
+            int bin = static_cast<int>((m_Centers[object][axis] - centers.Min[axis]) * scale);
+            return std::min(bin, BIN_COUNT - 1);
+        };
+
+        std::array<Bin, BIN_COUNT> bins{};
+        for (int k = start; k < start + count; ++k)
+        {
+            const int object = m_ObjectOrder[k];
+            Bin& bin = bins[bin_of(object)];
+            if (bin.Count == 0) bin.Box = m_ObjectBoxes[object];
+            else bin.Box.ExpandToInclude(m_ObjectBoxes[object]);
+            bin.Count++;
+        }
+
+        // Sweep from the right for the suffix areas, then from the left for the costs
+        std::array<Numeric, BIN_COUNT> right_area{};
+        std::array<int, BIN_COUNT> right_count{};
+        Bin right;
+        for (int b = BIN_COUNT - 1; b > 0; --b)
+        {
+            if (bins[b].Count > 0)
+            {
+                if (right.Count == 0) right.Box = bins[b].Box;
+                else right.Box.ExpandToInclude(bins[b].Box);
+                right.Count += bins[b].Count;
+            }
+            right_area[b]  = right.Box.SurfaceArea();
+            right_count[b] = right.Count;
+        }
+        Bin left;
+        for (int b = 1; b < BIN_COUNT; ++b)
+        {
+            if (bins[b - 1].Count > 0)
+            {
+                if (left.Count == 0) left.Box = bins[b - 1].Box;
+                else left.Box.ExpandToInclude(bins[b - 1].Box);
+                left.Count += bins[b - 1].Count;
+            }
+            if (left.Count == 0 || right_count[b] == 0) continue;
+            Numeric cost = left.Box.SurfaceArea() * left.Count + right_area[b] * right_count[b];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_border = b;
+            }
+        }
+    }
+
+    auto first = m_ObjectOrder.begin() + start;
+    int half;
+    if (best_axis == INVALID_INDEX)
+    {
+        // All centers coincide, split the objects in halves
+        half = count / 2;
+    }
+    else
+    {
+        const Numeric scale = BIN_COUNT / extent[best_axis];
+        auto middle = std::partition(first, first + count, [&](int object)
+        {
+            int bin = static_cast<int>((m_Centers[object][best_axis] - centers.Min[best_axis]) * scale);
+            return std::min(bin, BIN_COUNT - 1) < best_border;
+        });
+        half = static_cast<int>(middle - first);
+    }
+    BuildNode(start, half, depth + 1);
+    const int right = BuildNode(start + half, count - half, depth + 1);
+    m_Nodes[index].Right = right;
+    return index;
+}
+
+void SceneBvh::Refit()
+{
+    if (static_cast<int>(m_ObjectBoxes.size()) != ObjectCount())
+    {
+        Build();
+        return;
+    }
+    for (int object = 0; object < ObjectCount(); ++object)
+    {
+        UpdateObject(object);
+    }
+    UpdateNodeBoxes();
+}
+
+void SceneBvh::Refit(std::span<const int> objects)
+{
+    if (static_cast<int>(m_ObjectBoxes.size()) != ObjectCount())
+    {
+        Build();
+        return;
+    }
+    for (int object : objects)
+    {
+        assert(object >= 0 && object < ObjectCount());
+        UpdateObject(object);
+    }
+    UpdateNodeBoxes();
+}
+
+void SceneBvh::UpdateNodeBoxes()
+{
+    // Children follow their parent in the array, so a reverse sweep sees them updated first.
+    for (int index = static_cast<int>(m_Nodes.size()) - 1; index >= 0; --index)
+    {
+        Node& node = m_Nodes[index];
+        if (node.IsLeaf())
+        {
+            node.Box = m_ObjectBoxes[m_ObjectOrder[node.Start]];
+            for (int k = node.Start; k < node.Start + node.Count; ++k)
+            {
+                node.Box.ExpandToInclude(m_ObjectBoxes[m_ObjectOrder[k]]);
+                m_LeafBoxes.Set(k, m_ObjectBoxes[m_ObjectOrder[k]]);
+            }
+        }
+        else
+        {
+            node.Box = m_Nodes[index + 1].Box;
+            node.Box.ExpandToInclude(m_Nodes[node.Right].Box);
+        }
+    }
+}
+
+void SceneBvh::QueryBox(const BoundingBox& box, std::vector<int>& objects) const
+{
+    if (m_Nodes.empty()) return;
+    int stack[MAX_DEPTH + 1];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const int index = stack[--top];
+        const Node& node = m_Nodes[index];
+        if (!node.Box.Intersects(box)) continue;
+        if (!node.IsLeaf())
+        {
+            stack[top++] = node.Right;
+            stack[top++] = index + 1;
+            continue;
+        }
+        for (int k = node.Start; k < node.Start + node.Count; k += MAX_LEAF_SIZE)
+        {
+            const int count = std::min(MAX_LEAF_SIZE, node.Start + node.Count - k);
+            for (uint64_t hits = m_LeafBoxes.IntersectsMask(box, k, count); hits != 0; hits &= hits - 1)
+            {
+                objects.push_back(m_ObjectOrder[k + std::countr_zero(hits)]);
+            }
+        }
+    }
+}
+
+void SceneBvh::QueryOverlaps(std::vector<std::pair<int, int>>& pairs) const
+{
+    if (m_Nodes.empty()) return;
+    // Self traversal: a node against itself recurses into both children and their pair,
+    // distinct nodes descend like two separate trees.
+    std::vector<std::pair<int, int>> stack{{0, 0}};
+    while (!stack.empty())
+    {
+        auto [i, j] = stack.back();
+        stack.pop_back();
+        const Node& a = m_Nodes[i];
+        const Node& b = m_Nodes[j];
+        if (i == j)
+        {
+            if (a.IsLeaf())
+            {
+                for (int k = a.Start; k < a.Start + a.Count; ++k)
+                {
+                    AppendOverlaps(k, k + 1, a.Start + a.Count, pairs);
+                }
+                continue;
+            }
+            stack.emplace_back(i + 1, i + 1);
+            stack.emplace_back(a.Right, a.Right);
+            stack.emplace_back(i + 1, a.Right);
+            continue;
+        }
+        if (!a.Box.Intersects(b.Box)) continue;
+        if (a.IsLeaf() && b.IsLeaf())
+        {
+            for (int k = a.Start; k < a.Start + a.Count; ++k)
+            {
+                AppendOverlaps(k, b.Start, b.Start + b.Count, pairs);
+            }
+            continue;
+        }
+        if (b.IsLeaf() || (!a.IsLeaf() && a.Box.Volume() >= b.Box.Volume()))
+        {
+            stack.emplace_back(i + 1, j);
+            stack.emplace_back(a.Right, j);
+        }
+        else
+        {
+            stack.emplace_back(i, j + 1);
+            stack.emplace_back(i, b.Right);
+        }
+    }
+}
+
+void SceneBvh::AppendOverlaps(int k, int begin, int end, std::vector<std::pair<int, int>>& pairs) const
+{
+    const int first = m_ObjectOrder[k];
+    for (int l = begin; l < end; l += MAX_LEAF_SIZE)
+    {
+        const int count = std::min(MAX_LEAF_SIZE, end - l);
+        for (uint64_t hits = m_LeafBoxes.IntersectsMask(m_ObjectBoxes[first], l, count); hits != 0; hits &= hits - 1)
+        {
+            const int second = m_ObjectOrder[l + std::countr_zero(hits)];
+            pairs.emplace_back(std::min(first, second), std::max(first, second));
+        }
+    }
+}
+
+void SceneBvh::QueryRay(const Vec3& origin, const Vec3& direction, Numeric t_max, std::vector<int>& objects) const
+{
+    TraverseRay(origin, direction, t_max, [&](int object, Numeric)
+    {
+        objects.push_back(object);
+        return t_max;
+    });
+}
+
+auto SceneBvh::FindNearest(const Vec3& point) const -> NearestResult
+{
+    NearestResult result;
+    Surface::EvaluationScratch scratch;
+    TraverseNearest(point, [&](int object, Numeric)
+    {
+        const Projection& cached = GetProjection(object);
+        if (const auto* inversion = std::get_if<CurvePointInversion>(&cached.Value))
+        {
+            auto projection = inversion->Project(point);
+            if (projection.Distance < result.Distance)
+            {
+                result = {object, projection.Distance, projection.Point, projection.Parameter, 0};
+            }
+        }
+        else
+        {
+            // Same seeding and refinement as Surface::ProjectPoints
+            const auto& [seeds, bvh] = std::get<SurfaceProjection>(cached.Value);
+            const int seed = FindNearestSeed(seeds, bvh, point);
+            Numeric u = seeds.ParametersU[seed], v = seeds.ParametersV[seed];
+            int index_span_u = INVALID_INDEX, index_span_v = INVALID_INDEX;
+            Vec3 closest;
+            RefineProjection(*GetSurface(object), point, u, v, index_span_u, index_span_v, closest, scratch, 1e-10, 32);
+            const Numeric distance = (closest - point).norm();
+            if (distance < result.Distance)
+            {
+                result = {object, distance, closest, u, v};
+            }
+        }
+        return result.Distance * result.Distance;
+    });
+    return result;
+}
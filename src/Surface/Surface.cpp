@@ -1,12 +1,18 @@
 #include "libnurbs/Surface/Surface.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
 #include "libnurbs/Algorithm/DegreeAlgo.hpp"
 #include "libnurbs/Algorithm/KnotRemoval.hpp"
 #include "libnurbs/Algorithm/MathUtils.hpp"
+#include "libnurbs/Algorithm/PointProjection.hpp"
+#include "libnurbs/Algorithm/RayIntersection.hpp"
 #include "libnurbs/Basis/BSplineBasis.hpp"
+#include "libnurbs/Tessellation/SurfaceTessellation.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
 #include "libnurbs/Utils/Serialization.hpp"
 
 using namespace std;
@@ -405,8 +411,25 @@ Vec3 Surface::EvaluateDerivative(Numeric u, Numeric v, int order_u, int order_v)
 
 Grid<Vec3> Surface::EvaluateAll(Numeric u, Numeric v, int order_u, int order_v) const
 {
-    auto homo_ders = HomogeneousDerivative(u, v, order_u, order_v);
-    Grid<Vec3> result(order_u + 1, order_v + 1, Vec3::Zero());
+    EvaluationScratch scratch;
+    return EvaluateAll(u, v, order_u, order_v, scratch);
+}
+
+const Grid<Vec3>& Surface::EvaluateAll(Numeric u, Numeric v, int order_u, int order_v,
+                                       EvaluationScratch& scratch,
+                                       int index_span_u, int index_span_v) const
+{
+    assert(u >= 0 && u <= 1);
+    assert(v >= 0 && v <= 1);
+    if (index_span_u == INVALID_INDEX) index_span_u = KnotsU.FindSpanIndex(DegreeU, u);
+    if (index_span_v == INVALID_INDEX) index_span_v = KnotsV.FindSpanIndex(DegreeV, v);
+    HomogeneousDerivative(u, v, index_span_u, index_span_v, order_u, order_v, scratch);
+    const auto& homo_ders = scratch.HomogeneousDerivatives;
+    auto& result = scratch.Derivatives;
+    if (result.UCount != order_u + 1 || result.VCount != order_v + 1)
+    {
+        result = Grid<Vec3>(order_u + 1, order_v + 1);
+    }
 
     Numeric Wders00 = homo_ders.Get(0, 0).w();
 
@@ -672,6 +695,176 @@ auto Surface::BinarySearchParameterOn(const Vec3& point, int direction, Numeric
 }
 
 
+auto Surface::ProjectPoints(std::span<const Vec3> points,
+                            Numeric epsilon, int max_iteration_count, int thread_count) const
+    -> vector<ProjectionResult>
+{
+    const int count = static_cast<int>(points.size());
+    vector<ProjectionResult> results(count);
+    if (count == 0) return results;
+
+    // Seeds and BVH are shared read-only, evaluation scratch is owned by one worker each.
+    auto seeds = BuildProjectionSeeds(*this, std::max(DegreeU, DegreeV) + 2);
+    SurfaceBvh bvh(*this);
+    int workers = Utils::ResolveThreadCount(thread_count, count);
+    vector<EvaluationScratch> scratches(workers);
+
+    Utils::ParallelFor(count, workers, [&](int i, int worker)
+    {
+        const Vec3& point = points[i];
+        auto& result = results[i];
+        int seed = FindNearestSeed(seeds, bvh, point);
+        result.U = seeds.ParametersU[seed];
+        result.V = seeds.ParametersV[seed];
+        int index_span_u = INVALID_INDEX, index_span_v = INVALID_INDEX;
+        result.Converged = RefineProjection(*this, point, result.U, result.V, index_span_u, index_span_v,
+                                            result.Point, scratches[worker], epsilon, max_iteration_count);
+        result.Distance = (result.Point - point).norm();
+    });
+    return results;
+}
+
+auto Surface::IntersectRay(const Vec3& origin, const Vec3& direction, Numeric epsilon) const -> RayHit
+{
+    SurfaceBvh bvh(*this);
+    RayIntersectionScratch scratch;
+    return libnurbs::IntersectRay(*this, bvh, origin, direction, std::numeric_limits<Numeric>::infinity(),
+                                  scratch, epsilon);
+}
+
+auto Surface::IntersectRays(std::span<const Vec3> origins, std::span<const Vec3> directions,
+                            Numeric epsilon, int thread_count) const -> vector<RayHit>
+{
+    assert(origins.size() == directions.size());
+    const int count = static_cast<int>(origins.size());
+    vector<RayHit> hits(count);
+    if (count == 0) return hits;
+
+    // The BVH is shared read-only, packets of consecutive rays are the unit of work.
+    SurfaceBvh bvh(*this);
+    const int packet_count = (count + SurfaceBvh::MAX_PACKET_SIZE - 1) / SurfaceBvh::MAX_PACKET_SIZE;
+    int workers = Utils::ResolveThreadCount(thread_count, packet_count);
+    vector<RayIntersectionScratch> scratches(workers);
+
+    Utils::ParallelFor(packet_count, workers, [&](int packet, int worker)
+    {
+        const int first = packet * SurfaceBvh::MAX_PACKET_SIZE;
+        const int size  = std::min(SurfaceBvh::MAX_PACKET_SIZE, count - first);
+        IntersectRayPacket(*this, bvh, origins.subspan(first, size), directions.subspan(first, size),
+                           std::span(hits).subspan(first, size), scratches[worker], epsilon);
+    });
+    return hits;
+}
+
+void Surface::Tessellate(const TessellationOptions& options, TriangleMesh& output) const
+{
+    SurfaceTessellation tessellation(*this, options);
+    EvaluationScratch scratch;
+    for (int patch = 0; patch < tessellation.PatchCount(); ++patch)
+    {
+        tessellation.PlanPatch(patch, scratch);
+    }
+    tessellation.Layout();
+    output.Resize(tessellation.VertexCount(), tessellation.TriangleCount());
+    for (int patch = 0; patch < tessellation.PatchCount(); ++patch)
+    {
+        tessellation.EmitPatch(patch, output, scratch);
+    }
+}
+
+BoundingBox Surface::GetBoundingBox(Numeric epsilon, int thread_count) const
+{
+    // Halvings alternate between u and v, twice the curve depth limit per direction.
+    constexpr int MAX_DEPTH = 64;
+    const int p = DegreeU;
+    const int q = DegreeV;
+    Grid<Vec4> homogeneous = ControlPoints;
+    std::transform(homogeneous.Values.begin(), homogeneous.Values.end(), homogeneous.Values.begin(), ToHomo);
+    vector<Vec4> patch_points;
+    vector<Numeric> breakpoints_u, breakpoints_v;
+    DecomposeSurface(p, q, KnotsU, KnotsV, homogeneous, patch_points, breakpoints_u, breakpoints_v);
+
+    // Depth first halving keeps at most one pending piece per level, see Curve::GetBoundingBox.
+    const int stride      = (p + 1) * (q + 1);
+    const int patch_count = static_cast<int>(patch_points.size()) / stride;
+    const int workers     = Utils::ResolveThreadCount(thread_count, patch_count);
+    vector<Vec4> arenas(workers * (MAX_DEPTH + 1) * stride);
+    vector<BoundingBox> boxes(patch_count);
+
+    Utils::ParallelFor(patch_count, workers, [&](int patch, int worker)
+    {
+        Vec4* arena = arenas.data() + worker * (MAX_DEPTH + 1) * stride;
+        int depths[MAX_DEPTH + 1];
+        std::copy(patch_points.begin() + patch * stride, patch_points.begin() + (patch + 1) * stride, arena);
+        depths[0] = 0;
+        int top   = 1;
+
+        Vec3 start = FromHomo(arena[0]).head<3>();
+        BoundingBox box(start, start);
+        while (top > 0)
+        {
+            Vec4* Q   = arena + (top - 1) * stride;
+            int depth = depths[top - 1];
+
+            // Box of the control net against the box of the corners
+            Vec3 corner = FromHomo(Q[0]).head<3>();
+            BoundingBox corners(corner, corner);
+            corners.ExpandToInclude(Vec3(FromHomo(Q[p]).head<3>()));
+            corners.ExpandToInclude(Vec3(FromHomo(Q[q * (p + 1)]).head<3>()));
+            corners.ExpandToInclude(Vec3(FromHomo(Q[stride - 1]).head<3>()));
+            BoundingBox control = corners;
+            for (int i = 0; i < stride; ++i)
+            {
+                control.ExpandToInclude(Vec3(FromHomo(Q[i]).head<3>()));
+            }
+            // A piece inside the box found so far cannot grow it, most interior pieces end here.
+            bool enclosed     = box.Contains(control);
+            bool small_enough = control.Length().norm() <= epsilon;
+            bool flat_enough  = Approx(control.Min, corners.Min, 1e-6) && Approx(control.Max, corners.Max, 1e-6);
+            if (enclosed || small_enough || flat_enough || depth >= MAX_DEPTH)
+            {
+                box.ExpandToInclude(corners);
+                top--;
+                continue;
+            }
+
+            // de Casteljau at the middle of every row (even depth) or column (odd depth):
+            // Q becomes the far half, the near half goes on top.
+            Vec4* L = Q + stride;
+            const bool split_u = depth % 2 == 0;
+            const int degree   = split_u ? p : q;
+            const int lines    = split_u ? q + 1 : p + 1;
+            const int step     = split_u ? 1 : p + 1;
+            const int pitch    = split_u ? p + 1 : 1;
+            for (int line = 0; line < lines; ++line)
+            {
+                Vec4* R = Q + line * pitch;
+                Vec4* H = L + line * pitch;
+                H[0]    = R[0];
+                for (int r = 1; r <= degree; ++r)
+                {
+                    for (int i = 0; i <= degree - r; ++i)
+                    {
+                        R[i * step] = 0.5 * (R[i * step] + R[(i + 1) * step]);
+                    }
+                    H[r * step] = R[0];
+                }
+            }
+            depths[top - 1] = depth + 1;
+            depths[top]     = depth + 1;
+            top++;
+        }
+        boxes[patch] = box;
+    });
+
+    BoundingBox result = boxes.front();
+    for (const auto& box : boxes)
+    {
+        result.ExpandToInclude(box);
+    }
+    return result;
+}
+
 Surface Surface::InsertKnotU(Numeric knot_value) const
 {
     Surface result{*this};
@@ -1147,39 +1340,48 @@ Surface Surface::AlignParameterDomain(AlignAxis u_axis, AlignAxis v_axis)
 }
 
 
-Grid<Vec4> Surface::HomogeneousDerivative(Numeric u, Numeric v, int order_u, int order_v) const
+void Surface::HomogeneousDerivative(Numeric u, Numeric v, int index_span_u, int index_span_v,
+                                    int order_u, int order_v, EvaluationScratch& scratch) const
 {
-    assert(u >= 0 && u <= 1);
-    assert(v >= 0 && v <= 1);
-    int index_span_u = KnotsU.FindSpanIndex(DegreeU, u);
-    int index_span_v = KnotsV.FindSpanIndex(DegreeV, v);
-    MatX basis_u = BSplineBasis::EvaluateAll(DegreeU, KnotsU.Values(), index_span_u, u, order_u);
-    MatX basis_v = BSplineBasis::EvaluateAll(DegreeV, KnotsV.Values(), index_span_v, v, order_v);
+    auto& basis_u = scratch.BasisDerivativesU;
+    auto& basis_v = scratch.BasisDerivativesV;
+    BSplineBasis::EvaluateAll(DegreeU, KnotsU.Values(), index_span_u, u, order_u, basis_u, scratch.Basis);
+    BSplineBasis::EvaluateAll(DegreeV, KnotsV.Values(), index_span_v, v, order_v, basis_v, scratch.Basis);
     assert(basis_u.cols() == DegreeU + 1);
     assert(basis_v.cols() == DegreeV + 1);
 
     int index_pre_u = index_span_u - DegreeU;
     int index_pre_v = index_span_v - DegreeV;
 
-    Grid<Vec4> result(order_u + 1, order_v + 1, Vec4::Zero());
+    auto& result = scratch.HomogeneousDerivatives;
+    if (result.UCount != order_u + 1 || result.VCount != order_v + 1)
+    {
+        result = Grid<Vec4>(order_u + 1, order_v + 1);
+    }
+    std::ranges::fill(result.Values, Vec4::Zero());
 
-    for (int l = 0; l <= order_v; ++l)
+    // tmp[k] = sum_i N^(k)_i(u) * Pw(i, j), shared by all derivatives in v of row j
+    auto& tmp = scratch.Temp;
+    tmp.resize(order_u + 1);
+    for (int j = 0; j <= DegreeV; j++)
     {
-        for (int k = 0; k <= order_u; ++k)
+        int index_v = index_pre_v + j;
+        std::ranges::fill(tmp, Vec4::Zero());
+        for (int i = 0; i <= DegreeU; i++)
+        {
+            int index_u = index_pre_u + i;
+            auto point = ToHomo(ControlPoints.Get(index_u, index_v));
+            for (int k = 0; k <= order_u; ++k)
+            {
+                tmp[k].noalias() += basis_u(k, i) * point;
+            }
+        }
+        for (int l = 0; l <= order_v; ++l)
         {
-            for (int j = 0; j <= DegreeV; j++)
+            for (int k = 0; k <= order_u; ++k)
             {
-                int index_v = index_pre_v + j;
-                Vec4 tmp = Vec4::Zero();
-                for (int i = 0; i <= DegreeU; i++)
-                {
-                    int index_u = index_pre_u + i;
-                    auto point = ToHomo(ControlPoints.Get(index_u, index_v));
-                    tmp.noalias() += basis_u(k, i) * point;
-                }
-                result.Get(k, l).noalias() += basis_v(l, j) * tmp;
+                result.Get(k, l).noalias() += basis_v(l, j) * tmp[k];
             }
         }
     }
-    return result;
 }
@@ -0,0 +1,146 @@
+#include "libnurbs/Surface/SurfaceBvh.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+
+using namespace libnurbs;
+
+SurfaceBvh::SurfaceBvh(const Surface& surface)
+{
+    Grid<Vec4> homogeneous = surface.ControlPoints;
+    std::transform(homogeneous.Values.begin(), homogeneous.Values.end(), homogeneous.Values.begin(), ToHomo);
+    DecomposeSurface(surface.DegreeU, surface.DegreeV, surface.KnotsU, surface.KnotsV, homogeneous,
+                     m_PatchPoints, m_BreakpointsU, m_BreakpointsV);
+    m_PatchSize = (surface.DegreeU + 1) * (surface.DegreeV + 1);
+
+    const int patch_count = static_cast<int>(m_PatchPoints.size()) / m_PatchSize;
+    m_PatchBoxes.resize(patch_count);
+    for (int patch = 0; patch < patch_count; ++patch)
+    {
+        auto points = PatchPoints(patch);
+        Vec3 first = FromHomo(points[0]).head<3>();
+        BoundingBox box(first, first);
+        for (const auto& point : points)
+        {
+            box.ExpandToInclude(Vec3(FromHomo(point).head<3>()));
+        }
+        m_PatchBoxes[patch] = box;
+    }
+
+    m_PatchOrder.resize(patch_count);
+    for (int patch = 0; patch < patch_count; ++patch) m_PatchOrder[patch] = patch;
+    m_Nodes.reserve(2 * patch_count);
+    Build(0, patch_count, 0);
+    m_LeafBoxes.Resize(patch_count);
+    for (int k = 0; k < patch_count; ++k)
+    {
+        m_LeafBoxes.Set(k, m_PatchBoxes[m_PatchOrder[k]]);
+    }
+}
+
+int SurfaceBvh::Build(int start, int count, int depth)
+{
+    const int index = static_cast<int>(m_Nodes.size());
+    m_Nodes.emplace_back();
+
+    BoundingBox box = m_PatchBoxes[m_PatchOrder[start]];
+    Vec3 center = box.Center();
+    BoundingBox centers(center, center);
+    for (int k = start; k < start + count; ++k)
+    {
+        box.ExpandToInclude(m_PatchBoxes[m_PatchOrder[k]]);
+        centers.ExpandToInclude(m_PatchBoxes[m_PatchOrder[k]].Center());
+    }
+    m_Nodes[index].Box = box;
+
+    if (count <= MAX_LEAF_SIZE || depth >= MAX_DEPTH)
+    {
+        m_Nodes[index].Start = start;
+        m_Nodes[index].Count = count;
+        return index;
+    }
+
+    int axis;
+    centers.Length().maxCoeff(&axis);
+    const int half = count / 2;
+    auto first = m_PatchOrder.begin() + start;
+    std::nth_element(first, first + half, first + count, [&](int lhs, int rhs)
+    {
+        return m_PatchBoxes[lhs].Center()[axis] < m_PatchBoxes[rhs].Center()[axis];
+    });
+    Build(start, half, depth + 1);
+    const int right = Build(start + half, count - half, depth + 1);
+    m_Nodes[index].Right = right;
+    return index;
+}
+
+void SurfaceBvh::QueryBox(const BoundingBox& box, std::vector<int>& patches) const
+{
+    if (m_Nodes.empty()) return;
+    int stack[MAX_DEPTH + 1];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = m_Nodes[stack[--top]];
+        if (!node.Box.Intersects(box)) continue;
+        if (!node.IsLeaf())
+        {
+            stack[top++] = node.Right;
+            stack[top++] = static_cast<int>(&node - m_Nodes.data()) + 1;
+            continue;
+        }
+        for (int k = node.Start; k < node.Start + node.Count; k += MAX_LEAF_SIZE)
+        {
+            const int count = std::min(MAX_LEAF_SIZE, node.Start + node.Count - k);
+            for (uint64_t hits = m_LeafBoxes.IntersectsMask(box, k, count); hits != 0; hits &= hits - 1)
+            {
+                patches.push_back(m_PatchOrder[k + std::countr_zero(hits)]);
+            }
+        }
+    }
+}
+
+void SurfaceBvh::QueryOverlaps(const SurfaceBvh& other, std::vector<std::pair<int, int>>& pairs) const
+{
+    if (m_Nodes.empty() || other.m_Nodes.empty()) return;
+    // Simultaneous descent, always splitting the node that is still inner with the larger box.
+    std::vector<std::pair<int, int>> stack{{0, 0}};
+    while (!stack.empty())
+    {
+        auto [i, j] = stack.back();
+        stack.pop_back();
+        const Node& a = m_Nodes[i];
+        const Node& b = other.m_Nodes[j];
+        if (!a.Box.Intersects(b.Box)) continue;
+        if (a.IsLeaf() && b.IsLeaf())
+        {
+            for (int k = a.Start; k < a.Start + a.Count; ++k)
+            {
+                const int patch_a = m_PatchOrder[k];
+                for (int l = b.Start; l < b.Start + b.Count; l += MAX_LEAF_SIZE)
+                {
+                    const int count = std::min(MAX_LEAF_SIZE, b.Start + b.Count - l);
+                    uint64_t hits = other.m_LeafBoxes.IntersectsMask(m_PatchBoxes[patch_a], l, count);
+                    for (; hits != 0; hits &= hits - 1)
+                    {
+                        pairs.emplace_back(patch_a, other.m_PatchOrder[l + std::countr_zero(hits)]);
+                    }
+                }
+            }
+            continue;
+        }
+        if (b.IsLeaf() || (!a.IsLeaf() && a.Box.Volume() >= b.Box.Volume()))
+        {
+            stack.emplace_back(i + 1, j);
+            stack.emplace_back(a.Right, j);
+        }
+        else
+        {
+            stack.emplace_back(i, j + 1);
+            stack.emplace_back(i, b.Right);
+        }
+    }
+}
@@ -0,0 +1,685 @@
+#include "libnurbs/Surface/SurfaceIntersection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    using Vec2 = Eigen::Vector2<Numeric>;
+    // Parameters (u, v) on the first surface followed by (u, v) on the second
+    using Unknowns = Eigen::Vector4<Numeric>;
+
+    // Halvings per patch pair; depth first, so the arena holds at most one pending pair per level.
+    constexpr int MAX_SPLIT_DEPTH = 32;
+    constexpr int NEWTON_ITERATION_COUNT = 16;
+    constexpr int MAX_STEP_COUNT = 1 << 20;
+    // |nA × nB| of the unit normals below which the surfaces touch tangentially
+    constexpr Numeric MIN_TANGENT_NORM = 1e-8;
+    // Longest and shortest step, relative to the smaller surface box diagonal
+    constexpr Numeric MAX_STEP = 0.125;
+    constexpr Numeric MIN_STEP = 1e-9;
+    // A pair of pieces meets in at most one arc once their control points stray from the bilinear patches
+    // of their corners by less than this fraction of the smaller box diagonal times the sine of the angle
+    // between the pieces.
+    constexpr Numeric FLATNESS_RATIO = 0.05;
+    // Start points within this many chord tolerances of a traced branch lie on it
+    constexpr Numeric COVER_FACTOR = 4;
+
+    struct Domain
+    {
+        Numeric U0, U1, V0, V1;
+    };
+
+    // Knot spans of the previous evaluation, the next one walks from them
+    struct Cursor
+    {
+        int SpanU{INVALID_INDEX};
+        int SpanV{INVALID_INDEX};
+    };
+
+    struct Frame
+    {
+        Vec3 Point;
+        Vec3 Du;
+        Vec3 Dv;
+    };
+
+    enum class Constraint
+    {
+        // Nearest point on both surfaces, minimum norm Newton steps
+        None,
+        // On the plane through Target normal to Tangent
+        Plane,
+        // Parameter Fixed keeps its value
+        Fixed,
+    };
+
+    BoundingBox PieceBox(const Vec4* points, int count)
+    {
+        Vec3 first = points[0].head<3>() / points[0].w();
+        BoundingBox box(first, first);
+        for (int k = 1; k < count; ++k)
+        {
+            box.ExpandToInclude(Vec3(points[k].head<3>() / points[k].w()));
+        }
+        return box;
+    }
+
+    // Largest distance of the Cartesian control points to the bilinear patch of the corner points.
+    Numeric Flatness(const Vec4* points, int p, int q)
+    {
+        auto at = [&](int i, int j) -> Vec3
+        {
+            const Vec4& point = points[j * (p + 1) + i];
+            return point.head<3>() / point.w();
+        };
+        const Vec3 c00 = at(0, 0), c10 = at(p, 0), c01 = at(0, q), c11 = at(p, q);
+        Numeric flatness = 0;
+        for (int j = 0; j <= q; ++j)
+        {
+            const Numeric t = Numeric(j) / q;
+            for (int i = 0; i <= p; ++i)
+            {
+                const Numeric s = Numeric(i) / p;
+                const Vec3 bilinear = (1 - t) * ((1 - s) * c00 + s * c10) + t * ((1 - s) * c01 + s * c11);
+                flatness = std::max(flatness, (at(i, j) - bilinear).norm());
+            }
+        }
+        return flatness;
+    }
+
+    // Unit normal of the plane spanned by the corner diagonals, zero if they are parallel.
+    Vec3 PieceNormal(const Vec4* points, int p, int q)
+    {
+        auto at = [&](int i, int j) -> Vec3
+        {
+            const Vec4& point = points[j * (p + 1) + i];
+            return point.head<3>() / point.w();
+        };
+        const Vec3 normal = (at(p, q) - at(0, 0)).cross(at(0, q) - at(p, 0));
+        const Numeric length = normal.norm();
+        return length > 0 ? Vec3(normal / length) : Vec3::Zero();
+    }
+
+    /**
+     * Newton iterations and tangents on the pair of surfaces, one per thread. The span cursors follow
+     * the iterates, which move little between consecutive solves.
+     */
+    class Solver
+    {
+    public:
+        Solver(const Surface& a, const Domain& domain_a, const Surface& b, const Domain& domain_b, Numeric tolerance)
+            : m_A(a), m_B(b), m_Tolerance(tolerance)
+        {
+            m_Low  = {domain_a.U0, domain_a.V0, domain_b.U0, domain_b.V0};
+            m_High = {domain_a.U1, domain_a.V1, domain_b.U1, domain_b.V1};
+        }
+
+        [[nodiscard]] const Unknowns& Low() const
+        {
+            return m_Low;
+        }
+
+        [[nodiscard]] const Unknowns& High() const
+        {
+            return m_High;
+        }
+
+        // Frames of both surfaces at the last evaluated parameters
+        [[nodiscard]] const Frame& FrameA() const
+        {
+            return m_FrameA;
+        }
+
+        [[nodiscard]] const Frame& FrameB() const
+        {
+            return m_FrameB;
+        }
+
+        void Evaluate(const Unknowns& x)
+        {
+            m_FrameA = Evaluate(m_A, x[0], x[1], m_CursorA);
+            m_FrameB = Evaluate(m_B, x[2], x[3], m_CursorB);
+        }
+
+        // Unit tangent nA × nB of the intersection at the last evaluation, false where the surfaces touch.
+        [[nodiscard]] bool Tangent(Vec3& tangent) const
+        {
+            const Vec3 na = m_FrameA.Du.cross(m_FrameA.Dv);
+            const Vec3 nb = m_FrameB.Du.cross(m_FrameB.Dv);
+            const Numeric length_a = na.norm(), length_b = nb.norm();
+            if (!(length_a > 0 && length_b > 0)) return false;
+            tangent = na.cross(nb) / (length_a * length_b);
+            const Numeric length = tangent.norm();
+            if (!(length > MIN_TANGENT_NORM)) return false;
+            tangent /= length;
+            return true;
+        }
+
+        /**
+         * Newton on A(x0, x1) - B(x2, x3) = 0 and the constraint, within the domains.
+         * On success the frames are those at x.
+         */
+        bool Converge(Unknowns& x, Constraint constraint, const Vec3& tangent = Vec3::Zero(),
+                      const Vec3& target = Vec3::Zero(), int fixed = 0)
+        {
+            for (int count = 0; count < NEWTON_ITERATION_COUNT; ++count)
+            {
+                Evaluate(x);
+                const Vec3 residual = m_FrameA.Point - m_FrameB.Point;
+                const Numeric offset = constraint == Constraint::Plane ? tangent.dot(m_FrameA.Point - target) : 0;
+                if (residual.norm() <= m_Tolerance && std::abs(offset) <= m_Tolerance) return true;
+
+                Eigen::Matrix<Numeric, 3, 4> J;
+                J << m_FrameA.Du, m_FrameA.Dv, -m_FrameB.Du, -m_FrameB.Dv;
+                Unknowns delta;
+                if (constraint == Constraint::None)
+                {
+                    auto lu = (J * J.transpose()).partialPivLu();
+                    if (!(std::abs(lu.determinant()) > 0)) return false;
+                    delta = -J.transpose() * lu.solve(residual);
+                }
+                else
+                {
+                    Eigen::Matrix<Numeric, 4, 4> M;
+                    M.topRows<3>() = J;
+                    M.row(3).setZero();
+                    if (constraint == Constraint::Plane)
+                    {
+                        M(3, 0) = tangent.dot(m_FrameA.Du);
+                        M(3, 1) = tangent.dot(m_FrameA.Dv);
+                    }
+                    else
+                    {
+                        M(3, fixed) = 1;
+                    }
+                    auto lu = M.partialPivLu();
+                    if (!(std::abs(lu.determinant()) > 0)) return false;
+                    delta = lu.solve(Unknowns{-residual.x(), -residual.y(), -residual.z(), -offset});
+                }
+                x = (x + delta).cwiseMax(m_Low).cwiseMin(m_High);
+            }
+            return false;
+        }
+
+        // First order change of the parameters for a move of the intersection point by step.
+        [[nodiscard]] Unknowns Predict(const Vec3& step) const
+        {
+            Unknowns delta;
+            delta.head<2>() = Predict(m_FrameA, step);
+            delta.tail<2>() = Predict(m_FrameB, step);
+            return delta;
+        }
+
+    private:
+        static Vec2 Predict(const Frame& frame, const Vec3& step)
+        {
+            Eigen::Matrix<Numeric, 3, 2> J;
+            J << frame.Du, frame.Dv;
+            return (J.transpose() * J).ldlt().solve(J.transpose() * step);
+        }
+
+        Frame Evaluate(const Surface& surface, Numeric u, Numeric v, Cursor& cursor)
+        {
+            cursor.SpanU = surface.KnotsU.FindSpanIndex(surface.DegreeU, u, cursor.SpanU);
+            cursor.SpanV = surface.KnotsV.FindSpanIndex(surface.DegreeV, v, cursor.SpanV);
+            const auto& ders = surface.EvaluateAll(u, v, 1, 1, m_Scratch, cursor.SpanU, cursor.SpanV);
+            return {ders.Get(0, 0), ders.Get(1, 0), ders.Get(0, 1)};
+        }
+
+        const Surface& m_A;
+        const Surface& m_B;
+        Numeric m_Tolerance;
+        Unknowns m_Low;
+        Unknowns m_High;
+        Surface::EvaluationScratch m_Scratch{};
+        Cursor m_CursorA{};
+        Cursor m_CursorB{};
+        Frame m_FrameA{};
+        Frame m_FrameB{};
+    };
+
+    struct Seed
+    {
+        Unknowns X;
+        Vec3 Point;
+        Vec3 Tangent;
+    };
+
+    struct SeedScratch
+    {
+        std::vector<Vec4> Arena{};
+        std::vector<Seed> Seeds{};
+    };
+
+    // Whether the control points of the pieces project onto disjoint ranges of axis, which by the
+    // convex hull property separates the pieces.
+    bool Separated(const Vec4* a, int size_a, const Vec4* b, int size_b, const Vec3& axis, Numeric tolerance)
+    {
+        auto range = [&](const Vec4* points, int count)
+        {
+            Numeric low = std::numeric_limits<Numeric>::max(), high = -std::numeric_limits<Numeric>::max();
+            for (int k = 0; k < count; ++k)
+            {
+                const Numeric d = axis.dot(points[k].head<3>()) / points[k].w();
+                low  = std::min(low, d);
+                high = std::max(high, d);
+            }
+            return std::pair{low, high};
+        };
+        const auto [low_a, high_a] = range(a, size_a);
+        const auto [low_b, high_b] = range(b, size_b);
+        return low_a > high_b + tolerance || low_b > high_a + tolerance;
+    }
+
+    /**
+     * Start points of one patch pair. The pieces are halved depth first while neither their boxes nor
+     * the planes of their corners separate them, each time the less flat one along its longer parameter
+     * direction, until the pair is transversal or both pieces are flat to the chord tolerance.
+     */
+    void FindSeeds(const SurfaceBvh& bvh_a, int patch_a, int p_a, int q_a,
+                   const SurfaceBvh& bvh_b, int patch_b, int p_b, int q_b,
+                   Numeric flatness, Numeric tolerance, Solver& solver, SeedScratch& scratch)
+    {
+        struct Entry
+        {
+            Domain A, B;
+            int Depth;
+        };
+        const int size_a = (p_a + 1) * (q_a + 1), size_b = (p_b + 1) * (q_b + 1);
+        const int level_size = size_a + size_b;
+        scratch.Arena.resize((MAX_SPLIT_DEPTH + 1) * level_size);
+        std::copy_n(bvh_a.PatchPoints(patch_a).data(), size_a, scratch.Arena.data());
+        std::copy_n(bvh_b.PatchPoints(patch_b).data(), size_b, scratch.Arena.data() + size_a);
+
+        Entry stack[MAX_SPLIT_DEPTH + 1];
+        int top = 0;
+        Entry& root = stack[top++];
+        bvh_a.PatchDomain(patch_a, root.A.U0, root.A.U1, root.A.V0, root.A.V1);
+        bvh_b.PatchDomain(patch_b, root.B.U0, root.B.U1, root.B.V0, root.B.V1);
+        root.Depth = 0;
+        while (top > 0)
+        {
+            Entry& entry = stack[top - 1];
+            Vec4* Q = scratch.Arena.data() + (top - 1) * level_size;
+            BoundingBox box_a = PieceBox(Q, size_a), box_b = PieceBox(Q + size_a, size_b);
+            box_a.Min.array() -= tolerance;
+            box_a.Max.array() += tolerance;
+            if (!box_a.Intersects(box_b))
+            {
+                top--;
+                continue;
+            }
+            const Vec3 normal_a = PieceNormal(Q, p_a, q_a), normal_b = PieceNormal(Q + size_a, p_b, q_b);
+            if (Separated(Q, size_a, Q + size_a, size_b, normal_a, tolerance) ||
+                Separated(Q, size_a, Q + size_a, size_b, normal_b, tolerance))
+            {
+                top--;
+                continue;
+            }
+            const Numeric flatness_a = Flatness(Q, p_a, q_a), flatness_b = Flatness(Q + size_a, p_b, q_b);
+            const Numeric sine = normal_a.cross(normal_b).norm();
+            const Numeric size = std::min(box_a.Length().norm(), box_b.Length().norm());
+            const bool transversal = flatness_a + flatness_b <= FLATNESS_RATIO * sine * size;
+            if (transversal || (flatness_a <= flatness && flatness_b <= flatness) || entry.Depth >= MAX_SPLIT_DEPTH)
+            {
+                // Newton from the centers; where it lands on an arc already found, the start point is dropped later
+                Unknowns x{(entry.A.U0 + entry.A.U1) / 2, (entry.A.V0 + entry.A.V1) / 2,
+                           (entry.B.U0 + entry.B.U1) / 2, (entry.B.V0 + entry.B.V1) / 2};
+                Vec3 tangent;
+                if (solver.Converge(x, Constraint::None) && solver.Tangent(tangent))
+                {
+                    scratch.Seeds.push_back({x, solver.FrameA().Point, tangent});
+                }
+                top--;
+                continue;
+            }
+
+            const bool split_a = flatness_a >= flatness_b;
+            Vec4* P = split_a ? Q : Q + size_a;
+            const int p = split_a ? p_a : p_b, q = split_a ? q_a : q_b;
+            auto at = [&](int i, int j) -> Vec3 { return P[j * (p + 1) + i].head<3>() / P[j * (p + 1) + i].w(); };
+            const bool along_u = (at(p, 0) - at(0, 0)).norm() + (at(p, q) - at(0, q)).norm() >=
+                                 (at(0, q) - at(0, 0)).norm() + (at(p, q) - at(p, 0)).norm();
+
+            Entry half = entry;
+            half.Depth = ++entry.Depth;
+            std::copy_n(Q, level_size, Q + level_size);
+            Vec4* R = P + level_size;
+            const int degree = along_u ? p : q;
+            const int lines  = along_u ? q + 1 : p + 1;
+            const int step   = along_u ? 1 : p + 1;
+            const int pitch  = along_u ? p + 1 : 1;
+            for (int line = 0; line < lines; ++line)
+            {
+                RestrictBezier(P + line * pitch, degree, step, 0, 0.5);
+                RestrictBezier(R + line * pitch, degree, step, 0.5, 1);
+            }
+            Domain& domain = split_a ? entry.A : entry.B;
+            Domain& other = split_a ? half.A : half.B;
+            if (along_u)
+            {
+                domain.U1 = other.U0 = (domain.U0 + domain.U1) / 2;
+            }
+            else
+            {
+                domain.V1 = other.V0 = (domain.V0 + domain.V1) / 2;
+            }
+            stack[top++] = half;
+        }
+    }
+
+    struct Branch
+    {
+        std::vector<Vec3> Points{};
+        std::vector<Vec3> Tangents{};
+        std::vector<Unknowns> Parameters{};
+    };
+
+    /**
+     * Marches from the last point of branch along sign * tangent until a domain boundary, a tangential
+     * contact or, if start is given, back at start. Returns whether the branch closed.
+     */
+    bool March(Solver& solver, Branch& branch, Numeric sign, const Vec3* start,
+               Numeric step_max, Numeric step_min, const SurfaceIntersectionOptions& options)
+    {
+        Unknowns x = branch.Parameters.back();
+        Vec3 point = branch.Points.back();
+        Vec3 tangent = sign * branch.Tangents.back();
+        Numeric h = step_max / 8;
+        for (int count = 0; count < MAX_STEP_COUNT; ++count)
+        {
+            if (start && branch.Points.size() > 2)
+            {
+                const Vec3 ahead = *start - point;
+                const Numeric along = ahead.dot(tangent);
+                if (along > 0 && ahead.norm() <= h && (ahead - along * tangent).norm() <= 0.5 * along)
+                {
+                    return true;
+                }
+            }
+
+            // Frames of the current point for the prediction
+            solver.Evaluate(x);
+            Unknowns delta = solver.Predict(h * tangent);
+            // The first parameter to leave its domain along the prediction ends the branch there
+            Numeric fraction = 1;
+            int exit = -1;
+            for (int k = 0; k < 4; ++k)
+            {
+                const Numeric bound = delta[k] > 0 ? solver.High()[k] : solver.Low()[k];
+                if (delta[k] != 0 && (bound - x[k]) / delta[k] < fraction)
+                {
+                    fraction = std::max((bound - x[k]) / delta[k], Numeric(0));
+                    exit = k;
+                }
+            }
+            if (exit >= 0 && fraction * h < step_min) return false;
+
+            Unknowns next = x + fraction * delta;
+            if (exit >= 0) next[exit] = delta[exit] > 0 ? solver.High()[exit] : solver.Low()[exit];
+            bool accepted = exit >= 0 ? solver.Converge(next, Constraint::Fixed, tangent, point, exit)
+                                      : solver.Converge(next, Constraint::Plane, tangent, point + h * tangent);
+            Vec3 next_tangent;
+            const bool regular = accepted && solver.Tangent(next_tangent);
+            Numeric angle = 0, sag = 0;
+            const Vec3 next_point = solver.FrameA().Point;
+            if (regular)
+            {
+                if (next_tangent.dot(tangent) < 0) next_tangent = -next_tangent;
+                const Vec3 chord = next_point - point;
+                const Numeric length = chord.norm();
+                const Numeric along = chord.dot(tangent);
+                angle = std::acos(std::clamp(next_tangent.dot(tangent), Numeric(-1), Numeric(1)));
+                sag = length * angle / 8;
+                accepted = along > 0 && (chord - along * tangent).norm() <= 0.5 * along &&
+                           angle <= options.AngleTolerance && sag <= options.ChordTolerance;
+            }
+            if (!accepted)
+            {
+                h /= 2;
+                if (h < step_min) return false;
+                continue;
+            }
+
+            x = next;
+            point = next_point;
+            branch.Parameters.push_back(x);
+            branch.Points.push_back(point);
+            // Tangential contact: the point is on both surfaces, but the direction is lost
+            if (!regular)
+            {
+                branch.Tangents.push_back(sign * tangent);
+                return false;
+            }
+            tangent = next_tangent;
+            branch.Tangents.push_back(sign * tangent);
+            if (exit >= 0) return false;
+
+            // Sag grows with the square of the step, the angle linearly
+            Numeric factor = 2;
+            if (angle > 0) factor = std::min({factor, 0.9 * options.AngleTolerance / angle,
+                                              0.9 * std::sqrt(options.ChordTolerance / sag)});
+            h = std::clamp(h * factor, step_min, step_max);
+        }
+        return false;
+    }
+
+    /**
+     * Traced points hashed by cells of the longest step: every chord near a point has an end in the
+     * 27 cells around it.
+     */
+    class CoverGrid
+    {
+    public:
+        explicit CoverGrid(Numeric cell)
+            : m_Cell(cell)
+        {
+        }
+
+        void Insert(const std::vector<SurfaceIntersection>& branches)
+        {
+            const int b = static_cast<int>(branches.size()) - 1;
+            const auto& points = branches[b].Path.Points;
+            for (int k = 0; k < static_cast<int>(points.size()); ++k)
+            {
+                m_Cells[Key(Cell(points[k]))].emplace_back(b, k);
+            }
+        }
+
+        [[nodiscard]] bool Covers(const std::vector<SurfaceIntersection>& branches, const Vec3& point,
+                                  Numeric radius) const
+        {
+            const Eigen::Vector3<int64_t> center = Cell(point);
+            for (int dz = -1; dz <= 1; ++dz)
+            {
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        auto it = m_Cells.find(Key(center + Eigen::Vector3<int64_t>{dx, dy, dz}));
+                        if (it == m_Cells.end()) continue;
+                        for (const auto& [b, k] : it->second)
+                        {
+                            const auto& branch = branches[b];
+                            const int count = static_cast<int>(branch.Path.Points.size());
+                            const bool wraps = branch.Closed && count > 2;
+                            if ((k + 1 < count || wraps) &&
+                                SegmentDistance(point, branch.Path.Points[k], branch.Path.Points[(k + 1) % count]) <= radius)
+                            {
+                                return true;
+                            }
+                            if (count == 1 && (point - branch.Path.Points[k]).norm() <= radius) return true;
+                        }
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        static Numeric SegmentDistance(const Vec3& point, const Vec3& a, const Vec3& b)
+        {
+            const Vec3 ab = b - a;
+            const Numeric length = ab.squaredNorm();
+            const Numeric t = length > 0 ? std::clamp((point - a).dot(ab) / length, Numeric(0), Numeric(1)) : 0;
+            return (a + t * ab - point).norm();
+        }
+
+        [[nodiscard]] Eigen::Vector3<int64_t> Cell(const Vec3& point) const
+        {
+            return (point / m_Cell).array().floor().cast<int64_t>();
+        }
+
+        static uint64_t Key(const Eigen::Vector3<int64_t>& cell)
+        {
+            return uint64_t(cell.x()) * 73856093u ^ uint64_t(cell.y()) * 19349663u ^ uint64_t(cell.z()) * 83492791u;
+        }
+
+        Numeric m_Cell;
+        std::unordered_map<uint64_t, std::vector<std::pair<int, int>>> m_Cells{};
+    };
+
+    /**
+     * Cubic Hermite interpolation of the points along their unit tangents, with double interior knots
+     * at the chord length parameters. The inner control points sit a third of the chord along the
+     * tangents, which makes the curve C1 with speed equal to the total chord length. The tangents come
+     * from both surface normals at each point, so each segment matches the intersection in position and
+     * direction at both ends, which a global fit through the points alone would not.
+     */
+    Curve FitHermite(const std::vector<Vec3>& points, const std::vector<Vec3>& tangents, bool closed,
+                     std::vector<Numeric>& parameters)
+    {
+        const int count = static_cast<int>(points.size());
+        const int segment_count = closed ? count : count - 1;
+        std::vector<Numeric> chords(segment_count);
+        Numeric total = 0;
+        for (int i = 0; i < segment_count; ++i)
+        {
+            chords[i] = (points[(i + 1) % count] - points[i]).norm();
+            total += chords[i];
+        }
+        parameters.assign(count, 0);
+        Numeric length = 0;
+        for (int i = 1; i < count; ++i)
+        {
+            length += chords[i - 1];
+            parameters[i] = length / total;
+        }
+
+        Curve curve;
+        curve.Degree = 3;
+        std::vector<Numeric> knots(4, 0);
+        for (int i = 1; i < segment_count; ++i)
+        {
+            knots.push_back(parameters[i]);
+            knots.push_back(parameters[i]);
+        }
+        knots.insert(knots.end(), 4, 1);
+        curve.Knots = KnotVector(knots);
+        curve.ControlPoints.reserve(2 * segment_count + 2);
+        auto push = [&](const Vec3& point) { curve.ControlPoints.emplace_back(point.x(), point.y(), point.z(), 1); };
+        push(points[0]);
+        for (int i = 0; i < segment_count; ++i)
+        {
+            const int j = (i + 1) % count;
+            push(points[i] + tangents[i] * chords[i] / 3);
+            push(points[j] - tangents[j] * chords[i] / 3);
+        }
+        push(points[closed ? 0 : count - 1]);
+        return curve;
+    }
+}
+
+namespace libnurbs
+{
+    std::vector<SurfaceIntersection> Intersect(const Surface& a, const SurfaceBvh& bvh_a,
+                                               const Surface& b, const SurfaceBvh& bvh_b,
+                                               const SurfaceIntersectionOptions& options)
+    {
+        std::vector<SurfaceIntersection> branches;
+        if (bvh_a.PatchCount() == 0 || bvh_b.PatchCount() == 0) return branches;
+        Domain domain_a, domain_b, last;
+        bvh_a.PatchDomain(0, domain_a.U0, last.U1, domain_a.V0, last.V1);
+        bvh_a.PatchDomain(bvh_a.PatchCount() - 1, last.U0, domain_a.U1, last.V0, domain_a.V1);
+        bvh_b.PatchDomain(0, domain_b.U0, last.U1, domain_b.V0, last.V1);
+        bvh_b.PatchDomain(bvh_b.PatchCount() - 1, last.U0, domain_b.U1, last.V0, domain_b.V1);
+
+        // Start points of all overlapping patch pairs, in pair order
+        std::vector<std::pair<int, int>> pairs;
+        bvh_a.QueryOverlaps(bvh_b, pairs);
+        const int pair_count = static_cast<int>(pairs.size());
+        const int workers = Utils::ResolveThreadCount(options.ThreadCount, pair_count);
+        std::vector<Solver> solvers(workers, Solver(a, domain_a, b, domain_b, options.Tolerance));
+        std::vector<SeedScratch> scratches(workers);
+        std::vector<std::vector<Seed>> seeds(pair_count);
+        Utils::ParallelFor(pair_count, workers, [&](int k, int worker)
+        {
+            SeedScratch& scratch = scratches[worker];
+            scratch.Seeds.clear();
+            FindSeeds(bvh_a, pairs[k].first, a.DegreeU, a.DegreeV, bvh_b, pairs[k].second, b.DegreeU, b.DegreeV,
+                      options.ChordTolerance, options.Tolerance, solvers[worker], scratch);
+            seeds[k] = scratch.Seeds;
+        }, 1);
+
+        const Numeric diagonal = std::min(bvh_a.GetBoundingBox().Length().norm(), bvh_b.GetBoundingBox().Length().norm());
+        const Numeric step_max = std::max(MAX_STEP * diagonal, options.ChordTolerance);
+        const Numeric step_min = MIN_STEP * std::max(diagonal, Numeric(1));
+        const Numeric cover = COVER_FACTOR * options.ChordTolerance + options.Tolerance;
+        CoverGrid covered(step_max);
+        Solver& solver = solvers.front();
+        for (const auto& pair_seeds : seeds)
+        {
+            for (const Seed& seed : pair_seeds)
+            {
+                const Vec3& start = seed.Point;
+                if (covered.Covers(branches, start, cover)) continue;
+
+                Branch forward, backward;
+                forward.Points = backward.Points = {start};
+                forward.Tangents = backward.Tangents = {seed.Tangent};
+                forward.Parameters = backward.Parameters = {seed.X};
+                const bool closed = March(solver, forward, 1, &start, step_max, step_min, options);
+                if (!closed) March(solver, backward, -1, nullptr, step_max, step_min, options);
+                if (forward.Points.size() + backward.Points.size() < 4) continue;
+
+                SurfaceIntersection& branch = branches.emplace_back();
+                branch.Closed = closed;
+                std::vector<Vec3> points, tangents;
+                for (size_t i = backward.Points.size() - 1; i > 0; --i)
+                {
+                    points.push_back(backward.Points[i]);
+                    tangents.push_back(backward.Tangents[i]);
+                    branch.ParametersA.push_back(backward.Parameters[i].head<2>());
+                    branch.ParametersB.push_back(backward.Parameters[i].tail<2>());
+                }
+                for (size_t i = 0; i < forward.Points.size(); ++i)
+                {
+                    points.push_back(forward.Points[i]);
+                    tangents.push_back(forward.Tangents[i]);
+                    branch.ParametersA.push_back(forward.Parameters[i].head<2>());
+                    branch.ParametersB.push_back(forward.Parameters[i].tail<2>());
+                }
+                branch.Fitted = FitHermite(points, tangents, closed, branch.Path.Parameters);
+                branch.Path.Points = std::move(points);
+                covered.Insert(branches);
+            }
+        }
+        return branches;
+    }
+
+    std::vector<SurfaceIntersection> Intersect(const Surface& a, const Surface& b,
+                                               const SurfaceIntersectionOptions& options)
+    {
+        return Intersect(a, SurfaceBvh(a), b, SurfaceBvh(b), options);
+    }
+}
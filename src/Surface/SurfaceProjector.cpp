@@ -0,0 +1,73 @@
+#include "libnurbs/Surface/SurfaceProjector.hpp"
+
+#include <algorithm>
+
+using namespace libnurbs;
+
+SurfaceProjector::SurfaceProjector(const Surface& surface, Numeric epsilon, int max_iteration_count)
+    : m_Surface(&surface),
+      m_Epsilon(epsilon),
+      m_MaxIterationCount(max_iteration_count)
+{
+}
+
+Surface::ProjectionResult SurfaceProjector::Project(const Vec3& point)
+{
+    Surface::ProjectionResult result;
+    bool accepted = false;
+
+    if (m_HasLast)
+    {
+        result.U = std::clamp(m_U + m_IncrementU, Numeric(0), Numeric(1));
+        result.V = std::clamp(m_V + m_IncrementV, Numeric(0), Numeric(1));
+        int span_u = m_SpanCursorU, span_v = m_SpanCursorV;
+        result.Converged = RefineProjection(*m_Surface, point, result.U, result.V, span_u, span_v, result.Point,
+                                            m_Scratch, m_Epsilon, std::min(LOCAL_ITERATION_COUNT, m_MaxIterationCount));
+        result.Distance = (result.Point - point).norm();
+
+        // The global distance cannot exceed |P - P_last| + d_last, a larger one means another sheet was hit.
+        Numeric bound = (point - m_LastPoint).norm() + m_LastDistance + m_Epsilon;
+        accepted = result.Converged && result.Distance <= bound;
+        if (accepted)
+        {
+            m_SpanCursorU = span_u;
+            m_SpanCursorV = span_v;
+        }
+    }
+
+    if (!accepted)
+    {
+        if (m_Seeds.SpanBoxes.empty())
+        {
+            m_Seeds = BuildProjectionSeeds(*m_Surface, std::max(m_Surface->DegreeU, m_Surface->DegreeV) + 2);
+            m_Bvh = SurfaceBvh(*m_Surface);
+        }
+        ++m_GlobalSeedCount;
+        int seed = FindNearestSeed(m_Seeds, m_Bvh, point);
+        result.U = m_Seeds.ParametersU[seed];
+        result.V = m_Seeds.ParametersV[seed];
+        m_SpanCursorU = INVALID_INDEX;
+        m_SpanCursorV = INVALID_INDEX;
+        result.Converged = RefineProjection(*m_Surface, point, result.U, result.V, m_SpanCursorU, m_SpanCursorV,
+                                            result.Point, m_Scratch, m_Epsilon, m_MaxIterationCount);
+        result.Distance = (result.Point - point).norm();
+    }
+
+    m_IncrementU = accepted ? result.U - m_U : 0;
+    m_IncrementV = accepted ? result.V - m_V : 0;
+    m_U = result.U;
+    m_V = result.V;
+    m_LastPoint = point;
+    m_LastDistance = result.Distance;
+    m_HasLast = true;
+    return result;
+}
+
+void SurfaceProjector::Reset()
+{
+    m_HasLast = false;
+    m_IncrementU = 0;
+    m_IncrementV = 0;
+    m_SpanCursorU = INVALID_INDEX;
+    m_SpanCursorV = INVALID_INDEX;
+}
@@ -0,0 +1,101 @@
+#include "libnurbs/Tessellation/IncrementalTessellation.hpp"
+
+using namespace libnurbs;
+
+IncrementalTessellation::IncrementalTessellation(Surface& surface, const Surface::TessellationOptions& options)
+    : m_Surface(&surface),
+      m_Options(options)
+{
+    Rebuild();
+}
+
+void IncrementalTessellation::Rebuild()
+{
+    const Surface& surface = *m_Surface;
+    m_Tessellation = std::make_unique<SurfaceTessellation>(surface, m_Options);
+    for (int patch = 0; patch < m_Tessellation->PatchCount(); ++patch)
+    {
+        m_Tessellation->PlanPatch(patch, m_Scratch);
+    }
+    m_Tessellation->Layout();
+    m_Mesh.Resize(m_Tessellation->VertexCount(), m_Tessellation->TriangleCount());
+    for (int patch = 0; patch < m_Tessellation->PatchCount(); ++patch)
+    {
+        m_Tessellation->EmitPatch(patch, m_Mesh, m_Scratch);
+    }
+
+    m_PatchBoxes.resize(m_Tessellation->PatchCount());
+    for (int patch = 0; patch < m_Tessellation->PatchCount(); ++patch)
+    {
+        UpdatePatchBox(patch);
+    }
+    UpdateBoundingBox();
+
+    m_DegreeU = surface.DegreeU;
+    m_DegreeV = surface.DegreeV;
+    m_CountU  = surface.ControlPoints.UCount;
+    m_CountV  = surface.ControlPoints.VCount;
+    m_KnotsU  = surface.KnotsU.Values();
+    m_KnotsV  = surface.KnotsV.Values();
+    m_Surface->ControlPoints.ClearDirtyRegion();
+}
+
+bool IncrementalTessellation::IsStructureUnchanged() const
+{
+    const Surface& surface = *m_Surface;
+    return surface.DegreeU == m_DegreeU && surface.DegreeV == m_DegreeV &&
+           surface.ControlPoints.UCount == m_CountU && surface.ControlPoints.VCount == m_CountV &&
+           surface.KnotsU.Values() == m_KnotsU && surface.KnotsV.Values() == m_KnotsV;
+}
+
+int IncrementalTessellation::Update()
+{
+    const GridRegion region = m_Surface->ControlPoints.DirtyRegion();
+    if (region.IsEmpty()) return 0;
+    if (!IsStructureUnchanged())
+    {
+        Rebuild();
+        return m_Tessellation->PatchCount();
+    }
+
+    auto updated = std::make_unique<SurfaceTessellation>(*m_Tessellation);
+    std::vector<int> patches = updated->Replan(region, m_Scratch);
+    updated->Layout();
+    m_Spare.Resize(updated->VertexCount(), updated->TriangleCount());
+    for (int patch = 0; patch < updated->PatchCount(); ++patch)
+    {
+        updated->EmitPatch(patch, m_Spare, m_Scratch, *m_Tessellation, m_Mesh, region);
+    }
+    std::swap(m_Mesh, m_Spare);
+    m_Tessellation = std::move(updated);
+
+    for (int patch : patches)
+    {
+        UpdatePatchBox(patch);
+    }
+    UpdateBoundingBox();
+    m_Surface->ControlPoints.ClearDirtyRegion();
+    return static_cast<int>(patches.size());
+}
+
+void IncrementalTessellation::UpdatePatchBox(int patch)
+{
+    // Positive weights keep the patch in the convex hull of its Bezier points
+    auto points = m_Tessellation->PatchPoints(patch);
+    Vec3 first = FromHomo(points[0]).head<3>();
+    BoundingBox box(first, first);
+    for (const auto& point : points)
+    {
+        box.ExpandToInclude(Vec3(FromHomo(point).head<3>()));
+    }
+    m_PatchBoxes[patch] = box;
+}
+
+void IncrementalTessellation::UpdateBoundingBox()
+{
+    m_BoundingBox = m_PatchBoxes.front();
+    for (const auto& box : m_PatchBoxes)
+    {
+        m_BoundingBox.ExpandToInclude(box);
+    }
+}
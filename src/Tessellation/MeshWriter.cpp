@@ -0,0 +1,324 @@
+#include "libnurbs/Tessellation/MeshWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace libnurbs;
+
+namespace
+{
+    constexpr int STL_HEADER_SIZE = 80;
+    constexpr int STL_TRIANGLE_SIZE = 50;
+    constexpr int PLY_VERTEX_SIZE = 8 * sizeof(float);
+    constexpr int PLY_FACE_SIZE = 1 + 3 * sizeof(uint32_t);
+    constexpr int PLY_COUNT_WIDTH = 10;
+
+    template <typename T>
+    void AppendLittleEndian(std::vector<char>& buffer, T value)
+    {
+        auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            std::reverse(bytes.begin(), bytes.end());
+        }
+        buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+    }
+
+    void AppendFloats(std::vector<char>& buffer, const Numeric* values, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            AppendLittleEndian(buffer, static_cast<float>(values[i]));
+        }
+    }
+
+    // resize and memcpy rather than insert, which GCC 12 misreads as an overflow once inlined
+    void AppendText(std::vector<char>& buffer, std::string_view text)
+    {
+        if (text.empty()) return;
+        const size_t old_size = buffer.size();
+        buffer.resize(old_size + text.size());
+        std::memcpy(buffer.data() + old_size, text.data(), text.size());
+    }
+
+    // Shortest text that reads back to the same value.
+    void AppendNumber(std::vector<char>& buffer, Numeric value)
+    {
+        char text[32];
+        auto result = std::to_chars(std::begin(text), std::end(text), value);
+        buffer.insert(buffer.end(), text, result.ptr);
+    }
+
+    void AppendNumber(std::vector<char>& buffer, uint64_t value)
+    {
+        char text[24];
+        auto result = std::to_chars(std::begin(text), std::end(text), value);
+        buffer.insert(buffer.end(), text, result.ptr);
+    }
+
+    void Flush(std::ostream& os, std::vector<char>& buffer)
+    {
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+        if (os.fail())
+        {
+            throw std::runtime_error("Failed to write mesh to stream.");
+        }
+    }
+
+    std::streampos Tell(std::ostream& os)
+    {
+        auto position = os.tellp();
+        if (position == std::streampos(-1))
+        {
+            throw std::runtime_error("Mesh writer requires a seekable stream.");
+        }
+        return position;
+    }
+
+    // Overwrites bytes written earlier and returns to the end of the stream.
+    void Patch(std::ostream& os, std::streampos position, const std::vector<char>& bytes)
+    {
+        auto end = Tell(os);
+        os.seekp(position);
+        os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        os.seekp(end);
+        if (os.fail())
+        {
+            throw std::runtime_error("Failed to patch mesh header.");
+        }
+    }
+
+    void CheckNotFinished(bool finished)
+    {
+        if (finished)
+        {
+            throw std::runtime_error("Cannot write a mesh after Finish.");
+        }
+    }
+
+    void CheckIndexRange(uint64_t count)
+    {
+        if (count > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::runtime_error("Mesh exceeds the 32-bit count limit of the file format.");
+        }
+    }
+}
+
+namespace libnurbs
+{
+    StlWriter::StlWriter(std::ostream& os)
+        : m_Stream(os)
+    {
+        m_Buffer.assign(STL_HEADER_SIZE, ' ');
+        constexpr std::string_view title = "libnurbs binary STL";
+        std::memcpy(m_Buffer.data(), title.data(), title.size());
+        m_CountPosition = Tell(m_Stream) + std::streamoff(STL_HEADER_SIZE);
+        AppendLittleEndian(m_Buffer, uint32_t(0));
+        Flush(m_Stream, m_Buffer);
+    }
+
+    void StlWriter::Write(const TriangleMesh& mesh)
+    {
+        CheckNotFinished(m_Finished);
+        const int triangle_count = mesh.TriangleCount();
+        CheckIndexRange(m_TriangleCount + triangle_count);
+        m_Buffer.reserve(static_cast<size_t>(triangle_count) * STL_TRIANGLE_SIZE);
+        for (int t = 0; t < triangle_count; ++t)
+        {
+            const uint32_t* corners = &mesh.Indices[3 * t];
+            Vec3 a = mesh.Position(corners[0]);
+            Vec3 b = mesh.Position(corners[1]);
+            Vec3 c = mesh.Position(corners[2]);
+            Vec3 normal = (b - a).cross(c - a);
+            Numeric length = normal.norm();
+            if (length > 0) normal /= length;
+
+            AppendFloats(m_Buffer, normal.data(), 3);
+            for (int k = 0; k < 3; ++k)
+            {
+                AppendFloats(m_Buffer, &mesh.Positions[3 * corners[k]], 3);
+            }
+            AppendLittleEndian(m_Buffer, uint16_t(0));
+        }
+        Flush(m_Stream, m_Buffer);
+        m_VertexCount += mesh.VertexCount();
+        m_TriangleCount += triangle_count;
+    }
+
+    void StlWriter::Finish()
+    {
+        if (m_Finished) return;
+        m_Finished = true;
+        AppendLittleEndian(m_Buffer, static_cast<uint32_t>(m_TriangleCount));
+        Patch(m_Stream, m_CountPosition, m_Buffer);
+        m_Buffer.clear();
+        m_Stream.flush();
+    }
+
+    PlyWriter::PlyWriter(std::ostream& os)
+        : m_Stream(os), m_Faces(std::tmpfile())
+    {
+        if (!m_Faces)
+        {
+            throw std::runtime_error("Failed to create temporary file for PLY faces.");
+        }
+        const std::string zero_count(PLY_COUNT_WIDTH, '0');
+        const auto start = Tell(m_Stream);
+        AppendText(m_Buffer, "ply\nformat binary_little_endian 1.0\ncomment libnurbs\nelement vertex ");
+        m_VertexCountPosition = start + std::streamoff(m_Buffer.size());
+        AppendText(m_Buffer, zero_count);
+        AppendText(m_Buffer, "\nproperty float x\nproperty float y\nproperty float z"
+                             "\nproperty float nx\nproperty float ny\nproperty float nz"
+                             "\nproperty float s\nproperty float t\nelement face ");
+        m_FaceCountPosition = start + std::streamoff(m_Buffer.size());
+        AppendText(m_Buffer, zero_count);
+        AppendText(m_Buffer, "\nproperty list uchar uint vertex_indices\nend_header\n");
+        Flush(m_Stream, m_Buffer);
+    }
+
+    void PlyWriter::Write(const TriangleMesh& mesh)
+    {
+        CheckNotFinished(m_Finished);
+        const int vertex_count = mesh.VertexCount();
+        const int triangle_count = mesh.TriangleCount();
+        CheckIndexRange(m_VertexCount + vertex_count);
+        CheckIndexRange(m_TriangleCount + triangle_count);
+
+        m_Buffer.reserve(static_cast<size_t>(vertex_count) * PLY_VERTEX_SIZE);
+        for (int i = 0; i < vertex_count; ++i)
+        {
+            AppendFloats(m_Buffer, &mesh.Positions[3 * i], 3);
+            AppendFloats(m_Buffer, &mesh.Normals[3 * i], 3);
+            AppendFloats(m_Buffer, &mesh.UVs[2 * i], 2);
+        }
+        Flush(m_Stream, m_Buffer);
+
+        const auto offset = static_cast<uint32_t>(m_VertexCount);
+        m_Buffer.reserve(static_cast<size_t>(triangle_count) * PLY_FACE_SIZE);
+        for (int t = 0; t < triangle_count; ++t)
+        {
+            AppendLittleEndian(m_Buffer, uint8_t(3));
+            for (int k = 0; k < 3; ++k)
+            {
+                AppendLittleEndian(m_Buffer, mesh.Indices[3 * t + k] + offset);
+            }
+        }
+        if (std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_Faces.get()) != m_Buffer.size())
+        {
+            throw std::runtime_error("Failed to write PLY faces to temporary file.");
+        }
+        m_Buffer.clear();
+        m_VertexCount += vertex_count;
+        m_TriangleCount += triangle_count;
+    }
+
+    void PlyWriter::Finish()
+    {
+        if (m_Finished) return;
+        m_Finished = true;
+        // Append the spooled faces in fixed size chunks.
+        std::rewind(m_Faces.get());
+        m_Buffer.resize(size_t(1) << 16);
+        size_t read;
+        while ((read = std::fread(m_Buffer.data(), 1, m_Buffer.size(), m_Faces.get())) > 0)
+        {
+            m_Stream.write(m_Buffer.data(), static_cast<std::streamsize>(read));
+        }
+        if (std::ferror(m_Faces.get()) || m_Stream.fail())
+        {
+            throw std::runtime_error("Failed to append PLY faces.");
+        }
+        m_Faces.reset();
+
+        auto patch_count = [&](std::streampos position, uint64_t count)
+        {
+            m_Buffer.assign(PLY_COUNT_WIDTH, '0');
+            char text[PLY_COUNT_WIDTH];
+            auto result = std::to_chars(std::begin(text), std::end(text), count);
+            std::copy(text, result.ptr, m_Buffer.end() - (result.ptr - text));
+            Patch(m_Stream, position, m_Buffer);
+        };
+        patch_count(m_VertexCountPosition, m_VertexCount);
+        patch_count(m_FaceCountPosition, m_TriangleCount);
+        m_Buffer.clear();
+        m_Stream.flush();
+    }
+
+    ObjWriter::ObjWriter(std::ostream& os)
+        : m_Stream(os)
+    {
+        AppendText(m_Buffer, "# libnurbs\n");
+        Flush(m_Stream, m_Buffer);
+    }
+
+    void ObjWriter::Write(const TriangleMesh& mesh)
+    {
+        CheckNotFinished(m_Finished);
+        const int vertex_count = mesh.VertexCount();
+        const int triangle_count = mesh.TriangleCount();
+
+        AppendText(m_Buffer, "o mesh");
+        AppendNumber(m_Buffer, static_cast<uint64_t>(m_ObjectCount++));
+        auto append_line = [&](std::string_view tag, const Numeric* values, int count)
+        {
+            AppendText(m_Buffer, tag);
+            for (int k = 0; k < count; ++k)
+            {
+                m_Buffer.push_back(' ');
+                AppendNumber(m_Buffer, values[k]);
+            }
+        };
+        for (int i = 0; i < vertex_count; ++i)
+        {
+            append_line("\nv", &mesh.Positions[3 * i], 3);
+        }
+        for (int i = 0; i < vertex_count; ++i)
+        {
+            append_line("\nvn", &mesh.Normals[3 * i], 3);
+        }
+        for (int i = 0; i < vertex_count; ++i)
+        {
+            append_line("\nvt", &mesh.UVs[2 * i], 2);
+        }
+        // OBJ indices are one based and count every vertex of the file.
+        const uint64_t offset = m_VertexCount + 1;
+        for (int t = 0; t < triangle_count; ++t)
+        {
+            AppendText(m_Buffer, "\nf");
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint64_t index = mesh.Indices[3 * t + k] + offset;
+                m_Buffer.push_back(' ');
+                AppendNumber(m_Buffer, index);
+                m_Buffer.push_back('/');
+                AppendNumber(m_Buffer, index);
+                m_Buffer.push_back('/');
+                AppendNumber(m_Buffer, index);
+            }
+        }
+        m_Buffer.push_back('\n');
+        Flush(m_Stream, m_Buffer);
+        m_VertexCount += vertex_count;
+        m_TriangleCount += triangle_count;
+    }
+
+    void ObjWriter::Finish()
+    {
+        if (m_Finished) return;
+        m_Finished = true;
+        m_Stream.flush();
+        if (m_Stream.fail())
+        {
+            throw std::runtime_error("Failed to write mesh to stream.");
+        }
+    }
+}
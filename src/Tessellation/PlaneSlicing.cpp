@@ -0,0 +1,438 @@
+#include "libnurbs/Tessellation/PlaneSlicing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "libnurbs/Algorithm/Bernstein.hpp"
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+#include "libnurbs/Tessellation/SurfaceTessellation.hpp"
+#include "libnurbs/Utils/Parallel.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    using Vec2 = Eigen::Vector2<Numeric>;
+
+    constexpr int CROSSING_ITERATION_COUNT = 64;
+    // Levels per chunk claimed by a worker
+    constexpr int LEVEL_CHUNK_SIZE = 4;
+
+    /**
+     * Items grouped by the levels their height ranges span, stored back to back per level. A level
+     * only lists the items spanning it, and the grouping costs as much as its output.
+     */
+    class LevelBuckets
+    {
+    public:
+        LevelBuckets(std::span<const Numeric> levels, const std::vector<std::pair<Numeric, Numeric>>& ranges)
+        {
+            const int level_count = static_cast<int>(levels.size());
+            std::vector<int> order(level_count);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](int x, int y) { return levels[x] < levels[y]; });
+            std::vector<Numeric> sorted(level_count);
+            for (int k = 0; k < level_count; ++k) sorted[k] = levels[order[k]];
+
+            // Ranks of the levels each item spans, then counts, offsets and items per level
+            std::vector<std::pair<int, int>> ranks(ranges.size());
+            m_Offsets.assign(level_count + 1, 0);
+            for (size_t item = 0; item < ranges.size(); ++item)
+            {
+                const int begin = static_cast<int>(std::lower_bound(sorted.begin(), sorted.end(), ranges[item].first) -
+                                                   sorted.begin());
+                const int end = static_cast<int>(std::upper_bound(sorted.begin(), sorted.end(), ranges[item].second) -
+                                                 sorted.begin());
+                ranks[item] = {begin, end};
+                for (int r = begin; r < end; ++r) m_Offsets[order[r] + 1]++;
+            }
+            std::partial_sum(m_Offsets.begin(), m_Offsets.end(), m_Offsets.begin());
+            m_Items.resize(m_Offsets.back());
+            std::vector<int> fill(m_Offsets.begin(), m_Offsets.end() - 1);
+            for (size_t item = 0; item < ranges.size(); ++item)
+            {
+                for (int r = ranks[item].first; r < ranks[item].second; ++r)
+                {
+                    m_Items[fill[order[r]]++] = static_cast<int>(item);
+                }
+            }
+        }
+
+        // Items spanning a level, ascending
+        [[nodiscard]] std::span<const int> Get(int level) const
+        {
+            return {m_Items.data() + m_Offsets[level], static_cast<size_t>(m_Offsets[level + 1] - m_Offsets[level])};
+        }
+
+    private:
+        std::vector<int> m_Offsets{};
+        std::vector<int> m_Items{};
+    };
+
+    // Heights of homogeneous Bezier points, widened by margin to absorb rounding of the evaluated surface.
+    std::pair<Numeric, Numeric> HeightRange(std::span<const Vec4> points, const Vec3& normal, Numeric margin)
+    {
+        Numeric low = std::numeric_limits<Numeric>::max(), high = -std::numeric_limits<Numeric>::max();
+        for (const auto& point : points)
+        {
+            const Numeric height = normal.dot(point.head<3>()) / point.w();
+            low  = std::min(low, height);
+            high = std::max(high, height);
+        }
+        return {low - margin, high + margin};
+    }
+
+    /**
+     * Tensor grid of surface parameters the contours are traced on. Edges are keyed by their first node
+     * and direction: 2 * node for the edge to node + 1 in u, 2 * node + 1 for the edge to the next row.
+     */
+    struct ContourGrid
+    {
+        std::vector<Numeric> U{};
+        std::vector<Numeric> V{};
+        // First grid line of each patch column and row, one more entry for the far end
+        std::vector<int> ColumnStart{};
+        std::vector<int> RowStart{};
+        // Knot spans of the cells starting at each grid line, the last line keeps the last span
+        std::vector<int> SpanU{};
+        std::vector<int> SpanV{};
+        std::vector<Numeric> Heights{};
+
+        [[nodiscard]] int Node(int i, int j) const
+        {
+            return j * static_cast<int>(U.size()) + i;
+        }
+    };
+
+    struct SliceSegment
+    {
+        int64_t From;
+        int64_t To;
+    };
+
+    struct SliceScratch
+    {
+        Surface::EvaluationScratch Evaluation{};
+        std::vector<SliceSegment> Segments{};
+        std::vector<int64_t> Keys{};
+        std::vector<int64_t> Ends{};
+        std::vector<Vec2> Parameters{};
+        std::vector<Vec3> Points{};
+        std::vector<char> Visited{};
+    };
+
+    // Point of a homogeneous Bezier segment by de Casteljau
+    Vec3 EvaluateBezier(const Vec4* points, int degree, Numeric t)
+    {
+        Vec4 buffer[MAX_BERNSTEIN_DEGREE + 1];
+        std::copy(points, points + degree + 1, buffer);
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int i = 0; i <= degree - r; ++i) buffer[i] = (1 - t) * buffer[i] + t * buffer[i + 1];
+        }
+        return buffer[0].head<3>() / buffer[0].w();
+    }
+
+    std::vector<Numeric> GridLines(int patch_count, const std::vector<int>& segments,
+                                   const std::vector<Numeric>& breakpoints, std::vector<int>& starts)
+    {
+        std::vector<Numeric> lines;
+        starts.clear();
+        for (int a = 0; a < patch_count; ++a)
+        {
+            starts.push_back(static_cast<int>(lines.size()));
+            const Numeric low = breakpoints[a], high = breakpoints[a + 1];
+            for (int k = 0; k < segments[a]; ++k)
+            {
+                lines.push_back(low + (high - low) * k / segments[a]);
+            }
+        }
+        starts.push_back(static_cast<int>(lines.size()));
+        lines.push_back(breakpoints.back());
+        return lines;
+    }
+
+    /**
+     * Solves normal·S = level on the grid edge of key, bracketed by its nodes: Newton steps along the
+     * edge, falling back to bisection where a step leaves the bracket.
+     */
+    void SolveCrossing(const Surface& surface, const ContourGrid& grid, const Vec3& normal, Numeric level,
+                       int64_t key, Numeric tolerance, Surface::EvaluationScratch& scratch, Vec2& parameters,
+                       Vec3& point)
+    {
+        const int node     = static_cast<int>(key >> 1);
+        const bool along_v = (key & 1) != 0;
+        const int nu       = static_cast<int>(grid.U.size());
+        const int i = node % nu, j = node / nu;
+        const int other = along_v ? node + nu : node + 1;
+        Numeric low = along_v ? grid.V[j] : grid.U[i];
+        Numeric high = along_v ? grid.V[j + 1] : grid.U[i + 1];
+        Numeric g_low = grid.Heights[node] - level, g_high = grid.Heights[other] - level;
+
+        Numeric x = g_low == g_high ? (low + high) / 2 : low + (high - low) * g_low / (g_low - g_high);
+        for (int count = 0; count < CROSSING_ITERATION_COUNT; ++count)
+        {
+            parameters = along_v ? Vec2{grid.U[i], x} : Vec2{x, grid.V[j]};
+            const auto& ders = surface.EvaluateAll(parameters.x(), parameters.y(), along_v ? 0 : 1, along_v ? 1 : 0,
+                                                   scratch, grid.SpanU[i], grid.SpanV[j]);
+            point = ders.Get(0, 0);
+            const Numeric g = normal.dot(point) - level;
+            if (std::abs(g) <= tolerance || high - low <= std::numeric_limits<Numeric>::epsilon() * std::abs(high))
+            {
+                return;
+            }
+            if ((g < 0) == (g_low < 0))
+            {
+                low = x;
+                g_low = g;
+            }
+            else
+            {
+                high = x;
+                g_high = g;
+            }
+            const Numeric slope = normal.dot(along_v ? ders.Get(0, 1) : ders.Get(1, 0));
+            const Numeric next = x - g / slope;
+            x = slope != 0 && next > low && next < high ? next : (low + high) / 2;
+        }
+    }
+
+    // Marching squares over the cells of one patch, segments oriented with the higher side on their left.
+    void MarchPatch(const ContourGrid& grid, int a, int b, Numeric level, std::vector<SliceSegment>& segments)
+    {
+        for (int j = grid.RowStart[b]; j < grid.RowStart[b + 1]; ++j)
+        {
+            for (int i = grid.ColumnStart[a]; i < grid.ColumnStart[a + 1]; ++i)
+            {
+                // Corners and edges counterclockwise, edge k runs from corner k to corner k + 1
+                const int corners[4] = {grid.Node(i, j), grid.Node(i + 1, j), grid.Node(i + 1, j + 1),
+                                        grid.Node(i, j + 1)};
+                const int64_t edges[4] = {2 * int64_t(corners[0]), 2 * int64_t(corners[1]) + 1,
+                                          2 * int64_t(corners[3]), 2 * int64_t(corners[0]) + 1};
+                bool above[4];
+                int crossings = 0;
+                for (int k = 0; k < 4; ++k) above[k] = grid.Heights[corners[k]] >= level;
+                for (int k = 0; k < 4; ++k) crossings += above[k] != above[(k + 1) % 4];
+                if (crossings == 0) continue;
+
+                // A falling edge leaves the higher side; the segment from it to the rising edge keeps that
+                // side on its left. Saddles pair by the mean height: a higher center joins the higher corners.
+                const Numeric center = (grid.Heights[corners[0]] + grid.Heights[corners[1]] +
+                                        grid.Heights[corners[2]] + grid.Heights[corners[3]]) / 4;
+                for (int k = 0; k < 4; ++k)
+                {
+                    if (!above[k] || above[(k + 1) % 4]) continue;
+                    int rising = (k + 1) % 4;
+                    if (crossings == 2)
+                    {
+                        while (above[rising] || !above[(rising + 1) % 4]) rising = (rising + 1) % 4;
+                    }
+                    else if (center < level)
+                    {
+                        rising = (k + 3) % 4;
+                    }
+                    segments.push_back({edges[k], edges[rising]});
+                }
+            }
+        }
+    }
+
+    // Chains the segments of one level into contours: open ones from the segments nothing leads to, then loops.
+    void ChainSegments(SliceScratch& scratch, std::vector<SliceContour>& contours)
+    {
+        auto& segments = scratch.Segments;
+        std::sort(segments.begin(), segments.end(), [](const auto& x, const auto& y) { return x.From < y.From; });
+        scratch.Ends.clear();
+        for (const auto& segment : segments) scratch.Ends.push_back(segment.To);
+        std::sort(scratch.Ends.begin(), scratch.Ends.end());
+        scratch.Visited.assign(segments.size(), 0);
+
+        auto crossing = [&](int64_t key)
+        {
+            return std::lower_bound(scratch.Keys.begin(), scratch.Keys.end(), key) - scratch.Keys.begin();
+        };
+        auto next = [&](int64_t key) -> int
+        {
+            auto it = std::lower_bound(segments.begin(), segments.end(), key,
+                                       [](const auto& segment, int64_t value) { return segment.From < value; });
+            return it != segments.end() && it->From == key ? static_cast<int>(it - segments.begin()) : -1;
+        };
+        auto append = [&](SliceContour& contour, int64_t key)
+        {
+            const auto index = crossing(key);
+            // Nodes right on the level give zero length segments
+            if (!contour.Points.empty() && contour.Points.back() == scratch.Points[index]) return;
+            contour.Points.push_back(scratch.Points[index]);
+            contour.Parameters.push_back(scratch.Parameters[index]);
+        };
+        auto trace = [&](int first)
+        {
+            SliceContour contour;
+            append(contour, segments[first].From);
+            int current = first;
+            while (current >= 0 && !scratch.Visited[current])
+            {
+                scratch.Visited[current] = 1;
+                const int following = next(segments[current].To);
+                contour.Closed = following == first;
+                if (!contour.Closed) append(contour, segments[current].To);
+                current = following;
+            }
+            if (contour.Closed && contour.Points.size() > 1 && contour.Points.back() == contour.Points.front())
+            {
+                contour.Points.pop_back();
+                contour.Parameters.pop_back();
+            }
+            contours.push_back(std::move(contour));
+        };
+
+        for (size_t s = 0; s < segments.size(); ++s)
+        {
+            if (!std::binary_search(scratch.Ends.begin(), scratch.Ends.end(), segments[s].From))
+            {
+                trace(static_cast<int>(s));
+            }
+        }
+        for (size_t s = 0; s < segments.size(); ++s)
+        {
+            if (!scratch.Visited[s]) trace(static_cast<int>(s));
+        }
+    }
+}
+
+namespace libnurbs
+{
+    std::vector<Polyline> SliceCurve(const Curve& curve, std::span<const Numeric> levels, const SliceOptions& options)
+    {
+        const int p = curve.Degree;
+        if (p > MAX_BERNSTEIN_DEGREE)
+        {
+            throw std::runtime_error("Curve degree is too high for slicing.");
+        }
+        std::vector<Vec4> homogeneous(curve.ControlPoints.size());
+        std::transform(curve.ControlPoints.begin(), curve.ControlPoints.end(), homogeneous.begin(), ToHomo);
+        std::vector<Vec4> points;
+        std::vector<Numeric> breakpoints;
+        const int segment_count = DecomposeCurve(p, curve.Knots, homogeneous, points, breakpoints);
+
+        std::vector<std::pair<Numeric, Numeric>> ranges(segment_count);
+        for (int s = 0; s < segment_count; ++s)
+        {
+            ranges[s] = HeightRange({points.data() + s * (p + 1), static_cast<size_t>(p + 1)}, options.Normal, 0);
+        }
+        const LevelBuckets buckets(levels, ranges);
+
+        const int level_count = static_cast<int>(levels.size());
+        const int workers = Utils::ResolveThreadCount(options.ThreadCount, level_count);
+        std::vector<std::vector<Numeric>> roots(workers);
+        std::vector<Polyline> slices(level_count);
+        const Numeric merge = options.Tolerance * (breakpoints.back() - breakpoints.front());
+        Utils::ParallelFor(level_count, workers, [&](int k, int worker)
+        {
+            Polyline& slice = slices[k];
+            Numeric coefficients[MAX_BERNSTEIN_DEGREE + 1];
+            for (int s : buckets.Get(k))
+            {
+                const Vec4* Q = points.data() + s * (p + 1);
+                for (int i = 0; i <= p; ++i)
+                {
+                    coefficients[i] = options.Normal.dot(Q[i].head<3>()) - levels[k] * Q[i].w();
+                }
+                roots[worker].clear();
+                FindBernsteinRoots({coefficients, static_cast<size_t>(p + 1)}, options.Tolerance, roots[worker]);
+                for (Numeric t : roots[worker])
+                {
+                    const Numeric x = breakpoints[s] + (breakpoints[s + 1] - breakpoints[s]) * t;
+                    // Roots on a breakpoint are found by both segments
+                    if (!slice.Parameters.empty() && x - slice.Parameters.back() <= merge) continue;
+                    slice.Parameters.push_back(x);
+                    slice.Points.push_back(EvaluateBezier(Q, p, t));
+                }
+            }
+        }, LEVEL_CHUNK_SIZE);
+        return slices;
+    }
+
+    std::vector<std::vector<SliceContour>> SliceSurface(const Surface& surface, std::span<const Numeric> levels,
+                                                        const SliceOptions& options)
+    {
+        const Vec3& normal = options.Normal;
+        SurfaceTessellation tessellation(surface, options.Grid);
+        const int patch_count = tessellation.PatchCount();
+        const int cu = tessellation.PatchCountU();
+        const int cv = patch_count / cu;
+        const int level_count = static_cast<int>(levels.size());
+        const int workers = Utils::ResolveThreadCount(options.ThreadCount, std::max(level_count, patch_count));
+        std::vector<SliceScratch> scratches(workers);
+        Utils::ParallelFor(patch_count, workers, [&](int patch, int worker)
+        {
+            tessellation.PlanPatch(patch, scratches[worker].Evaluation);
+        }, 1);
+
+        // The finest plan of each patch column and row
+        ContourGrid grid;
+        std::vector<int> segments_u(cu, 1), segments_v(cv, 1);
+        std::vector<Numeric> breakpoints_u(cu + 1), breakpoints_v(cv + 1);
+        std::vector<std::pair<Numeric, Numeric>> ranges(patch_count);
+        for (int patch = 0; patch < patch_count; ++patch)
+        {
+            const int a = patch % cu, b = patch / cu;
+            segments_u[a] = std::max(segments_u[a], tessellation.PlannedSegmentsU(patch));
+            segments_v[b] = std::max(segments_v[b], tessellation.PlannedSegmentsV(patch));
+            tessellation.PatchDomain(patch, breakpoints_u[a], breakpoints_u[a + 1], breakpoints_v[b], breakpoints_v[b + 1]);
+            ranges[patch] = HeightRange(tessellation.PatchPoints(patch), normal, options.Tolerance);
+        }
+        grid.U = GridLines(cu, segments_u, breakpoints_u, grid.ColumnStart);
+        grid.V = GridLines(cv, segments_v, breakpoints_v, grid.RowStart);
+        for (Numeric u : grid.U) grid.SpanU.push_back(surface.KnotsU.FindSpanIndex(surface.DegreeU, u));
+        for (Numeric v : grid.V) grid.SpanV.push_back(surface.KnotsV.FindSpanIndex(surface.DegreeV, v));
+
+        const int nu = static_cast<int>(grid.U.size()), nv = static_cast<int>(grid.V.size());
+        grid.Heights.resize(nu * nv);
+        Utils::ParallelFor(nv, workers, [&](int j, int worker)
+        {
+            for (int i = 0; i < nu; ++i)
+            {
+                grid.Heights[grid.Node(i, j)] =
+                    normal.dot(surface.EvaluateAll(grid.U[i], grid.V[j], 0, 0, scratches[worker].Evaluation,
+                                                  grid.SpanU[i], grid.SpanV[j]).Get(0, 0));
+            }
+        }, 1);
+
+        const LevelBuckets buckets(levels, ranges);
+        std::vector<std::vector<SliceContour>> slices(level_count);
+        Utils::ParallelFor(level_count, workers, [&](int k, int worker)
+        {
+            SliceScratch& scratch = scratches[worker];
+            scratch.Segments.clear();
+            for (int patch : buckets.Get(k))
+            {
+                MarchPatch(grid, patch % cu, patch / cu, levels[k], scratch.Segments);
+            }
+
+            // Every crossed edge is shared by the segments of its two cells, solve it once
+            scratch.Keys.clear();
+            for (const auto& segment : scratch.Segments)
+            {
+                scratch.Keys.push_back(segment.From);
+                scratch.Keys.push_back(segment.To);
+            }
+            std::sort(scratch.Keys.begin(), scratch.Keys.end());
+            scratch.Keys.erase(std::unique(scratch.Keys.begin(), scratch.Keys.end()), scratch.Keys.end());
+            scratch.Parameters.resize(scratch.Keys.size());
+            scratch.Points.resize(scratch.Keys.size());
+            for (size_t e = 0; e < scratch.Keys.size(); ++e)
+            {
+                SolveCrossing(surface, grid, normal, levels[k], scratch.Keys[e], options.Tolerance, scratch.Evaluation,
+                              scratch.Parameters[e], scratch.Points[e]);
+            }
+            ChainSegments(scratch, slices[k]);
+        }, LEVEL_CHUNK_SIZE);
+        return slices;
+    }
+}
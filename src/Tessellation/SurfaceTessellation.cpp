@@ -0,0 +1,538 @@
+#include "libnurbs/Tessellation/SurfaceTessellation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "libnurbs/Algorithm/BezierDecomposition.hpp"
+#include "libnurbs/Core/Grid.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    Numeric Lerp(Numeric low, Numeric high, int k, int count)
+    {
+        return k == count ? high : low + (high - low) * k / count;
+    }
+
+    // Point and unit normal; where the normal vanishes (poles, collapsed edges) it is taken
+    // slightly inside the patch, towards (inner_u, inner_v).
+    Vec3 EvaluateWithNormal(const Surface& surface, Numeric u, Numeric v, int span_u, int span_v,
+                            Numeric inner_u, Numeric inner_v, Surface::EvaluationScratch& scratch, Vec3& normal)
+    {
+        const auto& ders = surface.EvaluateAll(u, v, 1, 1, scratch, span_u, span_v);
+        Vec3 point       = ders.Get(0, 0);
+        Vec3 Su          = ders.Get(1, 0);
+        Vec3 Sv          = ders.Get(0, 1);
+        normal           = Su.cross(Sv);
+        if (normal.norm() <= 1e-12 * Su.norm() * Sv.norm() || normal.isZero())
+        {
+            const auto& inner = surface.EvaluateAll(u + 1e-6 * (inner_u - u), v + 1e-6 * (inner_v - v),
+                                                    1, 1, scratch, span_u, span_v);
+            normal = inner.Get(1, 0).cross(inner.Get(0, 1));
+        }
+        if (!normal.isZero()) normal.normalize();
+        return point;
+    }
+
+    // Index of vertex k of a line with n segments on the same line with coarse_n segments, or -1 when
+    // that line has no vertex there. Only power of two ratios are matched: scaling k and n by a power
+    // of two leaves Lerp bit for bit unchanged, so the vertices coincide exactly.
+    int NestedIndex(int k, int n, int coarse_n)
+    {
+        if (n % coarse_n != 0) return -1;
+        const int ratio = n / coarse_n;
+        if ((ratio & (ratio - 1)) != 0 || k % ratio != 0) return -1;
+        return k / ratio;
+    }
+
+    template <typename T>
+    size_t VectorBytes(const std::vector<T>& values)
+    {
+        return values.capacity() * sizeof(T);
+    }
+
+    // Triangles between an outer polyline A and an inner polyline B running the same way along one side
+    // of a patch, A at positions k / (|A| - 1) and B at (k + 1) / (|B| + 1) along the side.
+    template <typename Emit>
+    void Zip(const std::vector<int>& A, const std::vector<int>& B, Emit&& emit)
+    {
+        const int a = static_cast<int>(A.size()) - 1;
+        const int b = static_cast<int>(B.size()) - 1;
+        const int n = b + 2;
+        int i = 0, j = 0;
+        while (i < a || j < b)
+        {
+            // Compare (i + 1) / a with (j + 2) / n without dividing
+            if (j == b || (i < a && (i + 1) * n <= (j + 2) * a))
+            {
+                emit(A[i], A[i + 1], B[j]);
+                i++;
+            }
+            else
+            {
+                emit(A[i], B[j + 1], B[j]);
+                j++;
+            }
+        }
+    }
+}
+
+SurfaceTessellation::SurfaceTessellation(const Surface& surface, const Surface::TessellationOptions& options)
+    : m_Surface(&surface),
+      m_Options(options)
+{
+    // Knot insertion is only exact on homogeneous points, PlanPatch projects the Bezier points afterwards
+    Grid<Vec4> homogeneous = surface.ControlPoints;
+    std::transform(homogeneous.Values.begin(), homogeneous.Values.end(), homogeneous.Values.begin(), ToHomo);
+    DecomposeSurface(surface.DegreeU, surface.DegreeV, surface.KnotsU, surface.KnotsV, homogeneous,
+                     m_PatchPoints, m_BreakpointsU, m_BreakpointsV);
+    m_PatchCountU = static_cast<int>(m_BreakpointsU.size()) - 1;
+    m_PatchCountV = static_cast<int>(m_BreakpointsV.size()) - 1;
+    for (int a = 0; a < m_PatchCountU; ++a)
+    {
+        m_SpansU.push_back(surface.KnotsU.FindSpanIndex(surface.DegreeU, m_BreakpointsU[a]));
+    }
+    for (int b = 0; b < m_PatchCountV; ++b)
+    {
+        m_SpansV.push_back(surface.KnotsV.FindSpanIndex(surface.DegreeV, m_BreakpointsV[b]));
+    }
+    m_SegmentsU.assign(PatchCount(), 1);
+    m_SegmentsV.assign(PatchCount(), 1);
+}
+
+void SurfaceTessellation::PlanPatch(int patch, Surface::EvaluationScratch& scratch)
+{
+    const int p    = m_Surface->DegreeU;
+    const int q    = m_Surface->DegreeV;
+    const Vec4* Q  = m_PatchPoints.data() + patch * (p + 1) * (q + 1);
+    auto P         = [&](int i, int j) -> Vec3 { return FromHomo(Q[j * (p + 1) + i]).head<3>(); };
+    const int max  = std::max(m_Options.MaxSegments, 1);
+
+    // Second derivative bounds from second differences of the control net
+    Numeric m_uu = 0, m_vv = 0, m_uv = 0;
+    Numeric w_min = Q[0].w(), w_max = Q[0].w();
+    for (int j = 0; j <= q; ++j)
+    {
+        for (int i = 0; i <= p; ++i)
+        {
+            w_min = std::min(w_min, Q[j * (p + 1) + i].w());
+            w_max = std::max(w_max, Q[j * (p + 1) + i].w());
+            if (i + 2 <= p) m_uu = std::max(m_uu, (P(i + 2, j) - 2 * P(i + 1, j) + P(i, j)).norm());
+            if (j + 2 <= q) m_vv = std::max(m_vv, (P(i, j + 2) - 2 * P(i, j + 1) + P(i, j)).norm());
+            if (i < p && j < q) m_uv = std::max(m_uv, (P(i + 1, j + 1) - P(i + 1, j) - P(i, j + 1) + P(i, j)).norm());
+        }
+    }
+    Numeric factor = (w_max / w_min) * (w_max / w_min);
+    m_uu *= factor * p * (p - 1);
+    m_vv *= factor * q * (q - 1);
+    m_uv *= factor * p * q;
+
+    // (1/8)(M_uu/nu^2 + 2 M_uv/(nu nv) + M_vv/nv^2) <= tolerance holds when each direction takes half.
+    Numeric tolerance = std::max(m_Options.ChordTolerance, std::numeric_limits<Numeric>::epsilon());
+    auto segments     = [&](Numeric m)
+    {
+        return static_cast<int>(std::clamp(std::ceil(std::sqrt(m / (4 * tolerance))), Numeric(1), Numeric(max)));
+    };
+    int nu = segments(m_uu + m_uv);
+    int nv = segments(m_vv + m_uv);
+
+    if (m_Options.NormalTolerance > 0)
+    {
+        const int a         = patch % m_PatchCountU;
+        const int b         = patch / m_PatchCountU;
+        const Numeric u0    = m_BreakpointsU[a], u1 = m_BreakpointsU[a + 1];
+        const Numeric v0    = m_BreakpointsV[b], v1 = m_BreakpointsV[b + 1];
+        const Numeric cos_t = std::cos(m_Options.NormalTolerance);
+        std::vector<Vec3> normals;
+        while (true)
+        {
+            normals.resize((nu + 1) * (nv + 1));
+            for (int j = 0; j <= nv; ++j)
+            {
+                for (int i = 0; i <= nu; ++i)
+                {
+                    EvaluateWithNormal(*m_Surface, Lerp(u0, u1, i, nu), Lerp(v0, v1, j, nv), m_SpansU[a], m_SpansV[b],
+                                       0.5 * (u0 + u1), 0.5 * (v0 + v1), scratch, normals[j * (nu + 1) + i]);
+                }
+            }
+            bool refine_u = false, refine_v = false;
+            for (int j = 0; j <= nv; ++j)
+            {
+                for (int i = 0; i <= nu; ++i)
+                {
+                    const Vec3& n = normals[j * (nu + 1) + i];
+                    if (i < nu && n.dot(normals[j * (nu + 1) + i + 1]) < cos_t) refine_u = true;
+                    if (j < nv && n.dot(normals[(j + 1) * (nu + 1) + i]) < cos_t) refine_v = true;
+                }
+            }
+            refine_u = refine_u && nu < max;
+            refine_v = refine_v && nv < max;
+            if (!refine_u && !refine_v) break;
+            if (refine_u) nu = std::min(2 * nu, max);
+            if (refine_v) nv = std::min(2 * nv, max);
+        }
+    }
+
+    m_SegmentsU[patch] = nu;
+    m_SegmentsV[patch] = nv;
+}
+
+void SurfaceTessellation::Layout()
+{
+    const int cu = m_PatchCountU;
+    const int cv = m_PatchCountV;
+
+    m_EdgesU.assign(cu * (cv + 1), 1);
+    for (int b = 0; b <= cv; ++b)
+    {
+        for (int a = 0; a < cu; ++a)
+        {
+            int below = b > 0 ? m_SegmentsU[(b - 1) * cu + a] : 1;
+            int above = b < cv ? m_SegmentsU[b * cu + a] : 1;
+            m_EdgesU[b * cu + a] = std::max(below, above);
+        }
+    }
+    m_EdgesV.assign((cu + 1) * cv, 1);
+    for (int b = 0; b < cv; ++b)
+    {
+        for (int a = 0; a <= cu; ++a)
+        {
+            int left  = a > 0 ? m_SegmentsV[b * cu + a - 1] : 1;
+            int right = a < cu ? m_SegmentsV[b * cu + a] : 1;
+            m_EdgesV[b * (cu + 1) + a] = std::max(left, right);
+        }
+    }
+
+    // Vertex ranges: corners, edge interiors along u, along v, patch interiors
+    int vertex = (cu + 1) * (cv + 1);
+    m_EdgeUOffsets.resize(m_EdgesU.size());
+    for (size_t e = 0; e < m_EdgesU.size(); ++e)
+    {
+        m_EdgeUOffsets[e] = vertex;
+        vertex += m_EdgesU[e] - 1;
+    }
+    m_EdgeVOffsets.resize(m_EdgesV.size());
+    for (size_t e = 0; e < m_EdgesV.size(); ++e)
+    {
+        m_EdgeVOffsets[e] = vertex;
+        vertex += m_EdgesV[e] - 1;
+    }
+
+    int triangle = 0;
+    m_PatchVertexOffsets.resize(PatchCount());
+    m_PatchTriangleOffsets.resize(PatchCount());
+    for (int patch = 0; patch < PatchCount(); ++patch)
+    {
+        const int a = patch % cu;
+        const int b = patch / cu;
+        m_PatchVertexOffsets[patch]   = vertex;
+        m_PatchTriangleOffsets[patch] = triangle;
+        if (IsSingleQuad(patch))
+        {
+            triangle += 2;
+            continue;
+        }
+        int nu = InteriorSegmentsU(patch);
+        int nv = InteriorSegmentsV(patch);
+        vertex += (nu - 1) * (nv - 1);
+        triangle += 2 * (nu - 2) * (nv - 2) + 2 * (nu - 2) + 2 * (nv - 2);
+        triangle += m_EdgesU[b * cu + a] + m_EdgesU[(b + 1) * cu + a];
+        triangle += m_EdgesV[b * (cu + 1) + a] + m_EdgesV[b * (cu + 1) + a + 1];
+    }
+    m_VertexCount   = vertex;
+    m_TriangleCount = triangle;
+}
+
+int SurfaceTessellation::InteriorSegmentsU(int patch) const
+{
+    return IsSingleQuad(patch) ? 1 : std::max(m_SegmentsU[patch], 2);
+}
+
+int SurfaceTessellation::InteriorSegmentsV(int patch) const
+{
+    return IsSingleQuad(patch) ? 1 : std::max(m_SegmentsV[patch], 2);
+}
+
+bool SurfaceTessellation::IsSingleQuad(int patch) const
+{
+    const int cu = m_PatchCountU;
+    const int a  = patch % cu;
+    const int b  = patch / cu;
+    return m_SegmentsU[patch] == 1 && m_SegmentsV[patch] == 1 &&
+           m_EdgesU[b * cu + a] == 1 && m_EdgesU[(b + 1) * cu + a] == 1 &&
+           m_EdgesV[b * (cu + 1) + a] == 1 && m_EdgesV[b * (cu + 1) + a + 1] == 1;
+}
+
+int SurfaceTessellation::CornerIndex(int a, int b) const
+{
+    return b * (m_PatchCountU + 1) + a;
+}
+
+int SurfaceTessellation::EdgeUIndex(int a, int b, int k) const
+{
+    return m_EdgeUOffsets[b * m_PatchCountU + a] + k - 1;
+}
+
+int SurfaceTessellation::EdgeVIndex(int a, int b, int k) const
+{
+    return m_EdgeVOffsets[b * (m_PatchCountU + 1) + a] + k - 1;
+}
+
+void SurfaceTessellation::EmitVertex(TriangleMesh& mesh, int index, int patch, Numeric u, Numeric v,
+                                     Surface::EvaluationScratch& scratch) const
+{
+    const int a = patch % m_PatchCountU;
+    const int b = patch / m_PatchCountU;
+    Vec3 normal;
+    Vec3 point = EvaluateWithNormal(*m_Surface, u, v, m_SpansU[a], m_SpansV[b],
+                                    0.5 * (m_BreakpointsU[a] + m_BreakpointsU[a + 1]),
+                                    0.5 * (m_BreakpointsV[b] + m_BreakpointsV[b + 1]), scratch, normal);
+    mesh.SetVertex(index, point, normal, u, v);
+}
+
+SurfaceTessellation SurfaceTessellation::Refined(int doublings) const
+{
+    assert(doublings >= 0);
+    SurfaceTessellation refined(*this);
+    const int max = std::max(m_Options.MaxSegments, 1);
+    for (int step = 0; step < doublings; ++step)
+    {
+        refined.m_Options.ChordTolerance /= 4;
+        for (int patch = 0; patch < PatchCount(); ++patch)
+        {
+            refined.m_SegmentsU[patch] = std::min(2 * refined.m_SegmentsU[patch], max);
+            refined.m_SegmentsV[patch] = std::min(2 * refined.m_SegmentsV[patch], max);
+        }
+    }
+    refined.Layout();
+    return refined;
+}
+
+size_t SurfaceTessellation::MemoryUsage() const
+{
+    return sizeof(*this) + VectorBytes(m_PatchPoints) + VectorBytes(m_BreakpointsU) + VectorBytes(m_BreakpointsV) +
+           VectorBytes(m_SpansU) + VectorBytes(m_SpansV) + VectorBytes(m_SegmentsU) + VectorBytes(m_SegmentsV) +
+           VectorBytes(m_EdgesU) + VectorBytes(m_EdgesV) + VectorBytes(m_EdgeUOffsets) + VectorBytes(m_EdgeVOffsets) +
+           VectorBytes(m_PatchVertexOffsets) + VectorBytes(m_PatchTriangleOffsets);
+}
+
+int SurfaceTessellation::InteriorVertexIndex(int patch, int i, int j) const
+{
+    return m_PatchVertexOffsets[patch] + (j - 1) * (InteriorSegmentsU(patch) - 1) + (i - 1);
+}
+
+std::vector<int> SurfaceTessellation::Replan(const GridRegion& region, Surface::EvaluationScratch& scratch)
+{
+    const Surface& surface = *m_Surface;
+    const int p = surface.DegreeU;
+    const int q = surface.DegreeV;
+    std::vector<int> patches;
+    if (region.IsEmpty()) return patches;
+
+    // Patch (a, b) depends on control points (span_u - p .. span_u) x (span_v - q .. span_v)
+    Grid<Vec4> local(p + 1, q + 1);
+    for (int b = 0; b < m_PatchCountV; ++b)
+    {
+        const int span_v = m_SpansV[b];
+        if (span_v - q > region.MaxV || span_v < region.MinV) continue;
+        for (int a = 0; a < m_PatchCountU; ++a)
+        {
+            const int span_u = m_SpansU[a];
+            if (span_u - p > region.MaxU || span_u < region.MinU) continue;
+            for (int j = 0; j <= q; ++j)
+            {
+                for (int i = 0; i <= p; ++i)
+                {
+                    local.Get(i, j) = ToHomo(surface.ControlPoints.Get(span_u - p + i, span_v - q + j));
+                }
+            }
+            const int patch = b * m_PatchCountU + a;
+            ExtractBezierPatch(p, q, surface.KnotsU, surface.KnotsV, span_u, span_v, local,
+                               m_PatchPoints.data() + patch * (p + 1) * (q + 1));
+            PlanPatch(patch, scratch);
+            patches.push_back(patch);
+        }
+    }
+    return patches;
+}
+
+void SurfaceTessellation::EmitPatch(int patch, TriangleMesh& mesh, Surface::EvaluationScratch& scratch,
+                                    int vertex_base) const
+{
+    EmitPatch(patch, mesh, scratch, vertex_base, nullptr, nullptr, {});
+}
+
+void SurfaceTessellation::EmitPatch(int patch, TriangleMesh& mesh, Surface::EvaluationScratch& scratch,
+                                    const SurfaceTessellation& coarse, const TriangleMesh& coarse_mesh,
+                                    const GridRegion& stale) const
+{
+    assert(coarse.m_PatchCountU == m_PatchCountU && coarse.m_PatchCountV == m_PatchCountV);
+    EmitPatch(patch, mesh, scratch, 0, &coarse, &coarse_mesh, stale);
+}
+
+void SurfaceTessellation::EmitPatch(int patch, TriangleMesh& mesh, Surface::EvaluationScratch& scratch,
+                                    int vertex_base, const SurfaceTessellation* coarse,
+                                    const TriangleMesh* coarse_mesh, const GridRegion& stale) const
+{
+    const int cu       = m_PatchCountU;
+    const int cv       = m_PatchCountV;
+    const int a        = patch % cu;
+    const int b        = patch / cu;
+    const Numeric u0   = m_BreakpointsU[a], u1 = m_BreakpointsU[a + 1];
+    const Numeric v0   = m_BreakpointsV[b], v1 = m_BreakpointsV[b + 1];
+    const int bottom   = m_EdgesU[b * cu + a];
+    const int top      = m_EdgesU[(b + 1) * cu + a];
+    const int left     = m_EdgesV[b * (cu + 1) + a];
+    const int right    = m_EdgesV[b * (cu + 1) + a + 1];
+    // Closed support of the stale control points, where the surface and its normals may have changed
+    Numeric stale_u0 = 1, stale_u1 = 0, stale_v0 = 1, stale_v1 = 0;
+    if (!stale.IsEmpty())
+    {
+        const auto& knots_u = m_Surface->KnotsU.Values();
+        const auto& knots_v = m_Surface->KnotsV.Values();
+        stale_u0 = knots_u[stale.MinU];
+        stale_u1 = knots_u[stale.MaxU + m_Surface->DegreeU + 1];
+        stale_v0 = knots_v[stale.MinV];
+        stale_v1 = knots_v[stale.MaxV + m_Surface->DegreeV + 1];
+    }
+
+    // coarse_index is the same vertex in coarse, or -1
+    auto emit_vertex   = [&](int index, Numeric u, Numeric v, int coarse_index)
+    {
+        const bool is_stale = u >= stale_u0 && u <= stale_u1 && v >= stale_v0 && v <= stale_v1;
+        if (coarse_index < 0 || is_stale)
+        {
+            EmitVertex(mesh, vertex_base + index, patch, u, v, scratch);
+            return;
+        }
+        mesh.SetVertex(vertex_base + index, coarse_mesh->Position(coarse_index), coarse_mesh->Normal(coarse_index),
+                       u, v);
+    };
+    auto coarse_corner = [&](int a_corner, int b_corner)
+    {
+        return coarse ? coarse->CornerIndex(a_corner, b_corner) : -1;
+    };
+    auto coarse_edge_u = [&](int a_edge, int b_edge, int k, int n)
+    {
+        if (!coarse) return -1;
+        int kc = NestedIndex(k, n, coarse->m_EdgesU[b_edge * cu + a_edge]);
+        return kc < 0 ? -1 : coarse->EdgeUIndex(a_edge, b_edge, kc);
+    };
+    auto coarse_edge_v = [&](int a_edge, int b_edge, int k, int n)
+    {
+        if (!coarse) return -1;
+        int kc = NestedIndex(k, n, coarse->m_EdgesV[b_edge * (cu + 1) + a_edge]);
+        return kc < 0 ? -1 : coarse->EdgeVIndex(a_edge, b_edge, kc);
+    };
+
+    // Vertices owned by this patch: lower left corner, bottom and left edges, plus the far
+    // boundary for the last row and column of patches.
+    emit_vertex(CornerIndex(a, b), u0, v0, coarse_corner(a, b));
+    for (int k = 1; k < bottom; ++k)
+    {
+        emit_vertex(EdgeUIndex(a, b, k), Lerp(u0, u1, k, bottom), v0, coarse_edge_u(a, b, k, bottom));
+    }
+    for (int k = 1; k < left; ++k)
+    {
+        emit_vertex(EdgeVIndex(a, b, k), u0, Lerp(v0, v1, k, left), coarse_edge_v(a, b, k, left));
+    }
+    if (b == cv - 1)
+    {
+        emit_vertex(CornerIndex(a, b + 1), u0, v1, coarse_corner(a, b + 1));
+        for (int k = 1; k < top; ++k)
+        {
+            emit_vertex(EdgeUIndex(a, b + 1, k), Lerp(u0, u1, k, top), v1, coarse_edge_u(a, b + 1, k, top));
+        }
+    }
+    if (a == cu - 1)
+    {
+        emit_vertex(CornerIndex(a + 1, b), u1, v0, coarse_corner(a + 1, b));
+        for (int k = 1; k < right; ++k)
+        {
+            emit_vertex(EdgeVIndex(a + 1, b, k), u1, Lerp(v0, v1, k, right), coarse_edge_v(a + 1, b, k, right));
+        }
+    }
+    if (a == cu - 1 && b == cv - 1)
+    {
+        emit_vertex(CornerIndex(a + 1, b + 1), u1, v1, coarse_corner(a + 1, b + 1));
+    }
+
+    int triangle      = m_PatchTriangleOffsets[patch];
+    auto emit_triangle = [&](int i0, int i1, int i2)
+    {
+        mesh.SetTriangle(triangle++, vertex_base + i0, vertex_base + i1, vertex_base + i2);
+    };
+
+    if (IsSingleQuad(patch))
+    {
+        emit_triangle(CornerIndex(a, b), CornerIndex(a + 1, b), CornerIndex(a + 1, b + 1));
+        emit_triangle(CornerIndex(a, b), CornerIndex(a + 1, b + 1), CornerIndex(a, b + 1));
+        return;
+    }
+
+    const int nu = InteriorSegmentsU(patch);
+    const int nv = InteriorSegmentsV(patch);
+    auto inner   = [&](int i, int j)
+    {
+        return InteriorVertexIndex(patch, i, j);
+    };
+    auto coarse_inner = [&](int i, int j)
+    {
+        if (!coarse || coarse->IsSingleQuad(patch)) return -1;
+        int ic = NestedIndex(i, nu, coarse->InteriorSegmentsU(patch));
+        int jc = NestedIndex(j, nv, coarse->InteriorSegmentsV(patch));
+        return ic < 0 || jc < 0 ? -1 : coarse->InteriorVertexIndex(patch, ic, jc);
+    };
+    for (int j = 1; j < nv; ++j)
+    {
+        for (int i = 1; i < nu; ++i)
+        {
+            emit_vertex(inner(i, j), Lerp(u0, u1, i, nu), Lerp(v0, v1, j, nv), coarse_inner(i, j));
+        }
+    }
+
+    for (int j = 1; j + 1 < nv; ++j)
+    {
+        for (int i = 1; i + 1 < nu; ++i)
+        {
+            emit_triangle(inner(i, j), inner(i + 1, j), inner(i + 1, j + 1));
+            emit_triangle(inner(i, j), inner(i + 1, j + 1), inner(i, j + 1));
+        }
+    }
+
+    // Counter-clockwise around the patch: each side zips the shared edge vertices to the
+    // outermost ring of the interior grid.
+    std::vector<int> outer, ring;
+    auto zip = [&]() { Zip(outer, ring, emit_triangle); };
+
+    outer = {CornerIndex(a, b)};
+    for (int k = 1; k < bottom; ++k) outer.push_back(EdgeUIndex(a, b, k));
+    outer.push_back(CornerIndex(a + 1, b));
+    ring.clear();
+    for (int i = 1; i < nu; ++i) ring.push_back(inner(i, 1));
+    zip();
+
+    outer = {CornerIndex(a + 1, b)};
+    for (int k = 1; k < right; ++k) outer.push_back(EdgeVIndex(a + 1, b, k));
+    outer.push_back(CornerIndex(a + 1, b + 1));
+    ring.clear();
+    for (int j = 1; j < nv; ++j) ring.push_back(inner(nu - 1, j));
+    zip();
+
+    outer = {CornerIndex(a + 1, b + 1)};
+    for (int k = top - 1; k >= 1; --k) outer.push_back(EdgeUIndex(a, b + 1, k));
+    outer.push_back(CornerIndex(a, b + 1));
+    ring.clear();
+    for (int i = nu - 1; i >= 1; --i) ring.push_back(inner(i, nv - 1));
+    zip();
+
+    outer = {CornerIndex(a, b + 1)};
+    for (int k = left - 1; k >= 1; --k) outer.push_back(EdgeVIndex(a, b, k));
+    outer.push_back(CornerIndex(a, b));
+    ring.clear();
+    for (int j = nv - 1; j >= 1; --j) ring.push_back(inner(1, j));
+    zip();
+}
@@ -0,0 +1,111 @@
+#include "libnurbs/Tessellation/TessellationCache.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    size_t MeshBytes(const TriangleMesh& mesh)
+    {
+        return (mesh.Positions.capacity() + mesh.Normals.capacity() + mesh.UVs.capacity()) * sizeof(Numeric) +
+               mesh.Indices.capacity() * sizeof(uint32_t);
+    }
+}
+
+TessellationCache::TessellationCache(const Surface::TessellationOptions& coarsest, size_t memory_budget)
+    : m_Coarsest(coarsest),
+      m_MemoryBudget(memory_budget)
+{
+}
+
+int TessellationCache::Level(Numeric tolerance) const
+{
+    int level = 0;
+    Numeric level_tolerance = m_Coarsest.ChordTolerance;
+    while (level < MAX_LEVEL && level_tolerance > tolerance)
+    {
+        level_tolerance /= 4;
+        level++;
+    }
+    return level;
+}
+
+const TriangleMesh& TessellationCache::Get(const Surface& surface, Numeric tolerance)
+{
+    const int level = Level(tolerance);
+    if (auto it = m_Index.find({&surface, level}); it != m_Index.end())
+    {
+        m_HitCount++;
+        m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+        return it->second->Mesh;
+    }
+    m_MissCount++;
+
+    Entry entry{{&surface, level}, nullptr, {}, 0};
+    // Levels of one surface are adjacent in the index, the entry before the key is the finest coarser one.
+    auto coarser = m_Index.lower_bound(entry.Id);
+    if (coarser != m_Index.begin() && std::prev(coarser)->first.first == &surface)
+    {
+        const Entry& source = *std::prev(coarser)->second;
+        entry.Tessellation = std::make_unique<SurfaceTessellation>(
+            source.Tessellation->Refined(level - source.Id.second));
+        entry.Mesh.Resize(entry.Tessellation->VertexCount(), entry.Tessellation->TriangleCount());
+        for (int patch = 0; patch < entry.Tessellation->PatchCount(); ++patch)
+        {
+            entry.Tessellation->EmitPatch(patch, entry.Mesh, m_Scratch, *source.Tessellation, source.Mesh);
+        }
+        m_RefineCount++;
+    }
+    else
+    {
+        Surface::TessellationOptions options = m_Coarsest;
+        for (int k = 0; k < level; ++k) options.ChordTolerance /= 4;
+        entry.Tessellation = std::make_unique<SurfaceTessellation>(surface, options);
+        for (int patch = 0; patch < entry.Tessellation->PatchCount(); ++patch)
+        {
+            entry.Tessellation->PlanPatch(patch, m_Scratch);
+        }
+        entry.Tessellation->Layout();
+        entry.Mesh.Resize(entry.Tessellation->VertexCount(), entry.Tessellation->TriangleCount());
+        for (int patch = 0; patch < entry.Tessellation->PatchCount(); ++patch)
+        {
+            entry.Tessellation->EmitPatch(patch, entry.Mesh, m_Scratch);
+        }
+    }
+    entry.Bytes = MeshBytes(entry.Mesh) + entry.Tessellation->MemoryUsage();
+    Insert(std::move(entry));
+    return m_Entries.front().Mesh;
+}
+
+void TessellationCache::Insert(Entry entry)
+{
+    m_MemoryUsage += entry.Bytes;
+    m_Entries.push_front(std::move(entry));
+    m_Index[m_Entries.front().Id] = m_Entries.begin();
+    while (m_MemoryUsage > m_MemoryBudget && m_Entries.size() > 1)
+    {
+        Evict(m_Index.find(m_Entries.back().Id));
+    }
+}
+
+void TessellationCache::Evict(std::map<Key, std::list<Entry>::iterator>::iterator it)
+{
+    m_MemoryUsage -= it->second->Bytes;
+    m_Entries.erase(it->second);
+    m_Index.erase(it);
+}
+
+void TessellationCache::Invalidate(const Surface& surface)
+{
+    auto it = m_Index.lower_bound({&surface, 0});
+    while (it != m_Index.end() && it->first.first == &surface)
+    {
+        Evict(it++);
+    }
+}
+
+void TessellationCache::Clear()
+{
+    m_Entries.clear();
+    m_Index.clear();
+    m_MemoryUsage = 0;
+}
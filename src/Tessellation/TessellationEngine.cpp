@@ -0,0 +1,171 @@
+#include "libnurbs/Tessellation/TessellationEngine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "libnurbs/Tessellation/SurfaceTessellation.hpp"
+
+using namespace libnurbs;
+
+namespace
+{
+    struct SurfaceJob
+    {
+        std::unique_ptr<SurfaceTessellation> Tessellation{};
+        TriangleMesh Mesh{};
+        std::atomic<int> Remaining{0};
+        std::atomic<bool> Done{false};
+    };
+
+    struct CurveJob
+    {
+        Polyline Result{};
+        std::atomic<bool> Done{false};
+    };
+
+    // Hands finished jobs to sink in index order; every job calls Flush once it is done,
+    // so whichever finishes the missing one pushes out the ready prefix behind it.
+    // Jobs are started only Window ahead of the next one to deliver: workers run their own tasks
+    // newest first, and starting everything up front would buffer nearly all results until job 0.
+    template <typename Job, typename Release>
+    struct OrderedDelivery
+    {
+        std::vector<Job>& Jobs;
+        Release ReleaseJob;
+        size_t Window;
+        // Set after construction, starting a job captures the delivery it flushes when done
+        std::function<void(int index)> StartJob{};
+        std::mutex Mutex{};
+        size_t Next{0};
+        size_t Started{0};
+
+        void Flush()
+        {
+            std::lock_guard lock(Mutex);
+            while (Next < Jobs.size() && Jobs[Next].Done.load(std::memory_order_acquire))
+            {
+                ReleaseJob(static_cast<int>(Next), Jobs[Next]);
+                Next++;
+            }
+            while (Started < Jobs.size() && Started < Next + Window)
+            {
+                StartJob(static_cast<int>(Started++));
+            }
+        }
+    };
+}
+
+TessellationEngine::TessellationEngine(int thread_count)
+    : m_Pool(thread_count),
+      m_Scratches(m_Pool.ThreadCount())
+{
+}
+
+void TessellationEngine::Run(std::span<const Surface> surfaces,
+                             std::span<const Curve> curves,
+                             const TessellationSettings& settings,
+                             const SurfaceSink& surface_sink,
+                             const CurveSink& curve_sink)
+{
+    const int per_task = std::max(settings.PatchesPerTask, 1);
+
+    // Enough jobs in flight to keep every worker busy, few enough to bound the buffered results
+    const size_t window = 2 * static_cast<size_t>(m_Pool.ThreadCount());
+
+    std::vector<SurfaceJob> surface_jobs(surfaces.size());
+    auto release_surface = [&](int index, SurfaceJob& job)
+    {
+        if (surface_sink) surface_sink(index, job.Mesh);
+        job.Mesh = {};
+        job.Tessellation.reset();
+    };
+    OrderedDelivery<SurfaceJob, decltype(release_surface)> surface_delivery{surface_jobs, release_surface, window};
+
+    std::vector<CurveJob> curve_jobs(curves.size());
+    auto release_curve = [&](int index, CurveJob& job)
+    {
+        if (curve_sink) curve_sink(index, job.Result);
+        job.Result = {};
+    };
+    OrderedDelivery<CurveJob, decltype(release_curve)> curve_delivery{curve_jobs, release_curve, window};
+
+    auto finish = [&](SurfaceJob& job)
+    {
+        job.Done.store(true, std::memory_order_release);
+        surface_delivery.Flush();
+    };
+
+    // Runs func(patch, worker) over all patches of a job, split into tasks when there are many,
+    // then calls next(worker) once, after the last patch.
+    auto for_patches = [&](SurfaceJob& job, int worker, auto func, auto next)
+    {
+        const int patch_count = job.Tessellation->PatchCount();
+        const int task_count  = (patch_count + per_task - 1) / per_task;
+        if (task_count <= 1)
+        {
+            for (int patch = 0; patch < patch_count; ++patch) func(patch, worker);
+            next(worker);
+            return;
+        }
+        job.Remaining.store(task_count, std::memory_order_relaxed);
+        for (int t = 0; t < task_count; ++t)
+        {
+            m_Pool.Submit([&job, t, per_task, patch_count, func, next](int w)
+            {
+                for (int patch = t * per_task; patch < std::min((t + 1) * per_task, patch_count); ++patch)
+                {
+                    func(patch, w);
+                }
+                if (job.Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) next(w);
+            });
+        }
+    };
+
+    surface_delivery.StartJob = [&](int i)
+    {
+        m_Pool.Submit([&, i](int worker)
+        {
+            SurfaceJob& job = surface_jobs[i];
+            job.Tessellation = std::make_unique<SurfaceTessellation>(surfaces[i], settings.SurfaceOptions);
+
+            auto plan = [&job, this](int patch, int w)
+            {
+                job.Tessellation->PlanPatch(patch, m_Scratches[w]);
+            };
+            auto emit = [&job, this](int patch, int w)
+            {
+                job.Tessellation->EmitPatch(patch, job.Mesh, m_Scratches[w]);
+            };
+            auto done = [&job, &finish](int)
+            {
+                finish(job);
+            };
+            auto layout = [&job, &for_patches, emit, done](int w)
+            {
+                job.Tessellation->Layout();
+                job.Mesh.Resize(job.Tessellation->VertexCount(), job.Tessellation->TriangleCount());
+                for_patches(job, w, emit, done);
+            };
+            for_patches(job, worker, plan, layout);
+        });
+    };
+
+    curve_delivery.StartJob = [&](int i)
+    {
+        m_Pool.Submit([&, i](int)
+        {
+            CurveJob& job = curve_jobs[i];
+            curves[i].Tessellate(settings.CurveChordTolerance, settings.CurveAngleTolerance, job.Result);
+            job.Done.store(true, std::memory_order_release);
+            curve_delivery.Flush();
+        });
+    };
+
+    // Nothing is done yet, so these only start the first window of each
+    surface_delivery.Flush();
+    curve_delivery.Flush();
+    m_Pool.Wait();
+}
@@ -0,0 +1,124 @@
+#include "libnurbs/Utils/ThreadPool.hpp"
+
+#include <limits>
+#include <utility>
+
+#include "libnurbs/Utils/Parallel.hpp"
+
+using namespace libnurbs::Utils;
+
+namespace
+{
+    // Pool and worker index of the current thread, lets Submit find the local deque.
+    thread_local const ThreadPool* t_Pool = nullptr;
+    thread_local int t_Worker             = -1;
+}
+
+ThreadPool::ThreadPool(int thread_count)
+{
+    thread_count = ResolveThreadCount(thread_count, std::numeric_limits<int>::max());
+    for (int i = 0; i < thread_count; ++i)
+    {
+        m_Queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < thread_count; ++i)
+    {
+        m_Threads.emplace_back([this, i] { Run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WakeUp.notify_all();
+    m_Threads.clear();
+}
+
+void ThreadPool::Submit(Task task)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        int queue = t_Pool == this ? t_Worker : m_NextQueue++ % ThreadCount();
+        {
+            std::lock_guard queue_lock(m_Queues[queue]->Mutex);
+            m_Queues[queue]->Tasks.push_back(std::move(task));
+        }
+        m_Queued++;
+        m_Pending++;
+    }
+    m_WakeUp.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+    std::unique_lock lock(m_Mutex);
+    m_Idle.wait(lock, [this] { return m_Pending == 0; });
+    if (m_Error)
+    {
+        auto error = std::exchange(m_Error, nullptr);
+        std::rethrow_exception(error);
+    }
+}
+
+bool ThreadPool::TryPop(int worker, Task& task)
+{
+    {
+        auto& own = *m_Queues[worker];
+        std::lock_guard lock(own.Mutex);
+        if (!own.Tasks.empty())
+        {
+            task = std::move(own.Tasks.back());
+            own.Tasks.pop_back();
+            m_Queued--;
+            return true;
+        }
+    }
+    const int count = ThreadCount();
+    for (int k = 1; k < count; ++k)
+    {
+        auto& victim = *m_Queues[(worker + k) % count];
+        std::lock_guard lock(victim.Mutex);
+        if (!victim.Tasks.empty())
+        {
+            task = std::move(victim.Tasks.front());
+            victim.Tasks.pop_front();
+            m_Queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Run(int worker)
+{
+    t_Pool   = this;
+    t_Worker = worker;
+    while (true)
+    {
+        Task task;
+        if (TryPop(worker, task))
+        {
+            std::exception_ptr error;
+            try
+            {
+                task(worker);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard lock(m_Mutex);
+            if (error && !m_Error) m_Error = error;
+            if (--m_Pending == 0) m_Idle.notify_all();
+            continue;
+        }
+
+        std::unique_lock lock(m_Mutex);
+        m_WakeUp.wait(lock, [this] { return m_Stop || m_Queued > 0; });
+        if (m_Stop && m_Queued == 0) return;
+    }
+}